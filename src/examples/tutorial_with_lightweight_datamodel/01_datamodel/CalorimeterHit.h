@@ -28,6 +28,10 @@ struct CalorimeterHit : public JObject {
     CalorimeterHit(int cell_id, int row, int col, double x, double y, double z, double energy, uint64_t time)
     : cell_id(cell_id), row(row), col(col), x(x), y(y), z(z), energy(energy), time(time) {}
 
+    // A default constructor is only needed for reading hits back out of a JColumnarDatabundleT, e.g. in JInspector.
+    // Value-initializing it, i.e. `CalorimeterHit hit {};`, zeroes all of the fields.
+    CalorimeterHit() = default;
+
 
     void Summarize(JObjectSummary& summary) const override {
         summary.add(cell_id, NAME_OF(cell_id), "%d", "Cell ID");
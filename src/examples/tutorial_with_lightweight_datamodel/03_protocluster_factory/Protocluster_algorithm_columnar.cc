@@ -0,0 +1,112 @@
+
+#include "Protocluster_algorithm_columnar.h"
+#include "Protocluster_algorithm.h"
+#include <map>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+
+void add_protocluster_columns(JColumnarDatabundleT<CalorimeterHit>& hits) {
+    hits.AddColumn(&CalorimeterHit::row, "row");
+    hits.AddColumn(&CalorimeterHit::col, "col");
+    hits.AddColumn(&CalorimeterHit::x, "x");
+    hits.AddColumn(&CalorimeterHit::y, "y");
+    hits.AddColumn(&CalorimeterHit::energy, "energy");
+    hits.AddColumn(&CalorimeterHit::time, "time");
+}
+
+
+std::vector<CalorimeterCluster*> calculate_protoclusters_columnar(const CalorimeterHitColumns& hits,
+                                                                  double log_weight_reference_energy) {
+
+    size_t hit_count = hits.energy.size();
+    std::map<std::pair<int, int>, int> cell_to_hit_index;
+
+    for (size_t hit_index=0; hit_index < hit_count; ++hit_index) {
+        cell_to_hit_index[{hits.row[hit_index], hits.col[hit_index]}] = hit_index;
+    }
+
+    UnionFind union_find_alg(hit_count);
+
+    for (auto& pair : cell_to_hit_index) {
+        auto row = pair.first.first;
+        auto col = pair.first.second;
+        auto idx = pair.second;
+
+        auto north = cell_to_hit_index.find({row-1, col});
+        if (north != cell_to_hit_index.end()) {
+            union_find_alg.unite(idx, north->second);
+        }
+        auto east = cell_to_hit_index.find({row, col-1});
+        if (east != cell_to_hit_index.end()) {
+            union_find_alg.unite(idx, east->second);
+        }
+        auto northeast = cell_to_hit_index.find({row-1, col-1});
+        if (northeast != cell_to_hit_index.end()) {
+            union_find_alg.unite(idx, northeast->second);
+        }
+    }
+
+    // Number the clusters in order of their root hit, which is the same order calculate_protoclusters() returns them in
+
+    std::vector<int> roots(hit_count);
+    std::map<int, size_t> root_to_cluster_index;
+    for (size_t hit_index=0; hit_index < hit_count; ++hit_index) {
+        roots[hit_index] = union_find_alg.find(hit_index);
+        root_to_cluster_index.emplace(roots[hit_index], 0);
+    }
+    size_t cluster_count = 0;
+    for (auto& it : root_to_cluster_index) {
+        it.second = cluster_count++;
+    }
+    std::vector<size_t> cluster_of_hit(hit_count);
+    for (size_t hit_index=0; hit_index < hit_count; ++hit_index) {
+        cluster_of_hit[hit_index] = root_to_cluster_index[roots[hit_index]];
+    }
+
+    // From here on everything is a linear pass over the columns
+
+    std::vector<double> cluster_energy(cluster_count, 0.0);
+    std::vector<uint64_t> time_begin(cluster_count, std::numeric_limits<uint64_t>::max());
+    std::vector<uint64_t> time_end(cluster_count, 0);
+    for (size_t hit_index=0; hit_index < hit_count; ++hit_index) {
+        auto c = cluster_of_hit[hit_index];
+        cluster_energy[c] += hits.energy[hit_index];
+        time_begin[c] = std::min(hits.time[hit_index], time_begin[c]);
+        time_end[c] = std::max(hits.time[hit_index], time_end[c]);
+    }
+
+    // w_i = max(0, w_0 + ln(E_i/E_cl)), with negative-energy hits getting zero weight.
+    // Selecting instead of branching keeps this loop vectorizable.
+    std::vector<double> weights(hit_count);
+    const double* energy = hits.energy.data();
+    for (size_t hit_index=0; hit_index < hit_count; ++hit_index) {
+        double w_i = log_weight_reference_energy + std::log(energy[hit_index] / cluster_energy[cluster_of_hit[hit_index]]);
+        weights[hit_index] = (energy[hit_index] < 0 || !(w_i > 0)) ? 0.0 : w_i;
+    }
+
+    std::vector<double> sum_w(cluster_count, 0.0);
+    std::vector<double> r_x(cluster_count, 0.0);
+    std::vector<double> r_y(cluster_count, 0.0);
+    for (size_t hit_index=0; hit_index < hit_count; ++hit_index) {
+        auto c = cluster_of_hit[hit_index];
+        sum_w[c] += weights[hit_index];
+        r_x[c] += weights[hit_index] * hits.x[hit_index];
+        r_y[c] += weights[hit_index] * hits.y[hit_index];
+    }
+
+    std::vector<CalorimeterCluster*> clusters_out;
+    clusters_out.reserve(cluster_count);
+    for (size_t c=0; c<cluster_count; ++c) {
+        auto* cluster = new CalorimeterCluster;
+        cluster->energy = cluster_energy[c];
+        cluster->time_begin = time_begin[c];
+        cluster->time_end = time_end[c];
+        cluster->x_center = r_x[c] / sum_w[c];
+        cluster->y_center = r_y[c] / sum_w[c];
+        clusters_out.push_back(cluster);
+    }
+    return clusters_out;
+}
+
@@ -0,0 +1,30 @@
+
+#pragma once
+#include <CalorimeterHit.h>
+#include <CalorimeterCluster.h>
+#include <JANA/Components/JColumnarDatabundle.h>
+
+
+// The columnar version of calculate_protoclusters() reads the hits from one contiguous array per field
+// instead of from a vector of pointers to CalorimeterHit objects. Apart from the union-find, which is
+// inherently serial, every loop walks these arrays front to back, and the weighting loop has no branches,
+// so the compiler is free to vectorize it.
+//
+// Since there are no CalorimeterHit objects, the clusters don't get any associated hits.
+
+struct CalorimeterHitColumns {
+    JColumnSpan<const int> row;
+    JColumnSpan<const int> col;
+    JColumnSpan<const double> x;
+    JColumnSpan<const double> y;
+    JColumnSpan<const double> energy;
+    JColumnSpan<const uint64_t> time;
+};
+
+/// Declares the columns that calculate_protoclusters_columnar() needs
+void add_protocluster_columns(JColumnarDatabundleT<CalorimeterHit>& hits);
+
+std::vector<CalorimeterCluster*> calculate_protoclusters_columnar(
+    const CalorimeterHitColumns& hits,
+    double log_weight_reference_energy);
+
@@ -0,0 +1,28 @@
+
+#include "Protocluster_factory_columnar.h"
+#include "Protocluster_algorithm_columnar.h"
+#include "JANA/Utils/JTypeInfo.h"
+
+
+Protocluster_factory_columnar::Protocluster_factory_columnar() {
+    SetTypeName(NAME_OF_THIS);
+    SetPrefix("protoclusterizer_columnar");
+    m_clusters_out.SetShortName("proto");
+    m_hits_in.SetDatabundleName("rechits");
+}
+
+void Protocluster_factory_columnar::Process(const JEvent&) {
+
+    // Look each column up once per event. Inside the algorithm, each one is just a pointer and a size.
+    CalorimeterHitColumns hits {
+        m_hits_in.Column(&CalorimeterHit::row),
+        m_hits_in.Column(&CalorimeterHit::col),
+        m_hits_in.Column(&CalorimeterHit::x),
+        m_hits_in.Column(&CalorimeterHit::y),
+        m_hits_in.Column(&CalorimeterHit::energy),
+        m_hits_in.Column(&CalorimeterHit::time)
+    };
+
+    m_clusters_out() = calculate_protoclusters_columnar(hits, m_log_weight_energy());
+}
+
@@ -0,0 +1,28 @@
+
+#pragma once
+#include <JANA/JFactory.h>
+#include <CalorimeterHit.h>
+#include <CalorimeterCluster.h>
+
+// Protocluster_factory_columnar does the same thing as Protocluster_factory, but reads its hits from a
+// JColumnarDatabundleT instead of a vector of pointers. Whoever produces the hits needs to use a ColumnarOutput
+// that declares at least the columns in add_protocluster_columns().
+
+class Protocluster_factory_columnar : public JFactory {
+
+private:
+
+    ColumnarInput<CalorimeterHit> m_hits_in {this};
+
+    Output<CalorimeterCluster> m_clusters_out {this};
+
+    Parameter<double> m_log_weight_energy {this, "log_weight_energy", 5.0 };
+
+public:
+
+    Protocluster_factory_columnar();
+
+    void Process(const JEvent& event) override;
+
+};
+
@@ -77,7 +77,7 @@ void Protocluster_factory_epic::Execute(int32_t run_number, uint64_t event_numbe
     //   config().energy_threshold
     //   m_energy_threshold()
 
-    m_clusters_out() = calculate_protoclusters(m_hits_in(), config().log_weight_energy);
+    m_clusters_out() = calculate_protoclusters(m_hits_in().Copy(), config().log_weight_energy);
 
     // While you are inside Execute(), you can populate your output databundles however you like. Once Execute()
     // returns, JANA2 will store and retrieve them automatically.
@@ -10,6 +10,10 @@
 #include "Protocluster_factory.h"
 #include "Protocluster_factory_gluex.h"
 #include "Protocluster_factory_epic.h"
+#include "Protocluster_algorithm_columnar.h"
+#include "Protocluster_factory_columnar.h"
+#include <chrono>
+#include <random>
 
 
 std::vector<const CalorimeterHit*> populateHits(size_t rows, size_t cols, std::vector<double> energies) {
@@ -212,3 +216,97 @@ TEST_CASE("Protocluster_factory_gluex_tests") {
     REQUIRE_THAT(clusters.at(1)->energy, Catch::Matchers::WithinRel(13.0));
 }
 
+
+JColumnarDatabundleT<CalorimeterHit>* make_columnar_hits(const std::vector<CalorimeterHit*>& hits) {
+    auto* columnar_hits = new JColumnarDatabundleT<CalorimeterHit>;
+    add_protocluster_columns(*columnar_hits);
+    for (auto* hit : hits) {
+        columnar_hits->PushBack(*hit);
+    }
+    return columnar_hits;
+}
+
+CalorimeterHitColumns get_columns(const JColumnarDatabundleT<CalorimeterHit>& hits) {
+    return { hits.GetColumn(&CalorimeterHit::row), hits.GetColumn(&CalorimeterHit::col),
+             hits.GetColumn(&CalorimeterHit::x), hits.GetColumn(&CalorimeterHit::y),
+             hits.GetColumn(&CalorimeterHit::energy), hits.GetColumn(&CalorimeterHit::time) };
+}
+
+TEST_CASE("Protocluster_algorithm_columnar_tests") {
+    auto hits = make_two_cluster_hits();
+    std::vector<const CalorimeterHit*> const_hits(hits.begin(), hits.end());
+    std::unique_ptr<JColumnarDatabundleT<CalorimeterHit>> columnar_hits(make_columnar_hits(hits));
+
+    auto aos_clusters = calculate_protoclusters(const_hits, 5.0);
+    auto soa_clusters = calculate_protoclusters_columnar(get_columns(*columnar_hits), 5.0);
+
+    REQUIRE(soa_clusters.size() == aos_clusters.size());
+    for (size_t i=0; i<aos_clusters.size(); ++i) {
+        REQUIRE_THAT(soa_clusters[i]->energy, Catch::Matchers::WithinRel(aos_clusters[i]->energy));
+        REQUIRE_THAT(soa_clusters[i]->x_center, Catch::Matchers::WithinRel(aos_clusters[i]->x_center));
+        REQUIRE_THAT(soa_clusters[i]->y_center, Catch::Matchers::WithinRel(aos_clusters[i]->y_center));
+    }
+    for (auto* cluster : aos_clusters) delete cluster;
+    for (auto* cluster : soa_clusters) delete cluster;
+    for (auto* hit : hits) delete hit;
+}
+
+TEST_CASE("Protocluster_factory_columnar_tests") {
+    JApplication app;
+    app.Add(new JFactoryGeneratorT<Protocluster_factory_columnar>());
+    auto event = std::make_shared<JEvent>(&app);
+
+    auto hits = make_two_cluster_hits();
+    auto* columnar_hits = make_columnar_hits(hits);
+    for (auto* hit : hits) delete hit; // The columns hold copies of the hits
+    columnar_hits->SetShortName("rechits");
+    columnar_hits->SetStatus(JDatabundle::Status::Inserted);
+    event->GetFactorySet()->Add(columnar_hits);
+    auto clusters = event->Get<CalorimeterCluster>("proto");
+
+    REQUIRE(clusters.size() == 2);
+    REQUIRE_THAT(clusters.at(0)->energy, Catch::Matchers::WithinRel(14.0));
+    REQUIRE_THAT(clusters.at(1)->energy, Catch::Matchers::WithinRel(13.0));
+
+    // JInspector sees the hits as JObjects, even though they are stored as columns
+    auto objs = columnar_hits->GetAs<JObject>();
+    REQUIRE(objs.size() == 6);
+    REQUIRE(static_cast<CalorimeterHit*>(objs.at(5))->energy == 7.0);
+}
+
+// This compares the AoS and SoA layouts on a larger, randomly filled detector. It is hidden by default because it
+// only reports timings. Run it with: lw_protocluster_common_tests "[benchmark]"
+TEST_CASE("Protocluster_columnar_benchmark", "[.][benchmark]") {
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> energy_dist(0.0, 10.0);
+    std::uniform_real_distribution<double> occupancy_dist(0.0, 1.0);
+    std::vector<CalorimeterHit*> hits;
+    for (int row=0; row<200; ++row) {
+        for (int col=0; col<200; ++col) {
+            if (occupancy_dist(rng) < 0.3) {
+                hits.push_back(new CalorimeterHit(0, row, col, col*1.0, row*1.0, 0.0, energy_dist(rng), 0));
+            }
+        }
+    }
+    std::vector<const CalorimeterHit*> const_hits(hits.begin(), hits.end());
+    std::unique_ptr<JColumnarDatabundleT<CalorimeterHit>> columnar_hits(make_columnar_hits(hits));
+
+    auto time = [](auto&& f) {
+        size_t iterations = 20;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i=0; i<iterations; ++i) {
+            auto clusters = f();
+            for (auto* cluster : clusters) delete cluster;
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+    };
+    auto aos_ms = time([&]() { return calculate_protoclusters(const_hits, 5.0); });
+    auto soa_ms = time([&]() { return calculate_protoclusters_columnar(get_columns(*columnar_hits), 5.0); });
+
+    std::cout << "Protoclustering " << hits.size() << " hits:" << std::endl;
+    std::cout << "  AoS (vector of pointers): " << aos_ms << " ms" << std::endl;
+    std::cout << "  SoA (JColumnarDatabundleT): " << soa_ms << " ms" << std::endl;
+    std::cout << "  Speedup: " << aos_ms / soa_ms << std::endl;
+    for (auto* hit : hits) delete hit;
+}
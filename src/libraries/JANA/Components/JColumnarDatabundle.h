@@ -0,0 +1,372 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#pragma once
+
+#include <JANA/Components/JDatabundle.h>
+#include <JANA/JException.h>
+#include <JANA/JObject.h>
+#include <JANA/Utils/JTypeInfo.h>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <string>
+#include <typeindex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if JANA2_HAVE_ROOT
+#include <TObject.h>
+#endif
+
+
+/// JColumnSpan is a non-owning view over one column of a JColumnarDatabundleT. The elements are contiguous and the
+/// first one is aligned to JColumnarDatabundleT<T>::kColumnAlignment, so loops over a JColumnSpan can be vectorized.
+/// A JColumnSpan is only valid until its databundle gets cleared or resized.
+template <typename F>
+class JColumnSpan {
+
+    F* m_data = nullptr;
+    size_t m_size = 0;
+
+public:
+    using value_type = std::remove_const_t<F>;
+    using iterator = F*;
+    using const_iterator = const F*;
+
+    JColumnSpan() = default;
+    JColumnSpan(F* data, size_t size) : m_data(data), m_size(size) {}
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    F* data() const { return m_data; }
+    F* begin() const { return m_data; }
+    F* end() const { return m_data + m_size; }
+
+    F& operator[](size_t index) const { return m_data[index]; }
+
+    F& at(size_t index) const {
+        if (index >= m_size) {
+            throw JException("JColumnSpan index %lu is out of range (size=%lu)", index, m_size);
+        }
+        return m_data[index];
+    }
+
+    /// A writable column can always be read
+    operator JColumnSpan<const F>() const { return {m_data, m_size}; }
+};
+
+
+/// JColumnarDatabundleT stores the fields of T as a structure of arrays, i.e. one contiguous, aligned column per field,
+/// instead of JLightweightDatabundleT's vector of pointers to individually allocated T's. Loops over a single field
+/// then read consecutive memory instead of chasing a pointer per object, which is what lets the compiler vectorize them.
+///
+/// C++17 can't enumerate a struct's fields, so the fields to store are declared explicitly via AddColumn(&T::field).
+/// Each field must be trivially copyable. Columns are looked up by the field's member pointer, so the producer
+/// and consumers only need to agree on T.
+///
+/// There are no T objects inside. GetAs<S>() (and therefore JInspector) materializes rows on demand, filling in the
+/// declared columns of a default-constructed T. This is slow, but it is only meant for inspection and debugging.
+template <typename T>
+class JColumnarDatabundleT : public JDatabundle {
+public:
+    /// One cache line, and wide enough for AVX-512 loads
+    static constexpr size_t kColumnAlignment = 64;
+
+private:
+    struct Column {
+        std::string name;
+        std::type_index type_index;
+        size_t offset;       // Offset of the field within T
+        size_t element_size;
+        char* data;
+    };
+
+    std::vector<Column> m_columns;
+    size_t m_size = 0;
+    size_t m_capacity = 0;
+    bool m_is_persistent = false;
+
+    // GetAs() materializes rows into here. Cleared along with the columns. Several consumers may call GetAs()
+    // on the same event at once, so only one of them gets to materialize.
+    std::vector<T> m_rows;
+    bool m_has_rows = false;
+    std::mutex m_rows_mutex;
+
+public:
+    JColumnarDatabundleT();
+    JColumnarDatabundleT(const JColumnarDatabundleT& other);
+    ~JColumnarDatabundleT() override;
+
+    size_t GetSize() const override { return m_size; }
+    size_t GetCapacity() const { return m_capacity; }
+    size_t GetColumnCount() const { return m_columns.size(); }
+
+    /// Only forgets the rows. The column storage is kept so that the next event doesn't have to allocate it again.
+    void ClearData() override;
+
+    void SetPersistentFlag(bool persistent) { m_is_persistent = persistent; }
+    bool GetPersistentFlag() const { return m_is_persistent; }
+
+    /// Declares that the field `member` gets its own column. Must be called before any rows are added.
+    /// The name is only used for printing and defaults to the field's index.
+    template <typename F> void AddColumn(F T::* member, std::string name="");
+
+    template <typename F> bool HasColumn(F T::* member) const { return FindColumn(member) != nullptr; }
+
+    /// Throws if `member` doesn't have a column. Look the span up once per event rather than once per row.
+    template <typename F> JColumnSpan<F> GetColumn(F T::* member);
+    template <typename F> JColumnSpan<const F> GetColumn(F T::* member) const;
+
+    const std::string& GetColumnName(size_t index) const { return m_columns.at(index).name; }
+
+    /// Sets the number of rows. New rows are zero-initialized, and existing rows keep their values.
+    void Resize(size_t size);
+
+    void Reserve(size_t capacity);
+
+    /// Appends a row by copying each declared field of `row` into its column
+    void PushBack(const T& row);
+
+    /// Returns a default-constructed T with each declared field copied out of its column
+    T GetRow(size_t index) const;
+
+    /// Exchanges rows and storage with another databundle which declares the same columns in the same order
+    void SwapColumns(JColumnarDatabundleT& other);
+
+    /// See JLightweightDatabundleT::EnableGetAs. Here the upcast materializes the rows first.
+    template <typename S> void EnableGetAs();
+    template <typename S> void EnableGetAs(std::true_type) { EnableGetAs<S>(); }
+    template <typename S> void EnableGetAs(std::false_type) {}
+
+private:
+    template <typename F> static size_t GetOffset(F T::* member);
+    template <typename F> const Column* FindColumn(F T::* member) const;
+    void MaterializeRows();
+    void EnableDefaultGetAs();
+};
+
+
+// Template definitions
+
+template <typename T>
+JColumnarDatabundleT<T>::JColumnarDatabundleT() {
+    SetTypeName(JTypeInfo::demangle<T>());
+    SetTypeIndex(std::type_index(typeid(T)));
+    EnableDefaultGetAs();
+}
+
+template <typename T>
+JColumnarDatabundleT<T>::JColumnarDatabundleT(const JColumnarDatabundleT& other) : JDatabundle(other) {
+
+    // Copies the column declarations, not the rows
+    m_is_persistent = other.m_is_persistent;
+    for (const auto& column : other.m_columns) {
+        m_columns.push_back({column.name, column.type_index, column.offset, column.element_size, nullptr});
+    }
+    EnableDefaultGetAs();
+}
+
+template <typename T>
+JColumnarDatabundleT<T>::~JColumnarDatabundleT() {
+    for (auto& column : m_columns) {
+        ::operator delete(column.data, std::align_val_t(kColumnAlignment));
+    }
+}
+
+template <typename T>
+void JColumnarDatabundleT<T>::EnableDefaultGetAs() {
+    // This is called from both constructors because the upcast lambdas capture `this`
+    if constexpr (std::is_default_constructible_v<T> && std::is_move_constructible_v<T>) {
+        EnableGetAs<T>();
+        EnableGetAs<JObject>( std::is_convertible<T*,JObject*>() ); // Automatically add JObject if this can be converted to it
+#if JANA2_HAVE_ROOT
+        EnableGetAs<TObject>( std::is_convertible<T*,TObject*>() ); // Automatically add TObject if this can be converted to it
+#endif
+    }
+}
+
+template <typename T>
+void JColumnarDatabundleT<T>::ClearData() {
+    if (m_is_persistent) {
+        return;
+    }
+    m_size = 0;
+    m_rows.clear();
+    m_has_rows = false;
+    SetStatus(Status::Empty);
+}
+
+template <typename T>
+template <typename F>
+size_t JColumnarDatabundleT<T>::GetOffset(F T::* member) {
+    // Member pointers can't be converted to offsets directly, so we measure one on a zero-initialized buffer instead
+    // of requiring T to be default-constructible. This is the same trick offsetof() uses.
+    alignas(T) static const char buffer[sizeof(T)] = {};
+    auto* sample = reinterpret_cast<const T*>(buffer);
+    return reinterpret_cast<const char*>(&(sample->*member)) - buffer;
+}
+
+template <typename T>
+template <typename F>
+const typename JColumnarDatabundleT<T>::Column* JColumnarDatabundleT<T>::FindColumn(F T::* member) const {
+    auto offset = GetOffset(member);
+    auto type_index = std::type_index(typeid(F));
+    for (const auto& column : m_columns) {
+        if (column.offset == offset && column.type_index == type_index) {
+            return &column;
+        }
+    }
+    return nullptr;
+}
+
+template <typename T>
+template <typename F>
+void JColumnarDatabundleT<T>::AddColumn(F T::* member, std::string name) {
+    static_assert(std::is_trivially_copyable_v<F>, "Columns must have trivially copyable types");
+    if (m_capacity != 0) {
+        throw JException("Columns must be added to JColumnarDatabundleT<%s> before any rows", GetTypeName().c_str());
+    }
+    if (FindColumn(member) != nullptr) {
+        throw JException("JColumnarDatabundleT<%s> already has a column for this field", GetTypeName().c_str());
+    }
+    if (name.empty()) {
+        name = std::to_string(m_columns.size());
+    }
+    m_columns.push_back({name, std::type_index(typeid(F)), GetOffset(member), sizeof(F), nullptr});
+}
+
+template <typename T>
+template <typename F>
+JColumnSpan<F> JColumnarDatabundleT<T>::GetColumn(F T::* member) {
+    auto* column = FindColumn(member);
+    if (column == nullptr) {
+        throw JException("JColumnarDatabundleT<%s> with unique name '%s' has no column for the requested field", GetTypeName().c_str(), GetUniqueName().c_str());
+    }
+    m_has_rows = false; // The caller may modify the column, so any materialized rows are stale
+    return {reinterpret_cast<F*>(column->data), m_size};
+}
+
+template <typename T>
+template <typename F>
+JColumnSpan<const F> JColumnarDatabundleT<T>::GetColumn(F T::* member) const {
+    auto* column = FindColumn(member);
+    if (column == nullptr) {
+        throw JException("JColumnarDatabundleT<%s> with unique name '%s' has no column for the requested field", GetTypeName().c_str(), GetUniqueName().c_str());
+    }
+    return {reinterpret_cast<const F*>(column->data), m_size};
+}
+
+template <typename T>
+void JColumnarDatabundleT<T>::Reserve(size_t capacity) {
+    if (capacity <= m_capacity) {
+        return;
+    }
+    for (auto& column : m_columns) {
+        auto* data = static_cast<char*>(::operator new(capacity * column.element_size, std::align_val_t(kColumnAlignment)));
+        if (m_size != 0) {
+            std::memcpy(data, column.data, m_size * column.element_size);
+        }
+        ::operator delete(column.data, std::align_val_t(kColumnAlignment));
+        column.data = data;
+    }
+    m_capacity = capacity;
+}
+
+template <typename T>
+void JColumnarDatabundleT<T>::Resize(size_t size) {
+    if (size > m_capacity) {
+        Reserve(std::max(size, 2*m_capacity));
+    }
+    if (size > m_size) {
+        for (auto& column : m_columns) {
+            std::memset(column.data + m_size * column.element_size, 0, (size - m_size) * column.element_size);
+        }
+    }
+    m_size = size;
+    m_has_rows = false;
+}
+
+template <typename T>
+void JColumnarDatabundleT<T>::PushBack(const T& row) {
+    if (m_size == m_capacity) {
+        Reserve((m_capacity == 0) ? 16 : 2*m_capacity);
+    }
+    auto* source = reinterpret_cast<const char*>(&row);
+    for (auto& column : m_columns) {
+        std::memcpy(column.data + m_size * column.element_size, source + column.offset, column.element_size);
+    }
+    m_size += 1;
+    m_has_rows = false;
+}
+
+template <typename T>
+T JColumnarDatabundleT<T>::GetRow(size_t index) const {
+    static_assert(std::is_default_constructible_v<T>, "GetRow() needs to default-construct T");
+    if (index >= m_size) {
+        throw JException("JColumnarDatabundleT<%s> row %lu is out of range (size=%lu)", GetTypeName().c_str(), index, m_size);
+    }
+    T row {};
+    auto* destination = reinterpret_cast<char*>(&row);
+    for (const auto& column : m_columns) {
+        std::memcpy(destination + column.offset, column.data + index * column.element_size, column.element_size);
+    }
+    return row;
+}
+
+template <typename T>
+void JColumnarDatabundleT<T>::SwapColumns(JColumnarDatabundleT& other) {
+    if (m_columns.size() != other.m_columns.size()) {
+        throw JException("Can't swap columns between JColumnarDatabundleT<%s>s with different columns", GetTypeName().c_str());
+    }
+    for (size_t i=0; i<m_columns.size(); ++i) {
+        if (m_columns[i].offset != other.m_columns[i].offset || m_columns[i].type_index != other.m_columns[i].type_index) {
+            throw JException("Can't swap columns between JColumnarDatabundleT<%s>s with different columns", GetTypeName().c_str());
+        }
+        std::swap(m_columns[i].data, other.m_columns[i].data);
+    }
+    std::swap(m_size, other.m_size);
+    std::swap(m_capacity, other.m_capacity);
+    m_rows.clear();
+    other.m_rows.clear();
+    m_has_rows = false;
+    other.m_has_rows = false;
+}
+
+template <typename T>
+void JColumnarDatabundleT<T>::MaterializeRows() {
+    if constexpr (std::is_default_constructible_v<T> && std::is_move_constructible_v<T>) {
+        std::lock_guard<std::mutex> lock(m_rows_mutex);
+        if (!m_has_rows) {
+            m_rows.clear();
+            m_rows.reserve(m_size);
+            for (size_t i=0; i<m_size; ++i) {
+                m_rows.push_back(GetRow(i));
+            }
+            m_has_rows = true;
+        }
+    }
+}
+
+template <typename T>
+template <typename S>
+void JColumnarDatabundleT<T>::EnableGetAs() {
+
+    auto upcast_lambda = [this]() {
+        MaterializeRows();
+        std::vector<S*> results;
+        for (auto& row : m_rows) {
+            results.push_back(static_cast<S*>(&row));
+        }
+        return results;
+    };
+
+    auto key = std::type_index(typeid(S));
+    using upcast_fn_t = std::function<std::vector<S*>()>;
+    (*m_upcast_fns)[key] = std::unique_ptr<JAny>(new JAnyT<upcast_fn_t>(std::move(upcast_lambda)));
+}
+
@@ -0,0 +1,86 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#pragma once
+#include <JANA/JFactorySet.h>
+#include <JANA/Components/JHasOutputs.h>
+#include <JANA/Components/JColumnarDatabundle.h>
+#include <JANA/Utils/JTypeInfo.h>
+#include <typeindex>
+
+namespace jana::components {
+
+/// ColumnarOutput is the Output for a JColumnarDatabundleT. The fields which get columns are listed after the short name:
+///
+///     ColumnarOutput<Hit> m_hits_out {this, "hits", &Hit::energy, &Hit::x, &Hit::y};
+///
+/// Factories write straight into the columns, either row by row via push_back(), or column by column via
+/// Resize() followed by Column(&Hit::energy) etc. The latter is what lets the compiler vectorize the loops that fill them.
+/// Column storage is reused from one event to the next.
+template <typename T>
+class ColumnarOutput : public JHasOutputs::OutputBase {
+    JColumnarDatabundleT<T>* m_databundle; // Just so that we have a typed reference
+
+public:
+    ColumnarOutput(JHasOutputs* owner) : ColumnarOutput(owner, "") {}
+
+    template <typename... Fs>
+    ColumnarOutput(JHasOutputs* owner, std::string short_name, Fs T::*... fields) {
+        owner->RegisterOutput(this);
+        m_databundle = new JColumnarDatabundleT<T>();
+        m_databundle->SetShortName(short_name);
+        (m_databundle->AddColumn(fields), ...);
+        SetDatabundle(m_databundle);
+        // Factory will be set by JFactorySet, not here
+    }
+
+    template <typename F>
+    void AddColumn(F T::* field, std::string name="") {
+        m_databundle->AddColumn(field, name);
+    }
+
+    size_t size() const { return m_databundle->GetSize(); }
+    void Resize(size_t size) { m_databundle->Resize(size); }
+    void Reserve(size_t capacity) { m_databundle->Reserve(capacity); }
+    void push_back(const T& row) { m_databundle->PushBack(row); }
+
+    template <typename F>
+    JColumnSpan<F> Column(F T::* field) { return m_databundle->GetColumn(field); }
+
+    JColumnarDatabundleT<T>& GetDatabundle() { return *m_databundle; }
+
+    void LagrangianStore(JFactorySet&, JDatabundle::Status status) override {
+        // The factory wrote into the databundle directly, so there is nothing to move
+        m_databundle->SetStatus(status);
+    }
+
+    void EulerianStore(JFactorySet& facset) override {
+        JColumnarDatabundleT<T>* typed_bundle = nullptr;
+        auto bundle = facset.GetDatabundle(m_databundle->GetTypeIndex(), m_databundle->GetUniqueName());
+
+        if (bundle == nullptr) {
+            // No databundle present. In this case we use m_databundle as a template
+            typed_bundle = new JColumnarDatabundleT<T>(*m_databundle);
+            facset.Add(typed_bundle);
+        }
+        else {
+            typed_bundle = dynamic_cast<JColumnarDatabundleT<T>*>(bundle);
+            if (typed_bundle == nullptr) {
+                throw JException("Databundle with unique_name '%s' is not a JColumnarDatabundleT<%s>", m_databundle->GetUniqueName().c_str(), m_databundle->GetTypeName().c_str());
+            }
+        }
+        // Hand our columns over, and take the event's cleared columns in exchange so that neither side reallocates
+        typed_bundle->SwapColumns(*m_databundle);
+        m_databundle->ClearData();
+        typed_bundle->SetStatus(JDatabundle::Status::Inserted);
+        auto fac = typed_bundle->GetFactory();
+        if (fac != nullptr) {
+            UpdateFactoryStatusOnEulerianStore(fac);
+        }
+    }
+};
+
+} // jana::components
+
+template <typename T> using ColumnarOutput = jana::components::ColumnarOutput<T>;
+
@@ -7,6 +7,7 @@
 
 class JApplication;
 class JParameterManager;
+class JLatencyHistogram;
 
 #include <JANA/Utils/JEventLevel.h>
 #include <JANA/JLogger.h>
@@ -41,6 +42,7 @@ protected:
     JApplication* m_app = nullptr;
     JLogger m_logger;
     bool m_is_enabled = true;
+    JLatencyHistogram* m_latency_histogram = nullptr; // Shared by all pooled copies. See jana:latency_histograms
 
 public:
     JComponent() = default;
@@ -112,6 +114,10 @@ public:
 
     void SetLogger(JLogger logger) { m_logger = logger; }
 
+    void SetLatencyHistogram(JLatencyHistogram* histogram) { m_latency_histogram = histogram; }
+
+    JLatencyHistogram* GetLatencyHistogram() const { return m_latency_histogram; }
+
     template <typename F> 
     inline void CallWithJExceptionWrapper(std::string func_name, F func);
 
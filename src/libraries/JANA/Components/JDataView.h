@@ -0,0 +1,63 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#pragma once
+#include <JANA/JException.h>
+
+#include <cstddef>
+#include <vector>
+
+
+/// JDataView is a non-owning, read-only view over the pointers stored in a JLightweightDatabundleT<T>. Input<T>
+/// hands this out instead of copying the producer's vector on every event. It supports the read-only
+/// parts of the std::vector interface, so `m_hits_in->size()`, `m_hits_in->at(i)`, and range-based for loops
+/// work unchanged. A JDataView is only valid until the databundle it views gets cleared, i.e. until the event
+/// is recycled. Use Copy() if you need the pointers to outlive that or to be modified. There is deliberately no
+/// implicit conversion to std::vector, so that every copy is visible at the call site.
+template <typename T>
+class JDataView {
+
+    const T* const* m_data = nullptr;
+    size_t m_size = 0;
+
+public:
+    using value_type = const T*;
+    using size_type = size_t;
+    using const_iterator = const T* const*;
+    using iterator = const_iterator;
+
+    JDataView() = default;
+
+    JDataView(const T* const* data, size_t size) : m_data(data), m_size(size) {}
+
+    explicit JDataView(const std::vector<T*>& data) : m_data(data.data()), m_size(data.size()) {}
+
+    explicit JDataView(const std::vector<const T*>& data) : m_data(data.data()), m_size(data.size()) {}
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    const_iterator begin() const { return m_data; }
+    const_iterator end() const { return m_data + m_size; }
+    const_iterator cbegin() const { return m_data; }
+    const_iterator cend() const { return m_data + m_size; }
+
+    const T* const* data() const { return m_data; }
+
+    const T* operator[](size_t index) const { return m_data[index]; }
+
+    const T* at(size_t index) const {
+        if (index >= m_size) {
+            throw JException("JDataView index %lu is out of range (size=%lu)", index, m_size);
+        }
+        return m_data[index];
+    }
+
+    const T* front() const { return at(0); }
+    const T* back() const { return at(m_size - 1); }
+
+    /// Copies the pointers (not the objects they point to). This is the only place a JDataView allocates.
+    std::vector<const T*> Copy() const { return std::vector<const T*>(begin(), end()); }
+};
+
+
@@ -1,5 +1,7 @@
 
 #include "JDatabundle.h"
+#include <JANA/JFactorySet.h>
+#include <JANA/JFactory.h>
 
 
 void JDatabundle::SetUniqueName(std::string unique_name) {
@@ -47,3 +49,15 @@ void JDatabundle::SetTypeName(std::string type_name) {
         }
     }
 }
+
+void JDatabundle::MarkDirty(Status s) {
+    if (m_factory == nullptr) {
+        m_factory_set->MarkDirty(this);
+    }
+    else if (s == Status::Inserted && m_factory->GetStatus() == JFactory::Status::Empty) {
+        // Databundles with a factory get cleared via their factory instead. Usually the factory has already left Empty by
+        // now, but data can also be inserted straight into its databundle, e.g. when JEvent::InsertCollection() reuses
+        // the podio::Frame databundle on later events. Like JEvent::Insert(), this marks the factory dirty as well.
+        m_factory->SetStatus(JFactory::Status::Inserted);
+    }
+}
@@ -15,6 +15,8 @@
 
 
 class JFactory;
+class JFactorySet;
+class JArena;
 
 class JDatabundle {
 public:
@@ -30,6 +32,8 @@ private:
     bool m_has_short_name = true;
     std::string m_type_name;
     JFactory* m_factory = nullptr;
+    JArena* m_arena = nullptr;
+    JFactorySet* m_factory_set = nullptr;
     std::type_index m_inner_type_index = std::type_index(typeid(NoTypeProvided));
     mutable JCallGraphRecorder::JDataOrigin m_insert_origin = JCallGraphRecorder::ORIGIN_NOT_AVAILABLE;
 
@@ -49,7 +53,7 @@ public:
         m_type_name = other.m_type_name;
         m_factory = nullptr;
         // We do NOT propagate m_factory because JFactorySet assumes that
-        // m_factory is this object's owner.
+        // m_factory is this object's owner. Likewise m_arena and m_factory_set belong to whichever JFactorySet we get added to.
 
         m_inner_type_index = other.m_inner_type_index;
         m_insert_origin = JCallGraphRecorder::ORIGIN_NOT_AVAILABLE;
@@ -71,15 +75,28 @@ public:
     std::type_index GetTypeIndex() const { return m_inner_type_index; }
     JCallGraphRecorder::JDataOrigin GetInsertOrigin() const { return m_insert_origin; } ///< If objects were placed here by JEvent::Insert() this records whether that call was made from a source or factory.
     JFactory* GetFactory() const { return m_factory; }
+    JArena* GetArena() const { return m_arena; } ///< The owning JFactorySet's per-event arena, or nullptr if this hasn't been added to a JFactorySet
 
     // Setters
-    void SetStatus(Status s) { m_status = s;}
+    void SetStatus(Status s) {
+        if (m_status == Status::Empty && s != Status::Empty && m_factory_set != nullptr) {
+            MarkDirty(s);
+        }
+        m_status = s;
+    }
     void SetUniqueName(std::string unique_name);
     void SetShortName(std::string short_name);
     void SetTypeName(std::string type_name);
     void SetTypeIndex(std::type_index index) { m_inner_type_index = index; }
     void SetInsertOrigin(JCallGraphRecorder::JDataOrigin origin) { m_insert_origin = origin; } ///< Called automatically by JEvent::Insert() to records whether that call was made by a source or factory.
     void SetFactory(JFactory* fac) { m_factory = fac; }
+    void SetArena(JArena* arena) { m_arena = arena; } ///< Called automatically by JFactorySet::Add()
+    void SetFactorySet(JFactorySet* factory_set) { m_factory_set = factory_set; } ///< Called automatically by JFactorySet::Add()
+
+private:
+    void MarkDirty(Status s);
+
+public:
 
     // Templates 
     //
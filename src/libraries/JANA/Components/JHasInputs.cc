@@ -2,7 +2,10 @@
 #include "JHasInputs.h"
 
 #include <JANA/JEvent.h>
+#include <JANA/Engine/JExecutionEngine.h>
 #include <JANA/Utils/JEventLevel.h>
+#include <JANA/Utils/JLatencyHistogram.h>
+#include <algorithm>
 #include <typeindex>
 
 namespace jana::components {
@@ -20,9 +23,94 @@ JFactorySet* GetFactorySetAtLevel(const JEvent& event, JEventLevel desired_level
 }
 
 void FactoryCreate(const JEvent& event, JFactory* factory) {
+    JCallGraphEntryMaker cg_entry(*event.GetJCallGraphRecorder(), factory); // times execution until this goes out of scope
     factory->Create(event);
 }
 
+void CreateFactoriesConcurrently(const JEvent& event, const std::vector<JFactory*>& factories) {
+
+    auto* facset = event.GetFactorySet();
+    auto* engine = facset->GetSubtaskEngine();
+    if (!facset->IsFactoryParallelismEnabled() || engine == nullptr || factories.size() < 2) {
+        for (auto* factory : factories) {
+            try {
+                JCallGraphEntryMaker cg_entry(*event.GetJCallGraphRecorder(), factory); // times execution until this goes out of scope
+                factory->Create(event);
+            }
+            catch (...) {}
+        }
+        return;
+    }
+
+    // Offer all but the first factory to the idle workers, and run the first one on this thread. The time spent here,
+    // including waiting on the other workers, belongs to the upstream factories, so it is hidden from the caller's self time
+    JLatencyHistogram::SelfTimer upstream_timer(nullptr);
+    std::vector<std::shared_ptr<JExecutionEngine::Subtask>> subtasks;
+    for (size_t i=1; i<factories.size(); ++i) {
+        auto* factory = factories[i];
+        subtasks.push_back(engine->SubmitSubtask([&event, factory](){ factory->Create(event); }));
+    }
+    try {
+        factories[0]->Create(event);
+    }
+    catch (...) {
+        // We can't leave before the subtasks finish, because they still reference the event
+    }
+    for (auto& subtask : subtasks) {
+        engine->WaitForSubtask(*subtask);
+    }
+}
+
+
+void JHasInputs::GetUpstreamFactories(const JFactorySet& facset, std::vector<JFactory*>& factories, bool explicit_level_only) {
+
+    auto add = [&](JDatabundle* databundle) {
+        if (databundle == nullptr) return;
+        auto* factory = databundle->GetFactory();
+        if (factory == nullptr) return;
+        if (std::find(factories.begin(), factories.end(), factory) != factories.end()) return;
+        factories.push_back(factory);
+    };
+
+    auto is_at_facset_level = [&](JEventLevel input_level) {
+        if (input_level == JEventLevel::None) return !explicit_level_only;
+        return input_level == facset.GetLevel();
+    };
+
+    for (auto* input : m_inputs) {
+        if (!is_at_facset_level(input->GetLevel())) continue;
+        add(facset.GetDatabundle(input->GetDatabundleSlot()));
+    }
+    for (auto* input : m_variadic_inputs) {
+        if (!is_at_facset_level(input->GetLevel())) continue;
+        if (!input->GetRequestedDatabundleNames().empty()) {
+            for (auto slot : input->GetRequestedDatabundleSlots()) {
+                add(facset.GetDatabundle(slot));
+            }
+        }
+        else if (input->GetEmptyInputPolicy() == VariadicInputBase::EmptyInputPolicy::IncludeEverything) {
+            for (auto* databundle : facset.GetDatabundles(input->GetTypeIndex())) {
+                // A factory which merges every databundle of type T into another T doesn't depend on itself
+                if (static_cast<JHasInputs*>(databundle->GetFactory()) == this) continue;
+                add(databundle);
+            }
+        }
+    }
+}
+
+void JHasInputs::CreateInputsConcurrently(const JEvent& event) {
+
+    if (!event.GetFactorySet()->IsFactoryParallelismEnabled()) {
+        return;
+    }
+    std::vector<JFactory*> upstream;
+    GetUpstreamFactories(*event.GetFactorySet(), upstream);
+    if (upstream.size() < 2) {
+        // Nothing to overlap
+        return;
+    }
+    CreateFactoriesConcurrently(event, upstream);
+}
 
 JHasInputs::InputBase::~InputBase() {};
 
@@ -36,7 +124,7 @@ void JHasInputs::InputBase::TriggerFactoryCreate(const JEvent& event) {
         }
         throw JException("Could not find parent at level=" + toString(m_level));
     }
-    auto databundle = facset->GetDatabundle(m_type_index, m_databundle_name);
+    auto databundle = facset->GetDatabundle(m_databundle_slot);
     if (databundle == nullptr && !m_is_optional) {
         facset->Print();
         throw JException("Could not find databundle with type_index=" + m_type_name + " and tag=" + m_databundle_name);
@@ -58,8 +146,9 @@ void JHasInputs::VariadicInputBase::TriggerFactoryCreate(const JEvent& event) {
         throw JException("Could not find parent at level=" + toString(m_level));
     }
     if (!m_requested_databundle_names.empty()) {
-        for (auto& tag : m_requested_databundle_names) {
-            auto coll = facset->GetDatabundle(m_type_index, tag);
+        for (size_t i=0; i<m_requested_databundle_names.size(); ++i) {
+            auto& tag = m_requested_databundle_names[i];
+            auto coll = facset->GetDatabundle(m_requested_databundle_slots[i]);
             if (coll == nullptr && !m_is_optional) {
                 facset->Print();
                 throw JException("Could not find databundle with type_index=" + m_type_name + " and tag=" + tag);
@@ -73,7 +162,7 @@ void JHasInputs::VariadicInputBase::TriggerFactoryCreate(const JEvent& event) {
         }
     }
     else if (m_empty_input_policy == EmptyInputPolicy::IncludeEverything) {
-        auto databundles = facset->GetDatabundles(m_type_index);
+        const auto& databundles = facset->GetDatabundles(m_type_index);
         for (auto* databundle : databundles) {
             auto* factory = databundle->GetFactory();
             if (factory != nullptr) {
@@ -9,6 +9,8 @@
 #include "JANA/Components/JPodioDatabundle.h"
 #endif
 #include "JANA/Components/JLightweightDatabundle.h"
+#include "JANA/Components/JDataView.h"
+#include "JANA/Components/JColumnarDatabundle.h"
 #include "JANA/Utils/JEventLevel.h"
 #include "JANA/Utils/JTypeInfo.h"
 #include "JANA/JFactorySet.h"
@@ -22,6 +24,11 @@ namespace jana::components {
 JFactorySet* GetFactorySetAtLevel(const JEvent& event, JEventLevel desired_level);
 void FactoryCreate(const JEvent& event, JFactory* factory);
 
+// Calls Create() on each of the factories, which must not depend on each other. If jana:enable_factory_parallelism
+// is set, they run concurrently as subtasks on the worker pool. Exceptions are swallowed, because each factory
+// remembers its exception and rethrows it the next time somebody calls Create().
+void CreateFactoriesConcurrently(const JEvent& event, const std::vector<JFactory*>& factories);
+
 struct JHasInputs {
 
     class InputBase;
@@ -53,6 +60,16 @@ public:
         return m_variadic_inputs; 
     }
 
+    /// Collects the factories in `facset` which produce our inputs, without duplicates. Inputs at a different
+    /// event level, inputs which are inserted rather than produced, and missing optional inputs are skipped.
+    /// If `explicit_level_only` is set, inputs which don't name a level are skipped as well. This is for when
+    /// `facset` isn't at our own level, e.g. when looking for the Timeslice factories that a PhysicsEvent processor reads.
+    void GetUpstreamFactories(const JFactorySet& facset, std::vector<JFactory*>& factories, bool explicit_level_only=false);
+
+    /// If jana:enable_factory_parallelism is set, creates the factories which produce our inputs concurrently,
+    /// as subtasks on the worker pool. Any exceptions are deferred until the inputs get populated.
+    void CreateInputsConcurrently(const JEvent& event);
+
     struct InputOptions {
         std::string name {""};
         JEventLevel level {JEventLevel::None};
@@ -70,9 +87,15 @@ public:
         std::type_index m_type_index = std::type_index(typeid(JDatabundle::NoTypeProvided));
         std::string m_type_name;
         std::string m_databundle_name;
+        size_t m_databundle_slot = 0;
         JEventLevel m_level = JEventLevel::None;
         bool m_is_optional = false;
 
+        /// Must be called whenever m_type_index or m_databundle_name changes
+        void ResolveDatabundleSlot() {
+            m_databundle_slot = JFactorySet::ResolveSlot(m_type_index, m_databundle_name);
+        }
+
     public:
 
         virtual ~InputBase();
@@ -87,6 +110,7 @@ public:
 
         void SetDatabundleName(std::string name) {
             m_databundle_name = name;
+            ResolveDatabundleSlot();
         }
 
         const std::string& GetTypeName() const {
@@ -97,6 +121,14 @@ public:
             return m_databundle_name;
         }
 
+        size_t GetDatabundleSlot() const {
+            return m_databundle_slot;
+        }
+
+        std::type_index GetTypeIndex() const {
+            return m_type_index;
+        }
+
         JEventLevel GetLevel() const {
             return m_level;
         }
@@ -105,6 +137,7 @@ public:
             m_databundle_name = options.name;
             m_level = options.level;
             m_is_optional = options.is_optional;
+            ResolveDatabundleSlot();
         }
 
         void TriggerFactoryCreate(const JEvent& event);
@@ -120,10 +153,19 @@ public:
         std::string m_type_name;
         std::vector<std::string> m_requested_databundle_names;
         std::vector<std::string> m_realized_databundle_names;
+        std::vector<size_t> m_requested_databundle_slots;
         JEventLevel m_level = JEventLevel::None;
         bool m_is_optional = false;
         EmptyInputPolicy m_empty_input_policy = EmptyInputPolicy::IncludeNothing;
 
+        /// Must be called whenever m_type_index or m_requested_databundle_names changes
+        void ResolveDatabundleSlots() {
+            m_requested_databundle_slots.clear();
+            for (const auto& name : m_requested_databundle_names) {
+                m_requested_databundle_slots.push_back(JFactorySet::ResolveSlot(m_type_index, name));
+            }
+        }
+
     public:
 
         virtual ~VariadicInputBase();
@@ -142,6 +184,7 @@ public:
             // If options.names are empty, m_realized_databundle_names will be filled later
             // Otherwise, m_realized_databundle_names always matches m_requested_databundle_names
             // This weirdness is an optimization to avoid having to repopulate m_realized_databundle_names for every event
+            ResolveDatabundleSlots();
         }
 
         void SetEmptyInputPolicy(EmptyInputPolicy policy) {
@@ -160,6 +203,19 @@ public:
             return m_realized_databundle_names;
         }
 
+        /// Parallel to GetRequestedDatabundleNames()
+        const std::vector<size_t>& GetRequestedDatabundleSlots() const {
+            return m_requested_databundle_slots;
+        }
+
+        std::type_index GetTypeIndex() const {
+            return m_type_index;
+        }
+
+        EmptyInputPolicy GetEmptyInputPolicy() const {
+            return m_empty_input_policy;
+        }
+
         JEventLevel GetLevel() const {
             return m_level;
         }
@@ -172,6 +228,7 @@ public:
             // This weirdness is an optimization to avoid having to repopulate m_realized_databundle_names for every event
             m_level = options.level;
             m_is_optional = options.is_optional;
+            ResolveDatabundleSlots();
         }
 
         void TriggerFactoryCreate(const JEvent& event);
@@ -182,7 +239,7 @@ public:
     template <typename T>
     class Input : public InputBase {
 
-        std::vector<const T*> m_data;
+        JDataView<T> m_data; // Points directly into the producer's databundle
 
     public:
 
@@ -191,6 +248,7 @@ public:
             m_type_index = std::type_index(typeid(T));
             m_type_name = JTypeInfo::demangle<T>();
             m_level = JEventLevel::None;
+            ResolveDatabundleSlot();
         }
 
         Input(JHasInputs* owner, const InputOptions& options) {
@@ -202,11 +260,12 @@ public:
 
         void SetTag(std::string tag) {
             m_databundle_name = tag;
+            ResolveDatabundleSlot();
         }
 
-        const std::vector<const T*>& operator()() { return m_data; }
-        const std::vector<const T*>& operator*() { return m_data; }
-        const std::vector<const T*>* operator->() { return &m_data; }
+        const JDataView<T>& operator()() { return m_data; }
+        const JDataView<T>& operator*() { return m_data; }
+        const JDataView<T>* operator->() { return &m_data; }
 
 
     private:
@@ -214,10 +273,10 @@ public:
 
         void Populate(const JEvent& event) {
 
-            // Eventually, we might try maintaining a permanent link to the databundle
-            // instead of having to retrieve it every time. This will only work if we are both on a
-            // JFactory in the same JFactorySet, though.
+            // The databundle slot was resolved when this input was wired, so finding the databundle
+            // is a single indexed load instead of a map lookup keyed on the type and name
 
+            m_data = {};
             auto facset = GetFactorySetAtLevel(event, m_level);
             if (facset == nullptr) {
                 if (m_is_optional) {
@@ -225,13 +284,12 @@ public:
                 }
                 throw JException("Could not find parent at level=" + toString(m_level));
             }
-            auto databundle = facset->GetDatabundle(std::type_index(typeid(T)), m_databundle_name);
+            auto databundle = facset->GetDatabundle(m_databundle_slot);
             if (databundle == nullptr) {
                 if (!m_is_optional) {
                     facset->Print();
                     throw JException("Could not find databundle with type_index=" + JTypeInfo::demangle<T>() + " and tag=" + m_databundle_name);
                 }
-                m_data.clear();
                 return;
             };
             if (databundle->GetFactory() != nullptr) {
@@ -243,9 +301,85 @@ public:
                     facset->Print();
                     throw JException("Databundle with shortname '%s' does not inherit from JLightweightDatabundleT<%s>", m_databundle_name.c_str(), JTypeInfo::demangle<T>().c_str());
                 }
+                return;
+            }
+            m_data = JDataView<T>(typed_databundle->GetData());
+        }
+    };
+
+    /// ColumnarInput reads a JColumnarDatabundleT<T> produced by a ColumnarOutput<T>. Instead of a vector of
+    /// objects, it exposes one read-only JColumnSpan per field, e.g. `m_hits_in.Column(&Hit::energy)`.
+    /// A missing optional input presents as zero rows.
+    template <typename T>
+    class ColumnarInput : public InputBase {
+
+        const JColumnarDatabundleT<T>* m_databundle = nullptr;
+
+    public:
+
+        ColumnarInput(JHasInputs* owner) {
+            owner->RegisterInput(this);
+            m_type_index = std::type_index(typeid(T));
+            m_type_name = JTypeInfo::demangle<T>();
+            m_level = JEventLevel::None;
+            ResolveDatabundleSlot();
+        }
+
+        ColumnarInput(JHasInputs* owner, const InputOptions& options) {
+            owner->RegisterInput(this);
+            m_type_index = std::type_index(typeid(T));
+            m_type_name = JTypeInfo::demangle<T>();
+            Configure(options);
+        }
+
+        void SetTag(std::string tag) {
+            m_databundle_name = tag;
+            ResolveDatabundleSlot();
+        }
+
+        size_t size() const {
+            return (m_databundle == nullptr) ? 0 : m_databundle->GetSize();
+        }
+
+        /// Throws if the producer didn't declare a column for `field`
+        template <typename F>
+        JColumnSpan<const F> Column(F T::* field) const {
+            if (m_databundle == nullptr) {
+                return {};
+            }
+            return m_databundle->GetColumn(field);
+        }
+
+        const JColumnarDatabundleT<T>* GetDatabundle() const { return m_databundle; }
+
+    private:
+        friend class JComponentT;
+
+        void Populate(const JEvent& event) {
+            m_databundle = nullptr;
+            auto facset = GetFactorySetAtLevel(event, m_level);
+            if (facset == nullptr) {
+                if (m_is_optional) {
+                    return;
+                }
+                throw JException("Could not find parent at level=" + toString(m_level));
+            }
+            auto databundle = facset->GetDatabundle(m_databundle_slot);
+            if (databundle == nullptr) {
+                if (!m_is_optional) {
+                    facset->Print();
+                    throw JException("Could not find databundle with type_index=" + JTypeInfo::demangle<T>() + " and tag=" + m_databundle_name);
+                }
+                return;
+            };
+            if (databundle->GetFactory() != nullptr) {
+                FactoryCreate(event, databundle->GetFactory());
+            }
+            m_databundle = dynamic_cast<const JColumnarDatabundleT<T>*>(databundle);
+            if (m_databundle == nullptr && !m_is_optional) {
+                facset->Print();
+                throw JException("Databundle with shortname '%s' does not inherit from JColumnarDatabundleT<%s>", m_databundle_name.c_str(), JTypeInfo::demangle<T>().c_str());
             }
-            m_data.clear();
-            m_data.insert(m_data.end(), typed_databundle->GetData().begin(), typed_databundle->GetData().end());
         }
     };
 
@@ -263,6 +397,7 @@ public:
             m_type_name = JTypeInfo::demangle<PodioT>();
             m_databundle_name = m_type_name;
             m_level = JEventLevel::None;
+            ResolveDatabundleSlot();
         }
 
         PodioInput(JHasInputs* owner, const InputOptions& options) {
@@ -285,10 +420,12 @@ public:
 
         void SetCollectionName(std::string name) {
             m_databundle_name = name;
+            ResolveDatabundleSlot();
         }
 
         void SetTag(std::string tag) {
             m_databundle_name = m_type_name + ":" + tag;
+            ResolveDatabundleSlot();
         }
 
         void Populate(const JEvent& event) {
@@ -299,7 +436,7 @@ public:
                 }
                 throw JException("Could not find parent at level=" + toString(m_level));
             }
-            auto databundle = facset->GetDatabundle(std::type_index(typeid(PodioT)), m_databundle_name);
+            auto databundle = facset->GetDatabundle(m_databundle_slot);
             if (databundle == nullptr) {
                 if (!m_is_optional) {
                     facset->Print();
@@ -329,7 +466,7 @@ public:
     template <typename T>
     class VariadicInput : public VariadicInputBase {
 
-        std::vector<std::vector<const T*>> m_datas;
+        std::vector<JDataView<T>> m_datas; // Each points directly into the producer's databundle
 
     public:
 
@@ -338,6 +475,7 @@ public:
             m_type_index = std::type_index(typeid(T));
             m_type_name = JTypeInfo::demangle<T>();
             m_level = JEventLevel::None;
+            ResolveDatabundleSlots();
         }
 
         VariadicInput(JHasInputs* owner, const VariadicInputOptions& options) {
@@ -350,13 +488,14 @@ public:
         void SetTags(std::vector<std::string> tags) {
             m_requested_databundle_names = tags;
             m_realized_databundle_names = tags;
+            ResolveDatabundleSlots();
         }
 
-        const std::vector<std::vector<const T*>>& operator()() { return m_datas; }
-        const std::vector<std::vector<const T*>>& operator*() { return m_datas; }
-        const std::vector<std::vector<const T*>>* operator->() { return &m_datas; }
+        const std::vector<JDataView<T>>& operator()() { return m_datas; }
+        const std::vector<JDataView<T>>& operator*() { return m_datas; }
+        const std::vector<JDataView<T>>* operator->() { return &m_datas; }
 
-        const std::vector<const T*>& operator()(size_t index) { return m_datas.at(index); }
+        const JDataView<T>& operator()(size_t index) { return m_datas.at(index); }
 
 
     private:
@@ -373,8 +512,9 @@ public:
             }
             if (!m_requested_databundle_names.empty()) {
                 // We have a nonempty input, so we provide the user exactly the inputs they asked for (some of these may be null IF is_optional=true)
-                for (auto& short_or_unique_name : m_requested_databundle_names) {
-                    auto databundle = facset->GetDatabundle(std::type_index(typeid(T)), short_or_unique_name);
+                for (size_t i=0; i<m_requested_databundle_names.size(); ++i) {
+                    auto& short_or_unique_name = m_requested_databundle_names[i];
+                    auto databundle = facset->GetDatabundle(m_requested_databundle_slots[i]);
                     if (databundle == nullptr) {
                         if (!m_is_optional) {
                             facset->Print();
@@ -391,26 +531,21 @@ public:
                         facset->Print();
                         throw JException("Databundle with shortname '%s' does not inherit from JLightweightDatabundleT<%s>", short_or_unique_name.c_str(), JTypeInfo::demangle<T>().c_str());
                     }
-                    m_datas.push_back({});
-                    auto& dest = m_datas.back();
-                    dest.insert(dest.end(), typed_databundle->GetData().begin(), typed_databundle->GetData().end());
+                    m_datas.emplace_back(typed_databundle->GetData());
                 }
             }
             else if (m_empty_input_policy == EmptyInputPolicy::IncludeEverything) {
                 // We have an empty input and a nontrivial empty input policy
                 m_realized_databundle_names.clear();
 
-                auto databundles = facset->GetDatabundles(std::type_index(typeid(T)));
+                const auto& databundles = facset->GetDatabundles(std::type_index(typeid(T)));
                 for (auto* databundle : databundles) {
 
                     auto typed_databundle = dynamic_cast<JLightweightDatabundleT<T>*>(databundle);
                     if (typed_databundle == nullptr) {
                         throw JException("Databundle with name=" + typed_databundle->GetUniqueName() + " does not inherit from JLightweightDatabundleT<" + JTypeInfo::demangle<T>() + ">");
                     }
-                    auto& contents = typed_databundle->GetData();
-                    m_datas.push_back({}); // Create a destination for this factory's data
-                    auto& dest = m_datas.back();
-                    dest.insert(dest.end(), contents.begin(), contents.end());
+                    m_datas.emplace_back(typed_databundle->GetData());
                     if (databundle->HasShortName()) {
                         m_realized_databundle_names.push_back(databundle->GetShortName());
                     }
@@ -436,6 +571,7 @@ public:
             owner->RegisterInput(this);
             m_type_index = std::type_index(typeid(PodioT));
             m_type_name = JTypeInfo::demangle<PodioT>();
+            ResolveDatabundleSlots();
         }
 
         VariadicPodioInput(JHasInputs* owner, const VariadicInputOptions& options) {
@@ -452,6 +588,7 @@ public:
         void SetRequestedCollectionNames(std::vector<std::string> names) {
             m_requested_databundle_names = names;
             m_realized_databundle_names = std::move(names);
+            ResolveDatabundleSlots();
         }
 
         const std::vector<std::string>& GetRealizedCollectionNames() {
@@ -472,8 +609,9 @@ public:
             }
             m_datas.clear();
             if (!m_requested_databundle_names.empty()) {
-                for (auto& short_or_unique_name : m_requested_databundle_names) {
-                    auto databundle = facset->GetDatabundle(std::type_index(typeid(PodioT)), short_or_unique_name);
+                for (size_t i=0; i<m_requested_databundle_names.size(); ++i) {
+                    auto& short_or_unique_name = m_requested_databundle_names[i];
+                    auto databundle = facset->GetDatabundle(m_requested_databundle_slots[i]);
                     if (databundle == nullptr) {
                         if (!m_is_optional) {
                             facset->Print();
@@ -499,7 +637,7 @@ public:
                 }
             }
             else if (m_empty_input_policy == EmptyInputPolicy::IncludeEverything) {
-                auto databundles = facset->GetDatabundles(std::type_index(typeid(PodioT)));
+                const auto& databundles = facset->GetDatabundles(std::type_index(typeid(PodioT)));
                 for (auto* databundle : databundles) {
                     if (databundle->GetFactory() != nullptr) {
                         FactoryCreate(event, databundle->GetFactory());
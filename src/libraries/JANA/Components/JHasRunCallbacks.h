@@ -5,6 +5,8 @@
 #pragma once
 
 #include <JANA/JApplication.h>
+#include <JANA/Components/JComponentFwd.h>
+#include <JANA/Services/JRunCache.h>
 
 class JEvent;
 namespace jana::components {
@@ -46,6 +48,48 @@ public:
         }
     };
 
+    /// SharedResource is like Resource, except that the lambda runs only once per run number for all pooled copies of
+    /// the owning component, instead of once per copy. Every copy gets a pointer to the same result, which therefore must
+    /// be treated as read-only. The result is freed once the last copy holding on to it has moved on to another run.
+    /// Use this for calibrations, lookup tables, and anything else that is expensive to build in BeginRun/ChangeRun.
+    ///
+    ///     SharedResource<CalibService, CalibTable, ...> m_calib {this, "calib", [](auto svc, int32_t run_nr){ ... }};
+    ///
+    /// Copies are identified by their type name and prefix, so differently configured instances of the same
+    /// factory don't share.
+    template <typename ServiceT, typename ResourceT, typename LambdaT>
+    class SharedResource : public ResourceBase {
+        JHasRunCallbacks* m_owner;
+        std::string m_name;
+        std::shared_ptr<const ResourceT> m_data;
+        LambdaT m_lambda;
+
+    public:
+
+        SharedResource(JHasRunCallbacks* owner, std::string name, LambdaT lambda) : m_owner(owner), m_name(std::move(name)), m_lambda(lambda) {
+            owner->RegisterResource(this);
+        };
+
+        const ResourceT& operator()() { return *m_data; }
+        std::shared_ptr<const ResourceT> GetShared() const { return m_data; }
+
+    protected:
+
+        void ChangeRun(int32_t run_nr, JApplication* app) override {
+            std::string key = m_name;
+            auto* component = dynamic_cast<JComponent*>(m_owner);
+            if (component != nullptr) {
+                key = component->GetTypeName() + ":" + component->GetPrefix() + ":" + m_name;
+            }
+            // Release the previous run's data before possibly computing the next, so that it can be freed as early as possible
+            m_data = nullptr;
+            m_data = app->template GetService<JRunCache>()->template GetOrCompute<ResourceT>(key, run_nr, [&](){
+                std::shared_ptr<ServiceT> service = app->template GetService<ServiceT>();
+                return m_lambda(service, run_nr);
+            });
+        }
+    };
+
     // ExpertMode
     virtual void ChangeRun(const JEvent&) {}
 
@@ -4,7 +4,12 @@
 #include <JANA/Components/JDatabundle.h>
 #include <JANA/JObject.h> 
 #include <JANA/Utils/JTypeInfo.h>
+#include <JANA/Utils/JArena.h>
+#include <new>
 #include <typeindex>
+#include <typeinfo>
+#include <type_traits>
+#include <utility>
 
 #if JANA2_HAVE_ROOT
 #include <TObject.h>
@@ -18,6 +23,18 @@ private:
     bool m_is_persistent = false;
     bool m_not_object_owner = false;
 
+    // Pooling state
+    bool m_is_pooling_enabled = false;
+    std::vector<T*> m_free_list; // Objects from previous events, kept alive so that they can be reset and reused
+    size_t m_pool_allocation_count = 0;
+    size_t m_pool_reuse_count = 0;
+
+    // Arena state
+    bool m_is_arena_enabled = false;
+    size_t m_arena_object_count = 0; // Objects from the current event which live in GetArena()
+
+    void Release(T* p);
+
 public:
     JLightweightDatabundleT(std::vector<T*>* external_data=nullptr);
     JLightweightDatabundleT(const JLightweightDatabundleT& other);
@@ -34,6 +51,36 @@ public:
     bool GetPersistentFlag() { return m_is_persistent; }
     bool GetNotOwnerFlag() { return m_not_object_owner; }
 
+    /// When pooling is enabled, ClearData() returns objects to a free list instead of deleting them, and Acquire()
+    /// resets and reuses them instead of allocating new ones. Objects are reset via move-assignment from a freshly
+    /// constructed T, so T must be move-assignable. Subclasses of T are never recycled, just deleted as usual.
+    void SetPoolingFlag(bool pooling) { m_is_pooling_enabled = pooling; }
+    bool GetPoolingFlag() const { return m_is_pooling_enabled; }
+
+    /// Returns a T constructed from args, recycled from the free list if possible. The caller still has to add it to GetData().
+    /// If T has no matching constructor, it gets aggregate-initialized from args instead. In that case, give any members
+    /// which args doesn't cover a default member initializer, or -Wextra will warn about them.
+    template <typename... Args> T* Acquire(Args&&... args);
+
+    /// Number of objects Acquire() had to allocate because the free list was empty
+    size_t GetPoolAllocationCount() const { return m_pool_allocation_count; }
+
+    /// Number of objects Acquire() recycled from the free list
+    size_t GetPoolReuseCount() const { return m_pool_reuse_count; }
+
+    size_t GetFreeListSize() const { return m_free_list.size(); }
+
+    /// When the arena is enabled, Acquire() constructs objects in the owning JFactorySet's per-event JArena instead of
+    /// on the heap. ClearData() then only has to run their destructors (or nothing at all, if T is trivially destructible),
+    /// and JFactorySet::Clear() frees their memory all at once. Objects obtained from Acquire() must stay in GetData()
+    /// until the event is cleared. The arena is ignored while pooling is enabled, since arena objects get destroyed
+    /// rather than recycled, and persistent databundles never use it, because the arena gets reset on every event.
+    void SetArenaFlag(bool arena) { m_is_arena_enabled = arena; }
+    bool GetArenaFlag() const { return m_is_arena_enabled; }
+
+    /// Number of objects from the current event which live in the arena
+    size_t GetArenaObjectCount() const { return m_arena_object_count; }
+
     /// EnableGetAs generates a vtable entry so that users may extract the
     /// contents of this JFactoryT from the type-erased JFactory. The user has to manually specify which upcasts
     /// to allow, and they have to do so for each instance. It is recommended to do so in the constructor.
@@ -76,6 +123,8 @@ JLightweightDatabundleT<T>::JLightweightDatabundleT(const JLightweightDatabundle
 
     m_is_persistent = other.m_is_persistent;
     m_not_object_owner = other.m_not_object_owner;
+    m_is_pooling_enabled = other.m_is_pooling_enabled;
+    m_is_arena_enabled = other.m_is_arena_enabled;
 
     // TODO: This doesn't copy over any additional EnableGetAs()
     EnableGetAs<T>();
@@ -90,6 +139,7 @@ JLightweightDatabundleT<T>::~JLightweightDatabundleT() {
     if (m_owns_data) {
         delete m_data;
     }
+    for (auto p : m_free_list) delete p;
 }
 
 template <typename T>
@@ -101,14 +151,97 @@ void JLightweightDatabundleT<T>::ClearData() {
         return;
     }
 
-    // Assuming we _are_ the object owner, delete the underlying jobjects
-    if (!GetNotOwnerFlag()) {
-        for (auto p : *m_data) delete p;
+    if (GetNotOwnerFlag()) {
+        // Whichever databundle owns the objects destroys them, whether they live on the heap or in the arena
+    }
+    else if (m_arena_object_count != 0) {
+        // JFactorySet::Clear() frees the arena's memory once every databundle has been cleared. We only have to
+        // run the destructors, and can skip even that when everything came from the arena and T doesn't have one.
+        if (!std::is_trivially_destructible_v<T> || m_arena_object_count != m_data->size()) {
+            for (auto p : *m_data) {
+                if (GetArena()->Contains(p)) {
+                    p->~T();
+                }
+                else {
+                    Release(p);
+                }
+            }
+        }
+    }
+    else {
+        // Assuming we _are_ the object owner, delete the underlying jobjects
+        for (auto p : *m_data) Release(p);
     }
+    m_arena_object_count = 0;
     m_data->clear();
     SetStatus(Status::Empty);
 }
 
+template <typename T>
+void JLightweightDatabundleT<T>::Release(T* p) {
+    if constexpr (std::is_move_assignable_v<T>) {
+        if (m_is_pooling_enabled) {
+            // A subclass of T can't be reset by assigning a T to it
+            bool is_exactly_t = true;
+            if constexpr (std::is_polymorphic_v<T>) {
+                is_exactly_t = (typeid(*p) == typeid(T));
+            }
+            if (is_exactly_t) {
+                m_free_list.push_back(p);
+                return;
+            }
+        }
+    }
+    delete p;
+}
+
+template <typename T>
+template <typename... Args>
+T* JLightweightDatabundleT<T>::Acquire(Args&&... args) {
+
+    // Support aggregates as well as regular constructors, since we don't have C++20's parenthesized aggregate init
+    auto construct = [&]() {
+        if constexpr (std::is_constructible_v<T, Args...>) {
+            return T(std::forward<Args>(args)...);
+        }
+        else {
+            return T{std::forward<Args>(args)...};
+        }
+    };
+
+    bool is_pooling = false;
+    if constexpr (std::is_move_assignable_v<T>) {
+        is_pooling = m_is_pooling_enabled;
+        if (is_pooling && !m_free_list.empty()) {
+            T* recycled = m_free_list.back();
+            *recycled = construct(); // Reset rather than free. If construction throws, the object stays in the free list
+            m_free_list.pop_back();
+            m_pool_reuse_count += 1;
+            return recycled;
+        }
+    }
+    // Pooled objects have to come from the heap so that Release() can recycle them
+    if (m_is_arena_enabled && !is_pooling && !m_is_persistent && GetArena() != nullptr) {
+        void* memory = GetArena()->Allocate(sizeof(T), alignof(T));
+        T* obj;
+        if constexpr (std::is_constructible_v<T, Args...>) {
+            obj = new (memory) T(std::forward<Args>(args)...);
+        }
+        else {
+            obj = new (memory) T{std::forward<Args>(args)...};
+        }
+        m_arena_object_count += 1;
+        return obj;
+    }
+    m_pool_allocation_count += 1;
+    if constexpr (std::is_constructible_v<T, Args...>) {
+        return new T(std::forward<Args>(args)...);
+    }
+    else {
+        return new T{std::forward<Args>(args)...};
+    }
+}
+
 template<typename T>
 template<typename S>
 void JLightweightDatabundleT<T>::EnableGetAs() {
@@ -3,6 +3,7 @@
 #include "JANA/JFactorySet.h"
 #include <JANA/Components/JHasOutputs.h>
 #include <JANA/Components/JLightweightDatabundle.h>
+#include <JANA/Components/JDataView.h>
 #include <JANA/Utils/JTypeInfo.h>
 #include <typeindex>
 
@@ -13,6 +14,7 @@ class Output : public JHasOutputs::OutputBase {
     std::vector<T*> m_transient_data;
     std::vector<T*>* m_external_data = nullptr; // This is a hack for JFactoryT
     JLightweightDatabundleT<T>* m_databundle; // Just so that we have a typed reference
+    bool m_is_parent_view = false;
 
 public:
     Output(JHasOutputs* owner, std::string short_name="") {
@@ -40,13 +42,69 @@ public:
         m_databundle->SetNotOwnerFlag(not_owner);
     }
 
+    /// Recycle this output's objects from one event to the next instead of deleting and reallocating them.
+    /// Only objects created via emplace_back() benefit. See JLightweightDatabundleT::SetPoolingFlag().
+    /// This only applies to factory outputs, since sources insert into a different databundle on each event.
+    void EnablePooling(bool enable=true) {
+        m_databundle->SetPoolingFlag(enable);
+    }
+
+    /// Construct objects created via emplace_back() in the event's JArena, which JFactorySet::Clear() frees in one step.
+    /// Objects that aren't trivially destructible still get their destructors called individually.
+    /// Like pooling, this only applies to factory outputs, and it has no effect while pooling is enabled.
+    /// See JLightweightDatabundleT::SetArenaFlag().
+    void EnableArena(bool enable=true) {
+        m_databundle->SetArenaFlag(enable);
+    }
+
+    /// Lets an unfolder fill this child output with objects that belong to the parent event instead of copies, e.g.
+    /// to split a timeslice's hits among its physics events. Downstream Input<T>s can't tell the difference. The objects
+    /// stay valid for as long as the child holds onto its parent, because the parent event isn't cleared until its
+    /// last child has been released. Use AppendParentRange() to fill it. Not available with
+    /// JEventUnfolder::EnableParallelUnfold(), which doesn't support Output members at all.
+    void EnableParentView(bool enable=true) {
+        m_databundle->SetNotOwnerFlag(enable);
+        m_is_parent_view = enable;
+    }
+
+    /// Appends parent_data[begin, end), typically from an Input<T> at the parent level. Only the pointers get copied.
+    void AppendParentRange(const JDataView<T>& parent_data, size_t begin, size_t end) {
+        if (!m_is_parent_view) {
+            throw JException("Output<%s> '%s' needs EnableParentView() before calling AppendParentRange()", JTypeInfo::demangle<T>().c_str(), m_databundle->GetUniqueName().c_str());
+        }
+        if (begin > end || end > parent_data.size()) {
+            throw JException("AppendParentRange: Range [%lu, %lu) is out of bounds (size=%lu)", begin, end, parent_data.size());
+        }
+        auto& data = (*this)();
+        for (size_t i=begin; i<end; ++i) {
+            // Consumers only ever get const access to these, same as for the parent
+            data.push_back(const_cast<T*>(parent_data[i]));
+        }
+    }
+
     std::vector<T*>& operator()() { return (m_external_data == nullptr) ? m_transient_data : *m_external_data; }
 
+    /// Constructs a T from args and appends it. If pooling is enabled, this reuses an object from a previous event when possible.
+    /// Otherwise, if the arena is enabled, this places it in the event's JArena.
+    template <typename... Args>
+    T* emplace_back(Args&&... args) {
+        T* obj = m_databundle->Acquire(std::forward<Args>(args)...);
+        (*this)().push_back(obj);
+        return obj;
+    }
+
     JLightweightDatabundleT<T>& GetDatabundle() { return *m_databundle; }
 
     void LagrangianStore(JFactorySet&, JDatabundle::Status status) override {
         if (m_external_data == nullptr) {
-            m_databundle->GetData() = std::move(m_transient_data);
+            auto& stored_data = m_databundle->GetData();
+            if (stored_data.empty()) {
+                // Hand the (cleared) vector from the previous event back, so that neither side reallocates
+                std::swap(stored_data, m_transient_data);
+            }
+            else {
+                stored_data = std::move(m_transient_data);
+            }
         }
         m_databundle->SetStatus(status);
     }
@@ -0,0 +1,206 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#include "JAutoscaler.h"
+#include <JANA/JApplication.h>
+#include <JANA/Utils/JCpuInfo.h>
+
+#include <algorithm>
+#include <sstream>
+
+
+void JAutoscaler::Init() {
+    auto params = GetApplication()->GetJParameterManager();
+
+    m_max_threads = JCpuInfo::GetNumCpus();
+
+    params->SetDefaultParameter("jana:autoscale_min_threads", m_min_threads,
+        "Min number of threads the autoscaler may scale down to")
+        ->SetIsAdvanced(true);
+
+    params->SetDefaultParameter("jana:autoscale_max_threads", m_max_threads,
+        "Max number of threads the autoscaler may scale up to. Defaults to the number of cores.")
+        ->SetIsAdvanced(true);
+
+    m_max_inflight_events = 4 * m_max_threads;
+    params->SetDefaultParameter("jana:autoscale_max_inflight_events", m_max_inflight_events,
+        "Max number of in-flight events the autoscaler may grow the event pool to. Defaults to 4x the max number of threads.")
+        ->SetIsAdvanced(true);
+
+    params->SetDefaultParameter("jana:autoscale_interval_ms", m_interval_ms,
+        "Length of each autoscaler measurement window (in ms). Each window ends in at most one scaling decision.")
+        ->SetIsAdvanced(true);
+
+    params->SetDefaultParameter("jana:autoscale_threshold", m_threshold,
+        "Min relative change in throughput which the autoscaler treats as significant")
+        ->SetIsAdvanced(true);
+
+    params->SetDefaultParameter("jana:autoscale_cooldown", m_cooldown_windows,
+        "Number of measurement windows the autoscaler waits after undoing an unsuccessful scaling step")
+        ->SetIsAdvanced(true);
+
+    if (m_min_threads == 0) {
+        m_min_threads = 1;
+    }
+    if (m_max_threads < m_min_threads) {
+        throw JException("jana:autoscale_max_threads=%lu is smaller than jana:autoscale_min_threads=%lu", m_max_threads, m_min_threads);
+    }
+}
+
+
+void JAutoscaler::OpenWindow(const JExecutionEngine::Perf& perf) {
+    m_is_window_open = true;
+    m_window_start_time = clock_t::now();
+    m_window_start_event_count = perf.event_count;
+    m_window_start_idle_ms = perf.idle_time_ms;
+    m_window_start_scheduler_ms = perf.scheduler_time_ms;
+    m_sample_count = 0;
+    m_idle_worker_samples = 0;
+    m_empty_pool_samples = 0;
+}
+
+
+void JAutoscaler::Tick(JExecutionEngine& engine) {
+
+    auto perf = engine.GetPerf();
+    if (perf.runstatus != JExecutionEngine::RunStatus::Running || perf.thread_count == 0) {
+        // Measurements taken while pausing or draining don't tell us anything about the steady state
+        m_is_window_open = false;
+        return;
+    }
+    if (!m_is_window_open) {
+        OpenWindow(perf);
+        return;
+    }
+
+    m_sample_count += 1;
+    m_idle_worker_samples += perf.idle_worker_count;
+    if (perf.free_event_count == 0) {
+        m_empty_pool_samples += 1;
+    }
+
+    auto window_ms = std::chrono::duration_cast<std::chrono::milliseconds>(clock_t::now() - m_window_start_time).count();
+    if (window_ms < m_interval_ms || perf.event_count < m_window_start_event_count) {
+        return;
+    }
+
+    Measurement measurement;
+    double worker_ms = static_cast<double>(window_ms) * perf.thread_count;
+    measurement.thread_count = perf.thread_count;
+    measurement.max_inflight_events = perf.max_inflight_events;
+    measurement.throughput_hz = (perf.event_count - m_window_start_event_count) * 1000.0 / window_ms;
+    measurement.scheduler_fraction = (perf.scheduler_time_ms - m_window_start_scheduler_ms) / worker_ms;
+    measurement.empty_pool_fraction = static_cast<double>(m_empty_pool_samples) / m_sample_count;
+
+    // Idle time only gets accounted for when a worker wakes up, so a worker that sleeps through the whole
+    // window won't show up in idle_time_ms. Sampling the number of idle workers catches those.
+    double idle_from_durations = (perf.idle_time_ms - m_window_start_idle_ms) / worker_ms;
+    double idle_from_samples = static_cast<double>(m_idle_worker_samples) / (m_sample_count * perf.thread_count);
+    measurement.idle_fraction = std::max(idle_from_durations, idle_from_samples);
+
+    auto decision = Decide(measurement);
+
+    LOG_DEBUG(GetLogger()) << "Autoscaler: throughput=" << measurement.throughput_hz << " Hz, idle="
+                           << 100 * measurement.idle_fraction << "%, scheduler=" << 100 * measurement.scheduler_fraction
+                           << "%, empty pool=" << 100 * measurement.empty_pool_fraction << "%: " << decision.reason << LOG_END;
+
+    if (decision.thread_count != measurement.thread_count || decision.max_inflight_events != measurement.max_inflight_events) {
+        LOG_INFO(GetLogger()) << "Autoscaler: " << decision.reason << ". Scaling from "
+                              << measurement.thread_count << " to " << decision.thread_count << " threads, "
+                              << measurement.max_inflight_events << " to " << decision.max_inflight_events << " max in-flight events "
+                              << "(throughput=" << measurement.throughput_hz << " Hz, idle=" << 100 * measurement.idle_fraction
+                              << "%, scheduler=" << 100 * measurement.scheduler_fraction << "%)" << LOG_END;
+
+        if (decision.max_inflight_events != measurement.max_inflight_events) {
+            engine.ScaleInflightEvents(decision.max_inflight_events);
+        }
+        if (decision.thread_count != measurement.thread_count) {
+            engine.ScaleWorkers(decision.thread_count);
+        }
+    }
+    // Measure the new configuration from scratch
+    OpenWindow(engine.GetPerf());
+}
+
+
+JAutoscaler::Decision JAutoscaler::Decide(const Measurement& measurement) {
+
+    Decision decision;
+    decision.thread_count = measurement.thread_count;
+    decision.max_inflight_events = measurement.max_inflight_events;
+
+    if (m_cooldown_remaining > 0) {
+        m_cooldown_remaining -= 1;
+        decision.reason = "Cooling down";
+        return decision;
+    }
+
+    // First evaluate the previous step, if there was one
+    if (m_last_step != Step::None) {
+        double gain = (m_baseline_throughput_hz > 0) ? (measurement.throughput_hz - m_baseline_throughput_hz) / m_baseline_throughput_hz : 0;
+        bool undo = false;
+        std::ostringstream oss;
+        if (m_last_step == Step::AddThreads && gain <= m_threshold) {
+            oss << "Adding threads changed throughput by " << 100 * gain << "%, which isn't worth the extra cores";
+            undo = true;
+        }
+        else if (m_last_step == Step::RemoveThreads && gain < -m_threshold) {
+            oss << "Removing threads reduced throughput by " << -100 * gain << "%";
+            undo = true;
+        }
+        // We can't undo growing the pool, so we simply keep it
+        m_last_step = Step::None;
+
+        if (undo) {
+            // Back off for longer each time the same experiment fails, up to 8x
+            m_cooldown_remaining = m_cooldown_windows << std::min(m_undo_streak, 3);
+            m_undo_streak += 1;
+            decision.thread_count = m_baseline_thread_count;
+            decision.reason = oss.str();
+            return decision;
+        }
+        m_undo_streak = 0;
+    }
+
+    // Then decide on the next step
+    m_baseline_throughput_hz = measurement.throughput_hz;
+    m_baseline_thread_count = measurement.thread_count;
+    size_t thread_step = std::max<size_t>(1, measurement.thread_count / 8);
+
+    if (measurement.idle_fraction > m_idle_high) {
+        if (measurement.empty_pool_fraction > 0.5 && measurement.max_inflight_events < m_max_inflight_events) {
+            // Workers are idle because the source has no free events to emit into
+            size_t grown = measurement.max_inflight_events + std::max<size_t>(1, measurement.max_inflight_events / 2);
+            decision.max_inflight_events = std::min(grown, m_max_inflight_events);
+            decision.reason = "Workers are idle while the event pool is empty";
+            m_last_step = Step::GrowPool;
+        }
+        else if (measurement.thread_count > m_min_threads) {
+            decision.thread_count = std::max(m_min_threads, measurement.thread_count - std::min(thread_step, measurement.thread_count));
+            decision.reason = "Workers are idle";
+            m_last_step = Step::RemoveThreads;
+        }
+        else {
+            decision.reason = "Workers are idle, but already at min threads";
+        }
+    }
+    else if (measurement.idle_fraction < m_idle_low && measurement.scheduler_fraction < m_scheduler_high) {
+        if (measurement.thread_count < m_max_threads) {
+            decision.thread_count = std::min(m_max_threads, measurement.thread_count + thread_step);
+            // Each thread needs at least one event to work on, so grow the pool to the new thread count if it is smaller.
+            // Like Step::GrowPool, this never shrinks the pool, and never grows it past jana:autoscale_max_inflight_events.
+            size_t needed_inflight_events = std::min(decision.thread_count, m_max_inflight_events);
+            decision.max_inflight_events = std::max(decision.max_inflight_events, needed_inflight_events);
+            decision.reason = "Workers are saturated";
+            m_last_step = Step::AddThreads;
+        }
+        else {
+            decision.reason = "Workers are saturated, but already at max threads";
+        }
+    }
+    else {
+        decision.reason = "Holding steady";
+    }
+    return decision;
+}
+
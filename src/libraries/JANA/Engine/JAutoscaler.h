@@ -0,0 +1,98 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#pragma once
+
+#include <JANA/JService.h>
+#include <JANA/Engine/JExecutionEngine.h>
+
+#include <chrono>
+#include <string>
+
+// JAutoscaler adjusts the thread count and the number of in-flight events while the topology is running,
+// so that one configuration can run well on shared batch nodes where the number of free cores changes over time.
+// It is disabled by default; enable it with jana:autoscale=true. JApplication only provides it in that case.
+//
+// JExecutionEngine::RunSupervisor() calls Tick() once per ticker interval. Tick() accumulates a measurement
+// window (jana:autoscale_interval_ms) and then calls Decide(), which hill-climbs as follows:
+//
+// - If workers are rarely idle, add threads. Keep going as long as each step improves throughput by more
+//   than jana:autoscale_threshold; otherwise undo the last step.
+// - If workers are often idle because the JEventPool keeps running dry, grow jana:max_inflight_events instead.
+// - If workers are often idle for any other reason, remove threads. Undo the step if throughput drops by more
+//   than jana:autoscale_threshold.
+// - After undoing a step, hold still for jana:autoscale_cooldown windows. Together with the threshold,
+//   this provides hysteresis, so that noisy measurements don't make the thread count oscillate.
+//
+// The event pool is only ever grown, never shrunk, for the same reasons that JEventPool::Scale() doesn't shrink.
+
+class JAutoscaler : public JService {
+
+public:
+    using clock_t = std::chrono::steady_clock;
+
+    struct Measurement {
+        size_t thread_count = 0;
+        size_t max_inflight_events = 0;
+        double throughput_hz = 0;
+        double idle_fraction = 0;       // Fraction of worker time spent waiting for a task
+        double scheduler_fraction = 0;  // Fraction of worker time spent inside the scheduler
+        double empty_pool_fraction = 0; // Fraction of samples where no events were left in the pool
+    };
+
+    struct Decision {
+        size_t thread_count = 0;
+        size_t max_inflight_events = 0;
+        std::string reason;
+    };
+
+#ifndef JANA2_TESTCASE
+private:
+#endif
+    enum class Step { None, AddThreads, RemoveThreads, GrowPool };
+
+    // Parameters
+    size_t m_min_threads = 1;
+    size_t m_max_threads = 1;
+    size_t m_max_inflight_events = 0;
+    int m_interval_ms = 5000;
+    double m_threshold = 0.05;
+    int m_cooldown_windows = 3;
+    double m_idle_low = 0.05;
+    double m_idle_high = 0.2;
+    double m_scheduler_high = 0.2;
+
+    // Hill-climbing state
+    Step m_last_step = Step::None;
+    double m_baseline_throughput_hz = 0;
+    size_t m_baseline_thread_count = 0;
+    int m_cooldown_remaining = 0;
+    int m_undo_streak = 0;
+
+    // Current measurement window
+    bool m_is_window_open = false;
+    clock_t::time_point m_window_start_time;
+    size_t m_window_start_event_count = 0;
+    size_t m_window_start_idle_ms = 0;
+    size_t m_window_start_scheduler_ms = 0;
+    size_t m_sample_count = 0;
+    size_t m_idle_worker_samples = 0;
+    size_t m_empty_pool_samples = 0;
+
+public:
+    JAutoscaler() {
+        SetLoggerName("jana:autoscaler");
+    }
+
+    void Init() override;
+
+    void Tick(JExecutionEngine& engine);
+
+    Decision Decide(const Measurement& measurement);
+
+#ifndef JANA2_TESTCASE
+private:
+#endif
+    void OpenWindow(const JExecutionEngine::Perf& perf);
+};
+
@@ -1,13 +1,18 @@
 
 #include "JExecutionEngine.h"
+#include <JANA/Engine/JAutoscaler.h>
 #include <JANA/Utils/JApplicationInspector.h>
+#include <JANA/Utils/JCallGraphSummary.h>
+#include <JANA/Services/JComponentManager.h>
 #include <JANA/JVersion.h>
 
 #if JANA2_HAVE_PERFETTO
 #include <JANA/Services/JPerfettoService.h>
 #endif
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <cstdio>
 #include <ctime>
@@ -33,12 +38,56 @@ void JExecutionEngine::Init() {
         "Max time (in seconds) JANA will wait for 'initial' events to complete before hard-exiting.");
 
     params->SetDefaultParameter("jana:backoff_interval", m_backoff_ms, 
-        "Max time (in seconds) JANA will wait for 'initial' events to complete before hard-exiting.");
+        "Max time (in ms) JANA will leave an arrow alone after it returns ComeBackLater, e.g. a streaming event source with no data yet. 0 to always retry immediately.")
+        ->SetIsAdvanced(true);
+
+    params->SetDefaultParameter("jana:backoff_initial_us", m_backoff_initial_us,
+        "Initial backoff (in us) after an arrow returns ComeBackLater. Doubles on each consecutive ComeBackLater, up to jana:backoff_interval.")
+        ->SetIsAdvanced(true);
 
     params->SetDefaultParameter("jana:show_ticker", m_show_ticker, "Controls whether the ticker is visible");
 
     params->SetDefaultParameter("jana:ticker_interval", m_ticker_ms, "Controls the ticker interval (in ms)");
 
+    params->SetDefaultParameter("jana:enable_work_stealing", m_enable_work_stealing,
+        "Give each worker its own lock-free deque of ready tasks. Workers hand events directly to the next arrow and steal from each other when idle, bypassing the scheduler mutex where possible.")
+        ->SetIsAdvanced(true);
+
+    params->SetDefaultParameter("jana:autoscale", m_enable_autoscale,
+        "Adjust the number of threads and in-flight events at runtime, based on measured throughput and idle time");
+
+    params->SetDefaultParameter("jana:enable_event_fusion", m_enable_event_fusion,
+        "Let a worker keep following its event downstream (e.g. from a source into a map) instead of returning it to the queue, as long as the next arrow is parallel. Events bound for sequential arrows always go through the queue.")
+        ->SetIsAdvanced(true);
+
+    params->SetDefaultParameter("jana:max_batch_size", m_max_batch_size,
+        "Max number of events a worker may check out of a parallel arrow's queue at once. The actual batch size adapts to each arrow's latency relative to the scheduler overhead. 1 to disable batching.")
+        ->SetIsAdvanced(true);
+    if (m_max_batch_size == 0) {
+        m_max_batch_size = 1;
+    }
+
+    params->SetDefaultParameter("jana:task_deque_capacity", m_task_deque_capacity,
+        "Max number of ready tasks each worker can hold when work stealing is enabled. Excess tasks go through the regular queues.")
+        ->SetIsAdvanced(true);
+
+    std::string scheduler_policy = ToString(m_scheduler_policy);
+    params->SetDefaultParameter("jana:scheduler_policy", scheduler_policy,
+        "Order in which the scheduler looks for ready arrows. 'round_robin': rotate through all arrows. 'drain_first': prefer arrows closest to the sinks, minimizing latency and in-flight events. 'occupancy_weighted': prefer arrows with the fullest input queues.")
+        ->SetIsAdvanced(true);
+    if (scheduler_policy == "round_robin") {
+        m_scheduler_policy = SchedulerPolicy::RoundRobin;
+    }
+    else if (scheduler_policy == "drain_first") {
+        m_scheduler_policy = SchedulerPolicy::DrainFirst;
+    }
+    else if (scheduler_policy == "occupancy_weighted") {
+        m_scheduler_policy = SchedulerPolicy::OccupancyWeighted;
+    }
+    else {
+        throw JException("Invalid value for jana:scheduler_policy: '%s'. Expected one of round_robin, drain_first, occupancy_weighted", scheduler_policy.c_str());
+    }
+
     auto p = params->SetDefaultParameter("jana:status_fname", m_path_to_named_pipe,
         "Filename of named pipe for retrieving instantaneous status info");
 
@@ -60,17 +109,117 @@ void JExecutionEngine::Init() {
     // Not sure how I feel about putting this here yet, but I think it will at least work in both cases it needs to.
     // The reason this works is because JTopologyBuilder::create_topology() has already been called before 
     // JApplication::ProvideService<JExecutionEngine>().
-    for (JArrow* arrow : m_topology->GetArrows()) {
+    auto& arrows = m_topology->GetArrows();
+    m_arrow_states = std::vector<ArrowState>(arrows.size());
 
+    for (size_t arrow_id=0; arrow_id<arrows.size(); ++arrow_id) {
+
+        JArrow* arrow = arrows[arrow_id];
         arrow->Initialize();
 
-        m_arrow_states.emplace_back();
-        auto& arrow_state = m_arrow_states.back();
+        auto& arrow_state = m_arrow_states[arrow_id];
         arrow_state.is_source = arrow->IsSource();
         arrow_state.is_sink = arrow->IsSink();
         arrow_state.is_parallel = arrow->IsParallel();
         arrow_state.next_input = arrow->GetNextPortIndex();
     }
+
+    // Figure out which output ports are allowed to skip their JEventQueue and hand the event directly to the
+    // downstream arrow when work stealing is enabled. This is only safe when the downstream arrow has exactly one
+    // input port (so it doesn't care which port the event arrived on), and when the queue neither establishes nor
+    // enforces an event ordering.
+    std::map<JEventQueue*, std::pair<int, int>> queue_consumers;
+    for (size_t arrow_id=0; arrow_id<arrows.size(); ++arrow_id) {
+        JArrow* arrow = arrows[arrow_id];
+        size_t input_count = 0;
+        int input_port = -1;
+        for (size_t port_id=0; port_id<arrow->GetPortCount(); ++port_id) {
+            if (arrow->GetPort(port_id).GetDirection() == JArrow::PortDirection::In) {
+                input_count += 1;
+                input_port = port_id;
+            }
+        }
+        JEventQueue* queue = (input_count == 1) ? arrow->GetPort(input_port).GetQueue() : nullptr;
+        if (queue != nullptr && !arrow->IsSource() && !queue->GetEnforcesOrdering() && !queue->GetEstablishesOrdering()) {
+            queue_consumers[queue] = {arrow_id, input_port};
+        }
+    }
+    for (size_t arrow_id=0; arrow_id<arrows.size(); ++arrow_id) {
+        JArrow* arrow = arrows[arrow_id];
+        auto& arrow_state = m_arrow_states[arrow_id];
+        arrow_state.handoff_targets.resize(arrow->GetPortCount(), {-1, -1});
+        for (size_t port_id=0; port_id<arrow->GetPortCount(); ++port_id) {
+            auto& port = arrow->GetPort(port_id);
+            if (port.GetDirection() != JArrow::PortDirection::Out || port.GetQueue() == nullptr) continue;
+            auto it = queue_consumers.find(port.GetQueue());
+            if (it != queue_consumers.end()) {
+                arrow_state.handoff_targets[port_id] = it->second;
+            }
+        }
+    }
+    ComputeSinkDistances();
+    m_event_latency_samples.resize(m_latency_sample_capacity, 0);
+}
+
+void JExecutionEngine::ComputeSinkDistances() {
+
+    // An arrow's sink distance is the number of arrows an event still has to pass through after it, along the
+    // shortest path. Arrows that only output to JEventPools (i.e. sinks, and folders returning parent events)
+    // have distance 0. Note that queues may have several consumers, e.g. the taps in a processor chain.
+
+    auto& arrows = m_topology->GetArrows();
+    std::map<JEventQueue*, std::vector<size_t>> queue_consumers;
+    for (size_t arrow_id=0; arrow_id<arrows.size(); ++arrow_id) {
+        for (size_t port_id=0; port_id<arrows[arrow_id]->GetPortCount(); ++port_id) {
+            auto& port = arrows[arrow_id]->GetPort(port_id);
+            if (port.GetDirection() == JArrow::PortDirection::In && port.GetQueue() != nullptr) {
+                queue_consumers[port.GetQueue()].push_back(arrow_id);
+            }
+        }
+    }
+
+    const size_t unreachable = arrows.size();
+    for (auto& state : m_arrow_states) {
+        state.sink_distance = unreachable;
+    }
+    // Bellman-Ford with unit weights. Topologies are tiny, so this is plenty fast.
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t arrow_id=0; arrow_id<arrows.size(); ++arrow_id) {
+            size_t distance = unreachable;
+            bool has_queue_output = false;
+            for (size_t port_id=0; port_id<arrows[arrow_id]->GetPortCount(); ++port_id) {
+                auto& port = arrows[arrow_id]->GetPort(port_id);
+                if (port.GetDirection() != JArrow::PortDirection::Out || port.GetQueue() == nullptr) continue;
+                has_queue_output = true;
+                for (size_t consumer_id : queue_consumers[port.GetQueue()]) {
+                    distance = std::min(distance, m_arrow_states[consumer_id].sink_distance + 1);
+                }
+            }
+            if (!has_queue_output) {
+                distance = 0;
+            }
+            if (distance < m_arrow_states[arrow_id].sink_distance) {
+                m_arrow_states[arrow_id].sink_distance = distance;
+                changed = true;
+            }
+        }
+    }
+
+    m_drain_first_order.resize(arrows.size());
+    for (size_t arrow_id=0; arrow_id<arrows.size(); ++arrow_id) {
+        m_drain_first_order[arrow_id] = arrow_id;
+    }
+    std::stable_sort(m_drain_first_order.begin(), m_drain_first_order.end(), [this](size_t a, size_t b) {
+        return m_arrow_states[a].sink_distance < m_arrow_states[b].sink_distance;
+    });
+    m_visit_order.resize(arrows.size());
+    m_arrow_occupancy.resize(arrows.size());
+
+    for (size_t arrow_id : m_drain_first_order) {
+        LOG_DEBUG(GetLogger()) << "Arrow " << arrows[arrow_id]->GetName() << " has sink distance " << m_arrow_states[arrow_id].sink_distance << LOG_END;
+    }
 }
 
 void JExecutionEngine::RequestInspector() {
@@ -100,6 +249,7 @@ void JExecutionEngine::RunTopology() {
         if (arrow.status == ArrowState::Status::Paused) {
             arrow.status = ArrowState::Status::Running;
         }
+        arrow.backoff_duration = clock_t::duration::zero();
     }
 
     m_runstatus = RunStatus::Running;
@@ -137,6 +287,9 @@ void JExecutionEngine::ScaleWorkers(size_t nthreads) {
             worker->is_stop_requested = false;
             worker->cpu_id = mapping.get_cpu_id(worker_id);
             worker->location_id = mapping.get_loc_id(worker_id);
+            if (m_enable_work_stealing) {
+                worker->task_deque = std::make_unique<JTaskDeque>(m_task_deque_capacity);
+            }
             worker->thread = new std::thread(&JExecutionEngine::RunWorker, this, Worker{worker_id, &worker->backtrace});
             LOG_DEBUG(GetLogger()) << "Launching worker thread " << worker_id << " on cpu=" << worker->cpu_id << ", location=" << worker->location_id << LOG_END;
             m_worker_states.push_back(std::move(worker));
@@ -192,6 +345,33 @@ void JExecutionEngine::ScaleWorkers(size_t nthreads) {
     }
 }
 
+void JExecutionEngine::ScaleInflightEvents(size_t max_inflight_events) {
+
+    // Grows the PhysicsEvent pool, along with every queue so that none of them can overflow. Queues preserve
+    // their contents while resizing, so this is safe to call while the topology is running. Like
+    // JEventPool::Scale(), this never shrinks anything, since events may still be held by e.g. an unfolder.
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    JEventPool* physics_pool = nullptr;
+    for (JEventPool* pool : m_topology->GetPools()) {
+        if (pool->GetLevel() == JEventLevel::PhysicsEvent) {
+            physics_pool = pool;
+        }
+    }
+    if (physics_pool == nullptr || max_inflight_events <= physics_pool->GetCapacity()) {
+        return;
+    }
+    size_t added_count = max_inflight_events - physics_pool->GetCapacity();
+    LOG_DEBUG(GetLogger()) << "Scaling max inflight events from " << physics_pool->GetCapacity() << " to " << max_inflight_events << LOG_END;
+
+    for (JEventQueue* queue : m_topology->GetQueues()) {
+        queue->Scale(queue->GetCapacity() + added_count);
+    }
+    physics_pool->Scale(max_inflight_events);
+    lock.unlock();
+    m_condvar.notify_all(); // The new events may unblock a source
+}
+
 void JExecutionEngine::PauseTopology() {
     std::unique_lock<std::mutex> lock(m_mutex);
     if (m_runstatus != RunStatus::Running) return;
@@ -229,6 +409,10 @@ void JExecutionEngine::RunSupervisor() {
     }
     size_t last_event_count = 0;
     clock_t::time_point last_measurement_time = clock_t::now();
+    std::shared_ptr<JAutoscaler> autoscaler;
+    if (m_enable_autoscale) {
+        autoscaler = GetApplication()->GetService<JAutoscaler>();
+    }
 
     Perf perf;
     while (true) {
@@ -275,6 +459,10 @@ void JExecutionEngine::RunSupervisor() {
             PauseTopology();
         }
 
+        if (autoscaler != nullptr && m_interrupt_status == InterruptStatus::NoInterruptsSupervised) {
+            autoscaler->Tick(*this);
+        }
+
         if (m_show_ticker) {
             auto next_measurement_time = clock_t::now();
             auto last_measurement_duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(next_measurement_time - last_measurement_time).count();
@@ -304,6 +492,7 @@ bool JExecutionEngine::CheckTimeout() {
     auto now = clock_t::now();
     bool timeout_detected = false;
     for (auto& worker: m_worker_states) {
+        std::lock_guard<std::mutex> heartbeat_lock(worker->heartbeat_mutex);
         auto timeout_s = (worker->is_event_warmed_up) ? m_timeout_s : m_warmup_timeout_s;
         auto duration_s = std::chrono::duration_cast<std::chrono::seconds>(now - worker->last_checkout_time).count();
         if (duration_s > timeout_s && worker->last_arrow_id != static_cast<uint64_t>(-1)) {
@@ -321,6 +510,7 @@ void JExecutionEngine::HandleFailures() {
 
     // First, we log all of the failures we've found
     for (auto& worker: m_worker_states) {
+        std::lock_guard<std::mutex> heartbeat_lock(worker->heartbeat_mutex);
         if (worker->is_timed_out) {
             std::string arrow_name = (worker->last_arrow_id == static_cast<uint64_t>(-1)) ? "(none)" : m_topology->GetArrows()[worker->last_arrow_id]->GetName();
             LOG_FATAL(GetLogger()) << "Timeout in worker thread " << worker->worker_id << " while executing " << arrow_name << " on event #" << worker->last_event_nr << LOG_END;
@@ -360,6 +550,10 @@ void JExecutionEngine::FinishTopology() {
     }
     for (auto* pool: m_topology->GetPools()) {
         pool->Finalize();
+        auto arena_high_water_mark = pool->GetArenaHighWaterMark();
+        if (arena_high_water_mark != 0) {
+            LOG_INFO(GetLogger()) << "Event arena high-water mark for level " << toString(pool->GetLevel()) << ": " << arena_high_water_mark << " bytes" << LOG_END;
+        }
     }
     m_runstatus = RunStatus::Finished;
     LOG_INFO(GetLogger()) << "Finished processing." << LOG_END;
@@ -392,6 +586,37 @@ JExecutionEngine::Perf JExecutionEngine::GetPerf() {
     result.thread_count = m_worker_states.size();
     result.throughput_hz = (result.uptime_ms == 0) ? 0 : (result.event_count * 1000.0) / result.uptime_ms;
     result.event_level = JEventLevel::PhysicsEvent;
+    result.scheduler_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(GetTotalSchedulerDuration()).count();
+    result.idle_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(m_total_idle_duration).count();
+
+    result.max_inflight_events = 0;
+    result.free_event_count = 0;
+    result.queued_event_count = 0;
+    result.idle_worker_count = m_idle_worker_count;
+    for (JEventPool* pool : m_topology->GetPools()) {
+        if (pool->GetLevel() == JEventLevel::PhysicsEvent) {
+            result.max_inflight_events = pool->GetCapacity();
+            for (size_t location=0; location<pool->GetLocationCount(); ++location) {
+                result.free_event_count += pool->GetSize(location);
+            }
+        }
+    }
+    result.stolen_event_count = 0;
+    for (JEventPool* pool : m_topology->GetPools()) {
+        result.stolen_event_count += pool->GetStolenCount();
+    }
+    for (JEventQueue* queue : m_topology->GetQueues()) {
+        for (size_t location=0; location<queue->GetLocationCount(); ++location) {
+            result.queued_event_count += queue->GetSize(location);
+        }
+        result.stolen_event_count += queue->GetStolenCount();
+    }
+
+    // Sorting the samples is comparatively slow, so do it after releasing the lock
+    auto latency_samples = CopyEventLatencySamples_Unsafe();
+    lock.unlock();
+    result.event_latency_p50_ms = GetEventLatencyMs(latency_samples, 0.5);
+    result.event_latency_p99_ms = GetEventLatencyMs(latency_samples, 0.99);
     return result;
 }
 
@@ -404,6 +629,9 @@ JExecutionEngine::Worker JExecutionEngine::RegisterWorker() {
     worker->is_stop_requested = false;
     worker->cpu_id = mapping.get_cpu_id(worker_id);
     worker->location_id = mapping.get_loc_id(worker_id);
+    if (m_enable_work_stealing) {
+        worker->task_deque = std::make_unique<JTaskDeque>(m_task_deque_capacity);
+    }
     worker->thread = nullptr;
     m_worker_states.push_back(std::move(worker));
 
@@ -434,7 +662,7 @@ void JExecutionEngine::RunWorker(Worker worker) {
                 TRACE_EVENT("jana", perfetto::DynamicString{task.arrow->GetName()},
                     "worker_id", (uint64_t)worker.worker_id);
 #endif
-                task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+                FireTask(task);
             }
         }
         LOG_DEBUG(GetLogger()) << "Stopped worker thread " << worker.worker_id << LOG_END;
@@ -460,15 +688,52 @@ void JExecutionEngine::ExchangeTask(Task& task, size_t worker_id, bool nonblocki
     // It's important to start measuring this _before_ acquiring the lock because acquiring the lock
     // may be a big part of the scheduler overhead
 
+    if (task.worker_state != nullptr && task.batch.empty()) {
+        // Try to check the completed task in and the next task out without touching m_mutex
+        if (m_enable_event_fusion && task.arrow != nullptr && FuseWithDownstream(task, *task.worker_state, checkin_time)) {
+            m_lockfree_scheduler_ticks += (clock_t::now() - checkin_time).count();
+            return;
+        }
+        if (m_enable_work_stealing && ExchangeLocalTask(task, *task.worker_state, checkin_time)) {
+            m_lockfree_scheduler_ticks += (clock_t::now() - checkin_time).count();
+            return;
+        }
+    }
+
     std::unique_lock<std::mutex> lock(m_mutex);
     
     auto& worker = *m_worker_states.at(worker_id);
+    task.worker_state = &worker;
 
     if (task.arrow != nullptr) {
         CheckinCompletedTask_Unsafe(task, worker, checkin_time);
     }
 
+    if (!task.awaiting_clear.empty()) {
+        // Clearing a parent can be as expensive as processing it, so don't make every other worker wait on it.
+        // These parents aren't in any pool yet, so nobody else can touch them. Counting this as an active task
+        // keeps the other workers from deciding that the topology has drained in the meantime.
+        m_active_task_count += 1;
+        lock.unlock();
+        for (auto& parent : task.awaiting_clear) {
+            parent.event->ClearIfDeferred();
+        }
+        lock.lock();
+        m_active_task_count -= 1;
+        for (auto& parent : task.awaiting_clear) {
+            parent.pool->Push(parent.event, parent.location);
+        }
+        task.awaiting_clear.clear();
+    }
+
     if (worker.is_stop_requested) {
+        if (worker.task_deque != nullptr) {
+            // Don't strand any tasks in our deque once we are gone
+            JTaskDeque::Task local_task;
+            while (worker.task_deque->Pop(local_task)) {
+                SpillLocalTask_Unsafe(local_task, worker);
+            }
+        }
         return;
     }
 
@@ -477,9 +742,41 @@ void JExecutionEngine::ExchangeTask(Task& task, size_t worker_id, bool nonblocki
     if (nonblocking) { return; }
     auto idle_time_start = clock_t::now();
     m_total_scheduler_duration += (idle_time_start - checkin_time);
+    if (m_max_batch_size > 1) {
+        double scheduler_ns = std::chrono::duration<double, std::nano>(idle_time_start - checkin_time).count();
+        m_avg_scheduler_ns = (m_avg_scheduler_ns == 0) ? scheduler_ns : (0.9 * m_avg_scheduler_ns + 0.1 * scheduler_ns);
+    }
 
+    clock_t::duration subtask_duration = clock_t::duration::zero();
     while (task.arrow == nullptr && !worker.is_stop_requested) {
-        m_condvar.wait(lock);
+        if (!m_subtasks.empty()) {
+            // Help finish an event that is already in flight before going to sleep
+            auto subtask = std::move(m_subtasks.front());
+            m_subtasks.pop_front();
+            lock.unlock();
+            auto subtask_start = clock_t::now();
+            bool was_run = TryRunSubtask(*subtask);
+            auto subtask_finish = clock_t::now();
+            lock.lock();
+            if (was_run) {
+                m_offloaded_subtask_count += 1;
+                subtask_duration += (subtask_finish - subtask_start);
+            }
+            FindNextReadyTask_Unsafe(task, worker);
+            continue;
+        }
+        m_idle_worker_count += 1;
+        if (m_next_visit_time != clock_t::time_point::max() && !m_is_backoff_timer_armed) {
+            // Some arrow is backing off. Somebody has to revisit it once its backoff expires, but the
+            // other idle workers can keep sleeping until this worker finds something for them to do.
+            m_is_backoff_timer_armed = true;
+            m_condvar.wait_until(lock, m_next_visit_time);
+            m_is_backoff_timer_armed = false;
+        }
+        else {
+            m_condvar.wait(lock);
+        }
+        m_idle_worker_count -= 1;
         FindNextReadyTask_Unsafe(task, worker);
     }
     worker.last_checkout_time = clock_t::now();
@@ -490,7 +787,7 @@ void JExecutionEngine::ExchangeTask(Task& task, size_t worker_id, bool nonblocki
     else {
         worker.last_event_nr = 0;
     }
-    m_total_idle_duration += (worker.last_checkout_time - idle_time_start);
+    m_total_idle_duration += (worker.last_checkout_time - idle_time_start) - subtask_duration;
 
     // Notify one worker, who will notify the next, etc, as long as FindNextReadyTaskUnsafe() succeeds.
     // After FindNextReadyTaskUnsafe fails, all threads block until the next returning worker reactivates the
@@ -507,8 +804,7 @@ void JExecutionEngine::CheckinCompletedTask_Unsafe(Task& task, WorkerState& work
 
     ArrowState& arrow_state = m_arrow_states.at(worker.last_arrow_id);
 
-    arrow_state.active_tasks -= 1;
-    arrow_state.total_processing_duration += processing_duration;
+    arrow_state.total_processing_ticks += processing_duration.count();
 
     for (size_t output=0; output<task.output_count; ++output) {
         if (!task.arrow->GetPort(task.outputs[output].second).GetSkipFinishEvent()) {
@@ -516,8 +812,34 @@ void JExecutionEngine::CheckinCompletedTask_Unsafe(Task& task, WorkerState& work
         }
     }
 
+    for (size_t output=0; output<task.output_count; ++output) {
+        auto& port = task.arrow->GetPort(task.outputs[output].second);
+        if (port.GetPool() != nullptr && !port.GetSkipFinishEvent()) {
+            RecordEventLatency_Unsafe(task.outputs[output].first, checkin_time);
+        }
+    }
+
     // Put each output in its correct queue or pool
-    task.arrow->Push(task.outputs, task.output_count, worker.location_id);
+    task.arrow->Push(task.outputs, task.output_count, worker.location_id, &task.awaiting_clear);
+
+    if (!task.batch.empty()) {
+        for (auto& output : task.batch_outputs) {
+            auto& port = task.arrow->GetPort(output.second);
+            if (!port.GetSkipFinishEvent()) {
+                arrow_state.events_processed++;
+                if (port.GetPool() != nullptr) {
+                    RecordEventLatency_Unsafe(output.first, checkin_time);
+                }
+            }
+            JArrow::OutputData outputs {output, {nullptr, 0}};
+            task.arrow->Push(outputs, 1, worker.location_id, &task.awaiting_clear);
+        }
+    }
+    if (arrow_state.is_parallel && m_max_batch_size > 1 && task.input_event != nullptr) {
+        UpdateBatchSize_Unsafe(arrow_state, processing_duration, 1 + task.batch.size());
+    }
+    task.batch.clear();
+    task.batch_outputs.clear();
 
     if (task.status == JArrow::FireResult::Finished) {
         // If this is an eventsource self-terminating (the only thing that returns Status::Finished right now) it will
@@ -539,6 +861,27 @@ void JExecutionEngine::CheckinCompletedTask_Unsafe(Task& task, WorkerState& work
             }
         }
     }
+
+    if (task.status == JArrow::FireResult::ComeBackLater && m_backoff_ms > 0 && !arrow_state.is_data_available) {
+        // The arrow couldn't make progress, e.g. because a streaming source has no data yet. Rather than
+        // letting every idle worker hammer it, leave it alone for exponentially longer intervals.
+        clock_t::duration max_backoff = std::chrono::milliseconds(m_backoff_ms);
+        clock_t::duration backoff = (arrow_state.backoff_duration == clock_t::duration::zero())
+            ? clock_t::duration(std::chrono::microseconds(m_backoff_initial_us))
+            : arrow_state.backoff_duration * 2;
+        arrow_state.backoff_duration = std::min(backoff, max_backoff);
+        arrow_state.backoff_count += 1;
+        task.arrow->SetNextVisitTime(checkin_time + arrow_state.backoff_duration);
+    }
+    else {
+        arrow_state.backoff_duration = clock_t::duration::zero();
+    }
+
+    if (!arrow_state.is_parallel) {
+        arrow_state.is_active = false;
+    }
+    m_active_task_count -= 1;
+
     worker.last_arrow_id = -1;
     worker.last_event_nr = 0;
 
@@ -549,41 +892,176 @@ void JExecutionEngine::CheckinCompletedTask_Unsafe(Task& task, WorkerState& work
 };
 
 
+void JExecutionEngine::ComputeVisitOrder_Unsafe(WorkerState& worker) {
+
+    size_t arrow_count = m_arrow_states.size();
+    switch (m_scheduler_policy) {
+
+        case SchedulerPolicy::RoundRobin:
+            // Each call starts with a different m_next_arrow_id to ensure balanced arrow assignments
+            m_next_arrow_id += 1;
+            m_next_arrow_id %= arrow_count;
+            for (size_t i=0; i<arrow_count; ++i) {
+                m_visit_order[i] = (m_next_arrow_id + i) % arrow_count;
+            }
+            break;
+
+        case SchedulerPolicy::DrainFirst:
+            // Finish the events that are already in flight before pulling new ones from the sources
+            std::copy(m_drain_first_order.begin(), m_drain_first_order.end(), m_visit_order.begin());
+            break;
+
+        case SchedulerPolicy::OccupancyWeighted: {
+            // Relieve the fullest queue first. Ties (e.g. several empty queues) fall back to DrainFirst.
+            auto& arrows = m_topology->GetArrows();
+            for (size_t arrow_id=0; arrow_id<arrow_count; ++arrow_id) {
+                double occupancy = 0;
+                int port_index = arrows[arrow_id]->GetNextPortIndex();
+                if (port_index != -1) {
+                    auto& port = arrows[arrow_id]->GetPort(port_index);
+                    JEventQueue* queue = (port.GetQueue() != nullptr) ? port.GetQueue() : port.GetPool();
+                    if (queue != nullptr && queue->GetCapacity() != 0) {
+                        size_t location = queue->GetEnforcesOrdering() ? 0 : worker.location_id;
+                        occupancy = static_cast<double>(queue->GetSize(location)) / queue->GetCapacity();
+                    }
+                }
+                m_arrow_occupancy[arrow_id] = occupancy;
+            }
+            std::copy(m_drain_first_order.begin(), m_drain_first_order.end(), m_visit_order.begin());
+            std::stable_sort(m_visit_order.begin(), m_visit_order.end(), [this](size_t a, size_t b) {
+                return m_arrow_occupancy[a] > m_arrow_occupancy[b];
+            });
+            break;
+        }
+    }
+}
+
+void JExecutionEngine::RecordEventLatency_Unsafe(JEvent* event, clock_t::time_point finish_time) {
+    auto inflight_since = event->GetInflightSince();
+    if (inflight_since == clock_t::time_point() || m_event_latency_samples.empty()) {
+        // This event wasn't emitted by an event source, e.g. it is a child event returning from an unfolder
+        return;
+    }
+    event->SetInflightSince(clock_t::time_point());
+    m_event_latency_samples[m_event_latency_sample_count % m_event_latency_samples.size()] = (finish_time - inflight_since).count();
+    m_event_latency_sample_count += 1;
+}
+
+std::vector<JExecutionEngine::clock_t::rep> JExecutionEngine::CopyEventLatencySamples_Unsafe() const {
+    size_t sample_count = std::min(m_event_latency_sample_count, m_event_latency_samples.size());
+    return {m_event_latency_samples.begin(), m_event_latency_samples.begin() + sample_count};
+}
+
+double JExecutionEngine::GetEventLatencyMs(std::vector<clock_t::rep>& samples, double percentile) {
+    if (samples.empty()) {
+        return 0;
+    }
+    // Reorders the samples, but any order is still a valid input for the next percentile
+    auto nth = samples.begin() + static_cast<size_t>(percentile * (samples.size() - 1));
+    std::nth_element(samples.begin(), nth, samples.end());
+    return std::chrono::duration<double, std::milli>(clock_t::duration(*nth)).count();
+}
+
+std::shared_ptr<JExecutionEngine::Subtask> JExecutionEngine::SubmitSubtask(std::function<void()> work) {
+    auto subtask = std::make_shared<Subtask>();
+    subtask->work = std::packaged_task<void()>(std::move(work));
+    subtask->result = subtask->work.get_future();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // Subtasks which their submitter already ran itself are dead weight
+    while (!m_subtasks.empty() && m_subtasks.front()->is_claimed) {
+        m_subtasks.pop_front();
+    }
+    m_subtasks.push_back(subtask);
+    m_total_subtask_count += 1;
+    lock.unlock();
+    m_condvar.notify_one();
+    return subtask;
+}
+
+void JExecutionEngine::WaitForSubtask(Subtask& subtask) {
+    // If no idle worker has picked it up yet, run it ourselves rather than blocking.
+    // This way we never wait on a subtask that hasn't started, so the submitter can't deadlock.
+    if (!TryRunSubtask(subtask)) {
+        subtask.result.wait();
+    }
+}
+
+bool JExecutionEngine::TryRunSubtask(Subtask& subtask) {
+    bool was_claimed = false;
+    if (!subtask.is_claimed.compare_exchange_strong(was_claimed, true)) {
+        return false;
+    }
+    subtask.work(); // Exceptions end up in subtask.result
+    return true;
+}
+
+void JExecutionEngine::UpdateNextVisitTime_Unsafe(clock_t::time_point now) {
+
+    // Recomputed over every backed-off arrow, rather than as a side effect of the scan in FindNextReadyTask_Unsafe(),
+    // because the scan stops as soon as it finds a task and would forget about the arrows it never reached
+    m_next_visit_time = clock_t::time_point::max();
+    for (size_t arrow_id=0; arrow_id<m_arrow_states.size(); ++arrow_id) {
+        auto& state = m_arrow_states[arrow_id];
+        if (state.status == ArrowState::Status::Running && state.backoff_duration != clock_t::duration::zero()) {
+            auto next_visit_time = m_topology->GetArrows()[arrow_id]->GetNextVisitTime();
+            if (now < next_visit_time) {
+                m_next_visit_time = std::min(m_next_visit_time, next_visit_time);
+            }
+        }
+    }
+}
+
 void JExecutionEngine::FindNextReadyTask_Unsafe(Task& task, WorkerState& worker) {
 
+    UpdateNextVisitTime_Unsafe(clock_t::now());
+
+    if (m_enable_work_stealing && FindNextLocalTask_Unsafe(task, worker)) {
+        // Tasks that have already been handed off take priority over new tasks from the queues.
+        // Note that we check this even when Pausing, so that leftover tasks get spilled back into their queues.
+        return;
+    }
+
     if (m_runstatus == RunStatus::Running || m_runstatus == RunStatus::Draining) {
         // We only pick up a new task if the topology is running or draining.
 
-        // Each call to FindNextReadyTask_Unsafe() starts with a different m_next_arrow_id to ensure balanced arrow assignments
-        size_t arrow_count = m_arrow_states.size();
-        m_next_arrow_id += 1;
-        m_next_arrow_id %= arrow_count;
+        auto now = clock_t::now();
+        ComputeVisitOrder_Unsafe(worker);
 
-        for (size_t i=m_next_arrow_id; i<(m_next_arrow_id+arrow_count); ++i) {
-            size_t arrow_id = i % arrow_count;
+        for (size_t arrow_id : m_visit_order) {
 
             auto& state = m_arrow_states[arrow_id];
-            if (!state.is_parallel && (state.active_tasks != 0)) {
-                // We've found a sequential arrow that is already active. Nothing we can do here.
-                LOG_TRACE(GetLogger()) << "Scheduler: Arrow with id " << arrow_id << " is unready: Sequential and already active." << LOG_END;
+            if (state.status != ArrowState::Status::Running) {
+                LOG_TRACE(GetLogger()) << "Scheduler: Arrow with id " << arrow_id << " is unready: Arrow is either paused or finished." << LOG_END;
                 continue;
             }
 
-            if (state.status != ArrowState::Status::Running) {
-                LOG_TRACE(GetLogger()) << "Scheduler: Arrow with id " << arrow_id << " is unready: Arrow is either paused or finished." << LOG_END;
+            JArrow* arrow = m_topology->GetArrows()[arrow_id];
+            if (state.backoff_duration != clock_t::duration::zero()) {
+                auto next_visit_time = arrow->GetNextVisitTime();
+                if (now < next_visit_time) {
+                    LOG_TRACE(GetLogger()) << "Scheduler: Arrow with id " << arrow_id << " is unready: Backing off." << LOG_END;
+                    continue;
+                }
+            }
+
+            bool was_active = false;
+            if (!state.is_parallel && !state.is_active.compare_exchange_strong(was_active, true)) {
+                // We've found a sequential arrow that is already active. Nothing we can do here.
+                // This is a CAS rather than a plain check because work-stealing workers may claim the arrow without m_mutex.
+                LOG_TRACE(GetLogger()) << "Scheduler: Arrow with id " << arrow_id << " is unready: Sequential and already active." << LOG_END;
                 continue;
             }
-            // TODO: Support next_visit_time so that we don't hammer blocked event sources
 
             // See if we can obtain an input event (this is silly)
-            JArrow* arrow = m_topology->GetArrows()[arrow_id];
             // TODO: consider setting state.next_input, retrieving via Fire()
             auto port = arrow->GetNextPortIndex();
             JEvent* event = (port == -1) ? nullptr : arrow->Pull(port, worker.location_id);
             if (event != nullptr || port == -1) {
                 LOG_TRACE(GetLogger()) << "Scheduler: Found next ready arrow with id " << arrow_id << LOG_END;
                 // We've found a task that is ready!
-                state.active_tasks += 1;
+                m_active_task_count += 1;
+                state.is_data_available = false;
 
                 task.arrow = arrow;
                 task.input_port = port;
@@ -593,8 +1071,14 @@ void JExecutionEngine::FindNextReadyTask_Unsafe(Task& task, WorkerState& worker)
 
                 worker.last_arrow_id = arrow_id;
                 if (event != nullptr) {
+                    if (state.is_source) {
+                        event->SetInflightSince(now);
+                    }
                     worker.is_event_warmed_up = event->IsWarmedUp();
                     worker.last_event_nr = event->GetEventNumber();
+                    if (state.is_parallel && state.batch_size > 1) {
+                        CheckOutBatch_Unsafe(task, state, worker);
+                    }
                 }
                 else {
                     worker.is_event_warmed_up = true; // Use shorter timeout
@@ -604,6 +1088,9 @@ void JExecutionEngine::FindNextReadyTask_Unsafe(Task& task, WorkerState& worker)
             }
             else {
                 LOG_TRACE(GetLogger()) << "Scheduler: Arrow with id " << arrow_id << " is unready: Input event is needed but not on queue yet." << LOG_END;
+                if (!state.is_parallel) {
+                    state.is_active = false;
+                }
             }
         }
     }
@@ -618,15 +1105,15 @@ void JExecutionEngine::FindNextReadyTask_Unsafe(Task& task, WorkerState& worker)
         // This also leaves a cleaner narrative in the logs. 
 
         bool any_active_source_found = false;
-        bool any_active_task_found = false;
+        bool any_active_task_found = (m_active_task_count != 0);
+        // A source might have been deactivated by RequestPause, Ctrl-C, etc, and might be inactive even though it still has active tasks.
+        // Tasks sitting in a worker's JTaskDeque count as active, so that we never pause while events are still in flight.
         
         LOG_DEBUG(GetLogger()) << "Scheduler: No tasks ready" << LOG_END;
 
         for (size_t arrow_id = 0; arrow_id < m_arrow_states.size(); ++arrow_id) {
             auto& state = m_arrow_states[arrow_id];
             any_active_source_found |= (state.status == ArrowState::Status::Running && state.is_source);
-            any_active_task_found |= (state.active_tasks != 0);
-            // A source might have been deactivated by RequestPause, Ctrl-C, etc, and might be inactive even though it still has active tasks
         }
 
         if (!any_active_source_found && !any_active_task_found) {
@@ -654,6 +1141,287 @@ void JExecutionEngine::FindNextReadyTask_Unsafe(Task& task, WorkerState& worker)
 }
 
 
+void JExecutionEngine::FireTask(Task& task) {
+
+    task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+
+    for (JEvent* input : task.batch) {
+        JArrow::OutputData outputs;
+        size_t output_count = 0;
+        JArrow::FireResult status = JArrow::FireResult::NotRunYet;
+        task.arrow->Fire(input, outputs, output_count, status);
+        for (size_t output=0; output<output_count; ++output) {
+            task.batch_outputs.push_back(outputs[output]);
+        }
+        if (status != JArrow::FireResult::KeepGoing) {
+            task.status = status;
+        }
+    }
+}
+
+
+void JExecutionEngine::CheckOutBatch_Unsafe(Task& task, ArrowState& state, WorkerState& worker) {
+
+    // Take more events from the same queue, so that the cost of this trip through the scheduler is
+    // amortized over the whole batch. However, we leave enough events behind so that every idle worker
+    // still gets its fair share, since batching shouldn't come at the expense of parallelism.
+
+    auto* queue = task.arrow->GetPort(task.input_port).GetQueue();
+    if (queue == nullptr || queue->GetEnforcesOrdering()) {
+        return;
+    }
+    size_t fair_share = 1 + queue->GetSize(worker.location_id) / (m_idle_worker_count + 1);
+    size_t batch_size = std::min(state.batch_size, fair_share);
+
+    while (task.batch.size() + 1 < batch_size) {
+        JEvent* event = task.arrow->Pull(task.input_port, worker.location_id);
+        if (event == nullptr) break;
+        task.batch.push_back(event);
+    }
+    if (!task.batch.empty()) {
+        state.batch_count += 1;
+    }
+}
+
+
+void JExecutionEngine::UpdateBatchSize_Unsafe(ArrowState& state, clock_t::duration processing_duration, size_t event_count) {
+
+    // Pick the smallest batch size that keeps the scheduler overhead, amortized over the batch,
+    // below 10% of the time spent actually firing the arrow. m_avg_scheduler_ns includes the time spent
+    // waiting on m_mutex, so the batch size grows automatically as lock contention increases.
+
+    double latency_ns = std::chrono::duration<double, std::nano>(processing_duration).count() / event_count;
+    state.avg_event_latency_ns = (state.avg_event_latency_ns == 0) ? latency_ns : (0.9 * state.avg_event_latency_ns + 0.1 * latency_ns);
+
+    if (state.avg_event_latency_ns <= 0) {
+        state.batch_size = m_max_batch_size;
+        return;
+    }
+    double ideal_batch_size = std::ceil(m_avg_scheduler_ns / (0.1 * state.avg_event_latency_ns));
+    state.batch_size = std::max<size_t>(1, std::min<double>(ideal_batch_size, m_max_batch_size));
+}
+
+
+// The functions below implement the work-stealing scheduler, enabled via jana:enable_work_stealing.
+// Each worker owns a JTaskDeque of ready (arrow, event) pairs. When a task completes, any outputs whose
+// downstream arrow can accept them directly are pushed onto the worker's own deque instead of the
+// JEventQueue. The worker then pops its next task from its deque, so that an event usually stays with the
+// same worker (and the same caches) for its whole lifetime. Neither step needs m_mutex. When a worker's
+// deque runs dry, it falls back to the regular scheduler, which first steals from its peers (preferring
+// peers at the same location) and then scans the arrows as usual.
+//
+// Sequential arrows may be claimed both from the deques and from the regular scheduler, so their
+// exclusivity is enforced by the atomic ArrowState::is_active flag. If a worker pops a task for a
+// sequential arrow which is already active, or the topology is no longer running, the task gets
+// "spilled" back into the arrow's input queue, where the regular scheduler will find it later.
+//
+// Event fusion (jana:enable_event_fusion) is the degenerate case without any deque: When a task produces
+// exactly one event and the next arrow is parallel, the worker simply keeps going with it.
+
+
+void JExecutionEngine::HandOffOutputs(Task& task, WorkerState& worker) {
+
+    RunStatus runstatus = m_runstatus;
+    if (runstatus != RunStatus::Running && runstatus != RunStatus::Draining) {
+        return;
+    }
+
+    ArrowState& arrow_state = m_arrow_states[worker.last_arrow_id];
+    size_t remaining_count = 0;
+
+    for (size_t output=0; output<task.output_count; ++output) {
+        JEvent* event = task.outputs[output].first;
+        int port = task.outputs[output].second;
+        auto& target = arrow_state.handoff_targets[port];
+
+        if (target.first != -1) {
+            // Count the new task _before_ it becomes visible, so that the topology can't pause while it is in the deque
+            m_active_task_count += 1;
+            if (worker.task_deque->Push({static_cast<size_t>(target.first), target.second, event})) {
+                if (!task.arrow->GetPort(port).GetSkipFinishEvent()) {
+                    arrow_state.events_processed++;
+                }
+                worker.tasks_handed_off.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            // Deque is full. Fall back to the JEventQueue.
+            m_active_task_count -= 1;
+        }
+        task.outputs[remaining_count++] = task.outputs[output];
+    }
+    task.output_count = remaining_count;
+}
+
+
+bool JExecutionEngine::ExchangeLocalTask(Task& task, WorkerState& worker, clock_t::time_point checkin_time) {
+
+    if (task.arrow != nullptr) {
+        HandOffOutputs(task, worker);
+
+        if (task.output_count != 0 || task.status == JArrow::FireResult::Finished || task.status == JArrow::FireResult::ComeBackLater) {
+            // Some outputs have to go to a JEventQueue or JEventPool, or an arrow has finished or needs to back off.
+            // Either way we need m_mutex, so let CheckinCompletedTask_Unsafe() handle the rest.
+            return false;
+        }
+
+        CheckinLocalTask(task, worker, checkin_time);
+    }
+
+    if (worker.is_stop_requested) {
+        return false;
+    }
+
+    JTaskDeque::Task local_task;
+    if (!worker.task_deque->Pop(local_task)) {
+        return false;
+    }
+    if (!TryAcquireLocalTask(local_task, task, worker)) {
+        // Put it back so that FindNextLocalTask_Unsafe() can spill it while holding m_mutex.
+        // This can't fail because we just freed up the slot.
+        worker.task_deque->Push(local_task);
+        return false;
+    }
+
+    if (m_idle_worker_count != 0 && worker.task_deque->GetSize() != 0) {
+        // We have surplus work and somebody is sleeping. Wake them up so that they can steal it.
+        // We briefly take m_mutex so that the notification can't slip in between their check and their wait.
+        { std::lock_guard<std::mutex> lock(m_mutex); }
+        m_condvar.notify_one();
+    }
+    return true;
+}
+
+
+bool JExecutionEngine::FuseWithDownstream(Task& task, WorkerState& worker, clock_t::time_point checkin_time) {
+
+    // Run-to-completion: If the completed task produced exactly one event, and the arrow that consumes it
+    // is parallel, we keep going with the same event on the same worker. This way the event's working set
+    // stays in this core's cache, and we skip a round trip through m_mutex and the JEventQueue. Events bound
+    // for a sequential arrow go back to the queue as usual, even if the arrow happens to be idle, so that
+    // sequential arrows keep being scheduled fairly and in order.
+
+    if (task.output_count != 1 || task.status != JArrow::FireResult::KeepGoing || worker.is_stop_requested) {
+        return false;
+    }
+    ArrowState& arrow_state = m_arrow_states[worker.last_arrow_id];
+    JEvent* event = task.outputs[0].first;
+    int port = task.outputs[0].second;
+    auto& target = arrow_state.handoff_targets[port];
+
+    if (target.first == -1 || !m_arrow_states[target.first].is_parallel || !TryClaimArrow(target.first)) {
+        return false;
+    }
+    if (!task.arrow->GetPort(port).GetSkipFinishEvent()) {
+        arrow_state.events_processed++;
+    }
+    m_active_task_count += 1;
+    task.output_count = 0;
+    CheckinLocalTask(task, worker, checkin_time);
+    StartLocalTask({static_cast<size_t>(target.first), target.second, event}, task, worker);
+    worker.tasks_fused.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+
+bool JExecutionEngine::TryClaimArrow(size_t arrow_id) {
+
+    RunStatus runstatus = m_runstatus;
+    if (runstatus != RunStatus::Running && runstatus != RunStatus::Draining) {
+        return false;
+    }
+    ArrowState& arrow_state = m_arrow_states[arrow_id];
+    bool was_active = false;
+    return arrow_state.is_parallel || arrow_state.is_active.compare_exchange_strong(was_active, true);
+}
+
+
+void JExecutionEngine::CheckinLocalTask(Task& task, WorkerState& worker, clock_t::time_point checkin_time) {
+
+    // Assumes that all of the task's outputs have already been handed off
+    ArrowState& arrow_state = m_arrow_states[worker.last_arrow_id];
+    arrow_state.total_processing_ticks += (checkin_time - worker.last_checkout_time).count();
+    if (!arrow_state.is_parallel) {
+        arrow_state.is_active = false;
+    }
+    m_active_task_count -= 1;
+    {
+        std::lock_guard<std::mutex> heartbeat_lock(worker.heartbeat_mutex);
+        worker.last_arrow_id = -1;
+        worker.last_event_nr = 0;
+    }
+    task.arrow = nullptr;
+    task.input_event = nullptr;
+    task.output_count = 0;
+    task.status = JArrow::FireResult::NotRunYet;
+}
+
+
+bool JExecutionEngine::TryAcquireLocalTask(const JTaskDeque::Task& local_task, Task& task, WorkerState& worker) {
+    if (!TryClaimArrow(local_task.arrow_id)) {
+        return false;
+    }
+    StartLocalTask(local_task, task, worker);
+    return true;
+}
+
+
+void JExecutionEngine::StartLocalTask(const JTaskDeque::Task& local_task, Task& task, WorkerState& worker) {
+
+    task.arrow = m_topology->GetArrows()[local_task.arrow_id];
+    task.input_port = local_task.input_port;
+    task.input_event = local_task.event;
+    task.output_count = 0;
+    task.status = JArrow::FireResult::NotRunYet;
+
+    std::lock_guard<std::mutex> heartbeat_lock(worker.heartbeat_mutex);
+    worker.last_arrow_id = local_task.arrow_id;
+    worker.last_checkout_time = clock_t::now();
+    worker.is_event_warmed_up = local_task.event->IsWarmedUp();
+    worker.last_event_nr = local_task.event->GetEventNumber();
+}
+
+
+bool JExecutionEngine::FindNextLocalTask_Unsafe(Task& task, WorkerState& worker) {
+
+    JTaskDeque::Task local_task;
+
+    // Drain our own deque first. Anything we can't run right now goes back into its queue.
+    while (worker.task_deque->Pop(local_task)) {
+        if (TryAcquireLocalTask(local_task, task, worker)) {
+            return true;
+        }
+        SpillLocalTask_Unsafe(local_task, worker);
+    }
+
+    // Steal from our peers, preferring those at the same location
+    size_t worker_count = m_worker_states.size();
+    for (bool same_location : {true, false}) {
+        for (size_t offset=1; offset<worker_count; ++offset) {
+            auto& victim = *m_worker_states[(worker.worker_id + offset) % worker_count];
+            if (victim.task_deque == nullptr || (victim.location_id == worker.location_id) != same_location) {
+                continue;
+            }
+            if (victim.task_deque->Steal(local_task)) {
+                worker.tasks_stolen += 1;
+                if (TryAcquireLocalTask(local_task, task, worker)) {
+                    return true;
+                }
+                SpillLocalTask_Unsafe(local_task, worker);
+            }
+        }
+    }
+    return false;
+}
+
+
+void JExecutionEngine::SpillLocalTask_Unsafe(const JTaskDeque::Task& local_task, WorkerState& worker) {
+    JArrow* arrow = m_topology->GetArrows()[local_task.arrow_id];
+    arrow->GetPort(local_task.input_port).GetQueue()->Push(local_task.event, worker.location_id);
+    m_active_task_count -= 1;
+    m_total_spill_count += 1;
+}
+
+
 void JExecutionEngine::PrintFinalReport() {
 
     std::unique_lock<std::mutex> lock(m_mutex);
@@ -668,6 +1436,12 @@ void JExecutionEngine::PrintFinalReport() {
     LOG_INFO(GetLogger()) << "  Completed events [count]:    " << event_count << LOG_END;
     LOG_INFO(GetLogger()) << "  Total uptime [s]:            " << std::setprecision(4) << uptime_ms/1000.0 << LOG_END;
     LOG_INFO(GetLogger()) << "  Thread team size [count]:    " << thread_count << LOG_END;
+    LOG_INFO(GetLogger()) << "  Scheduler policy:            " << ToString(m_scheduler_policy) << LOG_END;
+    if (m_event_latency_sample_count != 0) {
+        auto latency_samples = CopyEventLatencySamples_Unsafe();
+        LOG_INFO(GetLogger()) << "  Event latency p50 [ms]:      " << std::setprecision(4) << GetEventLatencyMs(latency_samples, 0.5) << LOG_END;
+        LOG_INFO(GetLogger()) << "  Event latency p99 [ms]:      " << std::setprecision(4) << GetEventLatencyMs(latency_samples, 0.99) << LOG_END;
+    }
     LOG_INFO(GetLogger()) << LOG_END;
     LOG_INFO(GetLogger()) << "  Arrow-level metrics:" << LOG_END;
     LOG_INFO(GetLogger()) << LOG_END;
@@ -677,7 +1451,7 @@ void JExecutionEngine::PrintFinalReport() {
     for (size_t arrow_id=0; arrow_id < m_arrow_states.size(); ++arrow_id) {
         auto* arrow = m_topology->GetArrows()[arrow_id];
         auto& arrow_state = m_arrow_states[arrow_id];
-        auto useful_ms = std::chrono::duration_cast<std::chrono::milliseconds>(arrow_state.total_processing_duration).count();
+        auto useful_ms = std::chrono::duration_cast<std::chrono::milliseconds>(clock_t::duration(arrow_state.total_processing_ticks.load())).count();
         total_useful_ms += useful_ms;
         auto avg_latency = useful_ms*1.0/arrow_state.events_processed;
         auto throughput_bottleneck = 1000.0 / avg_latency;
@@ -690,16 +1464,86 @@ void JExecutionEngine::PrintFinalReport() {
         LOG_INFO(GetLogger()) << "    Events completed:           " << arrow_state.events_processed << LOG_END;
         LOG_INFO(GetLogger()) << "    Avg latency [ms/event]:     " << avg_latency << LOG_END;
         LOG_INFO(GetLogger()) << "    Throughput bottleneck [Hz]: " << throughput_bottleneck << LOG_END;
+        if (arrow->IsParallel() && m_max_batch_size > 1) {
+            LOG_INFO(GetLogger()) << "    Batch size [events]:        " << arrow_state.batch_size << LOG_END;
+            LOG_INFO(GetLogger()) << "    Batched tasks [count]:      " << arrow_state.batch_count << LOG_END;
+        }
         LOG_INFO(GetLogger()) << LOG_END;
     }
 
-    auto total_scheduler_ms = std::chrono::duration_cast<std::chrono::milliseconds>(m_total_scheduler_duration).count();
+    auto total_scheduler_ms = std::chrono::duration_cast<std::chrono::milliseconds>(GetTotalSchedulerDuration()).count();
     auto total_idle_ms = std::chrono::duration_cast<std::chrono::milliseconds>(m_total_idle_duration).count();
 
     LOG_INFO(GetLogger()) << "  Total useful time [s]:     " << std::setprecision(6) << total_useful_ms/1000.0 << LOG_END;
     LOG_INFO(GetLogger()) << "  Total scheduler time [s]:  " << std::setprecision(6) << total_scheduler_ms/1000.0 << LOG_END;
     LOG_INFO(GetLogger()) << "  Total idle time [s]:       " << std::setprecision(6) << total_idle_ms/1000.0 << LOG_END;
 
+    size_t total_backoff_count = 0;
+    for (auto& arrow_state : m_arrow_states) {
+        total_backoff_count += arrow_state.backoff_count;
+    }
+    if (total_backoff_count != 0 || m_total_wakeup_count != 0) {
+        LOG_INFO(GetLogger()) << "  Arrow backoffs [count]:    " << total_backoff_count << LOG_END;
+        LOG_INFO(GetLogger()) << "  Source wakeups [count]:    " << m_total_wakeup_count << LOG_END;
+    }
+
+    if (m_enable_work_stealing) {
+        size_t total_handed_off = 0;
+        size_t total_stolen = 0;
+        for (auto& worker : m_worker_states) {
+            total_handed_off += worker->tasks_handed_off;
+            total_stolen += worker->tasks_stolen;
+        }
+        LOG_INFO(GetLogger()) << "  Tasks handed off [count]:  " << total_handed_off << LOG_END;
+        LOG_INFO(GetLogger()) << "  Tasks stolen [count]:      " << total_stolen << LOG_END;
+        LOG_INFO(GetLogger()) << "  Tasks spilled [count]:     " << m_total_spill_count << LOG_END;
+    }
+    size_t total_pop_count = 0;
+    size_t total_stolen_count = 0;
+    bool is_stealing_enabled = false;
+    for (JEventQueue* queue : m_topology->GetQueues()) {
+        total_pop_count += queue->GetPopCount();
+        total_stolen_count += queue->GetStolenCount();
+        is_stealing_enabled |= queue->GetIsStealingEnabled();
+    }
+    for (JEventPool* pool : m_topology->GetPools()) {
+        total_pop_count += pool->GetPopCount();
+        total_stolen_count += pool->GetStolenCount();
+    }
+    if (is_stealing_enabled) {
+        LOG_INFO(GetLogger()) << "  Events stolen [count]:     " << total_stolen_count << LOG_END;
+        LOG_INFO(GetLogger()) << "  Steal rate [%]:            " << std::setprecision(3)
+                              << ((total_pop_count == 0) ? 0.0 : 100.0 * total_stolen_count / total_pop_count) << LOG_END;
+    }
+    if (m_enable_event_fusion) {
+        size_t total_fused = 0;
+        for (auto& worker : m_worker_states) {
+            total_fused += worker->tasks_fused;
+        }
+        LOG_INFO(GetLogger()) << "  Tasks fused [count]:       " << total_fused << LOG_END;
+    }
+    if (m_total_subtask_count != 0) {
+        LOG_INFO(GetLogger()) << "  Factory subtasks [count]:  " << m_total_subtask_count << LOG_END;
+        LOG_INFO(GetLogger()) << "  Offloaded subtasks [%]:    " << std::setprecision(3)
+                              << 100.0 * m_offloaded_subtask_count / m_total_subtask_count << LOG_END;
+    }
+
+    auto component_manager = GetApplication()->GetService<JComponentManager>();
+    if (component_manager->IsLatencyHistogramsEnabled()) {
+        std::ostringstream oss;
+        component_manager->PrintLatencySummaries(oss);
+        LOG_INFO(GetLogger()) << LOG_END;
+        LOG_INFO(GetLogger()) << "  Component latencies:\n" << oss.str() << LOG_END;
+    }
+
+    auto* call_graph_summary = component_manager->GetCallGraphSummary();
+    if (call_graph_summary != nullptr) {
+        std::ostringstream oss;
+        call_graph_summary->Print(oss);
+        LOG_INFO(GetLogger()) << LOG_END;
+        LOG_INFO(GetLogger()) << "  Call graph summary:\n" << oss.str() << LOG_END;
+    }
+
     LOG_INFO(GetLogger()) << LOG_END;
 
     LOG_INFO(GetLogger()) << "Final report: " << event_count << " events processed at "
@@ -723,6 +1567,10 @@ bool JExecutionEngine::IsTimeoutEnabled() const {
     return m_enable_timeout;
 }
 
+bool JExecutionEngine::IsAutoscaleEnabled() const {
+    return m_enable_autoscale;
+}
+
 JArrow::FireResult JExecutionEngine::Fire(size_t arrow_id, size_t location_id) {
 
     std::unique_lock<std::mutex> lock(m_mutex);
@@ -739,11 +1587,12 @@ JArrow::FireResult JExecutionEngine::Fire(size_t arrow_id, size_t location_id) {
         LOG_WARN(GetLogger()) << "Firing unsuccessful: Arrow status is Finished." << arrow_id << LOG_END;
         return JArrow::FireResult::Finished;
     }
-    if (!arrow_state.is_parallel && arrow_state.active_tasks != 0) {
+    bool was_active = false;
+    if (!arrow_state.is_parallel && !arrow_state.is_active.compare_exchange_strong(was_active, true)) {
         LOG_WARN(GetLogger()) << "Firing unsuccessful: Arrow is sequential and already has an active task." << arrow_id << LOG_END;
         return JArrow::FireResult::NotRunYet;
     }
-    arrow_state.active_tasks += 1;
+    m_active_task_count += 1;
 
     auto port = arrow->GetNextPortIndex();
     JEvent* event = nullptr;
@@ -751,7 +1600,10 @@ JArrow::FireResult JExecutionEngine::Fire(size_t arrow_id, size_t location_id) {
         event = arrow->Pull(port, location_id);
         if (event == nullptr) {
             LOG_WARN(GetLogger()) << "Firing unsuccessful: Arrow needs an input event from port " << port << ", but the queue or pool is empty." << LOG_END;
-            arrow_state.active_tasks -= 1;
+            if (!arrow_state.is_parallel) {
+                arrow_state.is_active = false;
+            }
+            m_active_task_count -= 1;
             return JArrow::FireResult::NotRunYet;
         }
         else {
@@ -781,12 +1633,51 @@ JArrow::FireResult JExecutionEngine::Fire(size_t arrow_id, size_t location_id) {
 
     lock.lock();
     arrow->Push(outputs, output_count, location_id);
-    arrow_state.active_tasks -= 1;
+    if (!arrow_state.is_parallel) {
+        arrow_state.is_active = false;
+    }
+    m_active_task_count -= 1;
     lock.unlock();
     return result;
 }
 
 
+void JExecutionEngine::NotifyDataAvailable() {
+
+    // Called by JEventSource::NotifyDataAvailable(), typically from a thread that JANA doesn't own.
+    // We don't know which arrow the source belongs to, so we cancel the backoff on all source arrows.
+    // Sources are few and sequential, so this is cheap.
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto now = clock_t::now();
+    size_t woken_count = 0;
+    auto& arrows = m_topology->GetArrows();
+    for (size_t arrow_id=0; arrow_id<m_arrow_states.size(); ++arrow_id) {
+        auto& state = m_arrow_states[arrow_id];
+        if (!state.is_source) continue;
+
+        state.is_data_available = true;
+        if (state.backoff_duration != clock_t::duration::zero()) {
+            state.backoff_duration = clock_t::duration::zero();
+            arrows[arrow_id]->SetNextVisitTime(now);
+            woken_count += 1;
+        }
+    }
+    if (woken_count == 0) {
+        // Nobody is backing off, so any idle workers will find the data on their own
+        return;
+    }
+    m_total_wakeup_count += 1;
+    lock.unlock();
+    if (woken_count == 1) {
+        m_condvar.notify_one();
+    }
+    else {
+        m_condvar.notify_all();
+    }
+}
+
+
 void JExecutionEngine::HandleSIGINT() {
     InterruptStatus status = m_interrupt_status;
     std::cout << std::endl;
@@ -829,6 +1720,7 @@ void JExecutionEngine::PrintWorkerReport(bool send_to_pipe) {
     std::ostringstream oss;
     oss << "Worker report" << std::endl;
     for (auto& worker: m_worker_states) {
+        std::lock_guard<std::mutex> heartbeat_lock(worker->heartbeat_mutex);
         oss << "------------------------------" << std::endl 
             << "  Worker:        " << worker->worker_id << std::endl
             << "  Current arrow: " << worker->last_arrow_id << std::endl
@@ -855,6 +1747,15 @@ void JExecutionEngine::PrintWorkerReport(bool send_to_pipe) {
 }
 
 
+std::string ToString(JExecutionEngine::SchedulerPolicy policy) {
+    switch(policy) {
+        case JExecutionEngine::SchedulerPolicy::RoundRobin: return "round_robin";
+        case JExecutionEngine::SchedulerPolicy::DrainFirst: return "drain_first";
+        case JExecutionEngine::SchedulerPolicy::OccupancyWeighted: return "occupancy_weighted";
+        default: return "unknown";
+    }
+}
+
 std::string ToString(JExecutionEngine::RunStatus runstatus) {
     switch(runstatus) {
         case JExecutionEngine::RunStatus::Running: return "Running";
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <JANA/JService.h>
+#include <JANA/Engine/JTaskDeque.h>
 #include <JANA/Topology/JArrow.h>
 #include <JANA/Topology/JTopologyBuilder.h>
 #include <JANA/Utils/JBacktrace.h>
@@ -12,7 +13,10 @@
 #include <chrono>
 #include <condition_variable>
 #include <ctime>
+#include <deque>
 #include <exception>
+#include <functional>
+#include <future>
 
 extern thread_local int jana2_worker_id;
 
@@ -23,6 +27,7 @@ public:
 
     enum class RunStatus { Paused, Running, Pausing, Draining, Failed, Finished };
     enum class InterruptStatus { NoInterruptsSupervised, NoInterruptsUnsupervised, InspectRequested, InspectInProgress, PauseAndQuit };
+    enum class SchedulerPolicy { RoundRobin, DrainFirst, OccupancyWeighted };
 
     struct Perf {
         RunStatus runstatus;
@@ -31,6 +36,15 @@ public:
         size_t uptime_ms;
         double throughput_hz;
         JEventLevel event_level;
+        size_t scheduler_time_ms;
+        size_t idle_time_ms;
+        size_t max_inflight_events;
+        size_t free_event_count;   // Events sitting in the JEventPool, i.e. not in flight
+        size_t queued_event_count; // Events waiting in a JEventQueue for an arrow to pick them up
+        size_t idle_worker_count;
+        size_t stolen_event_count; // Events a worker took from a different location's queue or pool (jana:enable_stealing)
+        double event_latency_p50_ms; // Time from a source checking an event out of its pool until the event returns,
+        double event_latency_p99_ms; // over the most recent events
     };
 
     struct Worker {
@@ -38,10 +52,21 @@ public:
         JBacktrace* backtrace;
     };
 
+    // A piece of work belonging to an event that is already in flight, e.g. one of several independent factories
+    // (jana:enable_factory_parallelism). Whoever claims it first runs it: either an idle worker, or the thread which
+    // submitted it once it needs the result.
+    struct Subtask {
+        std::packaged_task<void()> work;
+        std::future<void> result;
+        std::atomic_bool is_claimed {false};
+    };
+
 #ifndef JANA2_TESTCASE
 private:
 #endif
 
+    struct WorkerState;
+
     struct Task {
         JArrow* arrow = nullptr;
         JEvent* input_event = nullptr;
@@ -49,6 +74,10 @@ private:
         JArrow::OutputData outputs;
         size_t output_count = 0;
         JArrow::FireResult status = JArrow::FireResult::NotRunYet;
+        WorkerState* worker_state = nullptr; // Cached so that work stealing can check tasks in and out without m_mutex
+        std::vector<JEvent*> batch; // Additional input events for the same parallel arrow, fired after input_event
+        std::vector<std::pair<JEvent*, int>> batch_outputs; // Outputs from firing each event in `batch`
+        std::vector<JEventPool::AwaitingClear> awaiting_clear; // Parents released at checkin, cleared once m_mutex is released
     };
 
     struct ArrowState {
@@ -58,9 +87,17 @@ private:
         bool is_source = false;
         bool is_sink = false;
         size_t next_input = 0;
-        size_t active_tasks = 0;
-        size_t events_processed;
-        clock_t::duration total_processing_duration;
+        std::atomic_bool is_active {false}; // Only meaningful for sequential arrows
+        std::atomic_size_t events_processed {0};
+        std::atomic<clock_t::rep> total_processing_ticks {0};
+        std::vector<std::pair<int, int>> handoff_targets; // (arrow_id, input_port) for each output port, or (-1,-1) if events must go through the JEventQueue
+        clock_t::duration backoff_duration = clock_t::duration::zero(); // Doubles each time the arrow returns ComeBackLater
+        bool is_data_available = false; // Set by NotifyDataAvailable() so that a task which is already running doesn't back off
+        size_t backoff_count = 0;
+        size_t batch_size = 1; // Max number of events to check out at once. Adapted at runtime for parallel arrows.
+        double avg_event_latency_ns = 0; // Exponential moving average of the time spent firing a single event
+        size_t batch_count = 0;
+        size_t sink_distance = 0; // Number of arrows an event has to pass through after this one before it is finished
     };
 
     struct WorkerState {
@@ -70,12 +107,17 @@ private:
         size_t location_id = 0;
         clock_t::time_point last_checkout_time = clock_t::now();
         std::exception_ptr stored_exception = nullptr;
-        bool is_stop_requested = false;
+        std::atomic_bool is_stop_requested {false};
         bool is_event_warmed_up = false;
         bool is_timed_out = false;
         uint64_t last_event_nr = 0;
         size_t last_arrow_id = 0;
         JBacktrace backtrace;
+        std::unique_ptr<JTaskDeque> task_deque;
+        std::mutex heartbeat_mutex; // Protects last_* fields when they are updated without m_mutex
+        std::atomic_size_t tasks_handed_off {0};
+        std::atomic_size_t tasks_fused {0};
+        size_t tasks_stolen = 0;
     };
 
 
@@ -89,21 +131,37 @@ private:
     bool m_show_ticker = true;
     bool m_enable_timeout = true;
     int m_backoff_ms = 10;
+    int m_backoff_initial_us = 50;
     int m_ticker_ms = 500;
     int m_timeout_s = 8;
     int m_warmup_timeout_s = 30;
     std::string m_path_to_named_pipe = "/tmp/jana_status";
+    bool m_enable_work_stealing = false;
+    bool m_enable_event_fusion = false;
+    bool m_enable_autoscale = false;
+    size_t m_task_deque_capacity = 1024;
+    size_t m_max_batch_size = 1;
+    SchedulerPolicy m_scheduler_policy = SchedulerPolicy::RoundRobin;
+    size_t m_latency_sample_capacity = 4096;
 
     // Concurrency
     std::mutex m_mutex;
     std::condition_variable m_condvar;
     std::vector<std::unique_ptr<WorkerState>> m_worker_states;
     std::vector<ArrowState> m_arrow_states;
-    RunStatus m_runstatus = RunStatus::Paused;
+    std::atomic<RunStatus> m_runstatus {RunStatus::Paused};
+    std::atomic_size_t m_active_task_count {0}; // Tasks which are either executing or waiting in a JTaskDeque
+    std::atomic_size_t m_idle_worker_count {0};
     std::atomic<InterruptStatus> m_interrupt_status { InterruptStatus::NoInterruptsUnsupervised };
     std::atomic_bool m_print_worker_report_requested {false};
     std::atomic_bool m_send_worker_report_requested {false};
     size_t m_next_arrow_id=0;
+    clock_t::time_point m_next_visit_time = clock_t::time_point::max(); // Earliest time any backed-off arrow becomes ready again
+    bool m_is_backoff_timer_armed = false; // Only one idle worker needs to wake up when m_next_visit_time is reached
+    std::vector<size_t> m_drain_first_order; // Arrow ids sorted by sink_distance, computed once in Init()
+    std::vector<size_t> m_visit_order;       // Order in which FindNextReadyTask_Unsafe() visits the arrows. Reused to avoid allocations.
+    std::vector<double> m_arrow_occupancy;   // Scratch space for SchedulerPolicy::OccupancyWeighted
+    std::deque<std::shared_ptr<Subtask>> m_subtasks; // Subtasks which idle workers may pick up
 
     // Metrics
     size_t m_event_count_at_start = 0;
@@ -112,6 +170,14 @@ private:
     clock_t::time_point m_time_at_finish;
     clock_t::duration m_total_idle_duration = clock_t::duration::zero();
     clock_t::duration m_total_scheduler_duration = clock_t::duration::zero();
+    std::atomic<clock_t::rep> m_lockfree_scheduler_ticks {0}; // Scheduler time spent in event fusion and work stealing, which don't take m_mutex
+    size_t m_total_spill_count = 0;
+    size_t m_total_wakeup_count = 0;
+    double m_avg_scheduler_ns = 0; // Exponential moving average of the time a worker spends in ExchangeTask() when not idle
+    std::vector<clock_t::rep> m_event_latency_samples; // Ringbuffer of end-to-end event latencies
+    size_t m_event_latency_sample_count = 0;
+    size_t m_total_subtask_count = 0;
+    size_t m_offloaded_subtask_count = 0; // Subtasks which were run by an idle worker rather than by the thread that submitted them
 
 
 public:
@@ -133,11 +199,16 @@ public:
     void FinishTopology();
 
     void ScaleWorkers(size_t nthreads);
+    void ScaleInflightEvents(size_t max_inflight_events);
     Worker RegisterWorker();
     void RunWorker(Worker);
     void RunSupervisor();
 
     JArrow::FireResult Fire(size_t arrow_id, size_t location_id=0);
+    void NotifyDataAvailable();
+
+    std::shared_ptr<Subtask> SubmitSubtask(std::function<void()> work);
+    void WaitForSubtask(Subtask& subtask);
 
     Perf GetPerf();
     RunStatus GetRunStatus();
@@ -145,6 +216,7 @@ public:
     bool IsTickerEnabled() const;
     void SetTimeoutEnabled(bool timeout_on);
     bool IsTimeoutEnabled() const;
+    bool IsAutoscaleEnabled() const;
     void RequestInspector();
 
     void HandleSIGINT();
@@ -162,11 +234,34 @@ private:
     void HandleFailures();
     void ExchangeTask(Task& task, size_t worker_id, bool nonblocking=false);
     void CheckinCompletedTask_Unsafe(Task& task, WorkerState& worker, clock_t::time_point checkin_time);
+    void UpdateNextVisitTime_Unsafe(clock_t::time_point now);
     void FindNextReadyTask_Unsafe(Task& task, WorkerState& worker);
+    void FireTask(Task& task);
+    void CheckOutBatch_Unsafe(Task& task, ArrowState& state, WorkerState& worker);
+    void UpdateBatchSize_Unsafe(ArrowState& state, clock_t::duration processing_duration, size_t event_count);
+    void ComputeSinkDistances();
+    void ComputeVisitOrder_Unsafe(WorkerState& worker);
+    void RecordEventLatency_Unsafe(JEvent* event, clock_t::time_point finish_time);
+    std::vector<clock_t::rep> CopyEventLatencySamples_Unsafe() const;
+    static double GetEventLatencyMs(std::vector<clock_t::rep>& samples, double percentile);
+    bool TryRunSubtask(Subtask& subtask);
+    clock_t::duration GetTotalSchedulerDuration() const { return m_total_scheduler_duration + clock_t::duration(m_lockfree_scheduler_ticks.load()); }
+
+    // Work stealing and event fusion
+    void HandOffOutputs(Task& task, WorkerState& worker);
+    bool ExchangeLocalTask(Task& task, WorkerState& worker, clock_t::time_point checkin_time);
+    bool FuseWithDownstream(Task& task, WorkerState& worker, clock_t::time_point checkin_time);
+    bool TryClaimArrow(size_t arrow_id);
+    void CheckinLocalTask(Task& task, WorkerState& worker, clock_t::time_point checkin_time);
+    void StartLocalTask(const JTaskDeque::Task& local_task, Task& task, WorkerState& worker);
+    bool TryAcquireLocalTask(const JTaskDeque::Task& local_task, Task& task, WorkerState& worker);
+    bool FindNextLocalTask_Unsafe(Task& task, WorkerState& worker);
+    void SpillLocalTask_Unsafe(const JTaskDeque::Task& local_task, WorkerState& worker);
 
 };
 
 
 std::string ToString(JExecutionEngine::RunStatus status);
+std::string ToString(JExecutionEngine::SchedulerPolicy policy);
 
 
@@ -0,0 +1,126 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#pragma once
+#include <JANA/Utils/JCpuInfo.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+class JEvent;
+
+// JTaskDeque is a bounded Chase-Lev work-stealing deque of ready (arrow, event) pairs, used
+// by JExecutionEngine when jana:enable_work_stealing=true. It has the following features:
+//
+// - Single owner: Only the owning worker may call Push() and Pop(). These operate on the bottom
+//   of the deque, so the owner processes its most recently produced (and hottest) event first.
+// - Multiple thieves: Any thread may call Steal(), which takes the oldest task from the top.
+// - Lock-free: Neither side takes a mutex. The only contended operation is a CAS on `m_top`,
+//   which happens when a thief steals or when the owner pops the very last element.
+// - Fixed-capacity: Push() returns false instead of growing. Callers are expected to fall back
+//   to the regular (mutex-protected) JEventQueue when this happens.
+//
+// The memory ordering follows Lê, Pop, Cohen & Zappa Nardelli, "Correct and Efficient
+// Work-Stealing for Weak Memory Models" (PPoPP 2013). The slot contents are stored as relaxed
+// atomics so that a thief racing with a wrapped-around Push() does not constitute a data race.
+
+class JTaskDeque {
+
+public:
+    struct Task {
+        size_t arrow_id = 0;
+        int input_port = -1;
+        JEvent* event = nullptr;
+    };
+
+private:
+    struct Slot {
+        std::atomic<size_t> arrow_id {0};
+        std::atomic<int> input_port {-1};
+        std::atomic<JEvent*> event {nullptr};
+    };
+
+    alignas(JANA2_CACHE_LINE_BYTES) std::atomic<int64_t> m_top {0};
+    alignas(JANA2_CACHE_LINE_BYTES) std::atomic<int64_t> m_bottom {0};
+    alignas(JANA2_CACHE_LINE_BYTES) std::unique_ptr<Slot[]> m_slots;
+    size_t m_capacity;
+    size_t m_mask;
+
+public:
+    explicit JTaskDeque(size_t min_capacity) {
+        m_capacity = 1;
+        while (m_capacity < min_capacity) m_capacity <<= 1;
+        m_mask = m_capacity - 1;
+        m_slots = std::unique_ptr<Slot[]>(new Slot[m_capacity]);
+    }
+
+    size_t GetCapacity() const { return m_capacity; }
+
+    /// Approximate number of tasks in the deque. Exact when called by the owner with no thieves present.
+    size_t GetSize() const {
+        int64_t b = m_bottom.load(std::memory_order_relaxed);
+        int64_t t = m_top.load(std::memory_order_relaxed);
+        return (b > t) ? static_cast<size_t>(b - t) : 0;
+    }
+
+    /// Owner only. Returns false if the deque is full.
+    bool Push(const Task& task) {
+        int64_t b = m_bottom.load(std::memory_order_relaxed);
+        int64_t t = m_top.load(std::memory_order_acquire);
+        if (b - t >= static_cast<int64_t>(m_capacity)) {
+            return false;
+        }
+        Slot& slot = m_slots[static_cast<size_t>(b) & m_mask];
+        slot.arrow_id.store(task.arrow_id, std::memory_order_relaxed);
+        slot.input_port.store(task.input_port, std::memory_order_relaxed);
+        slot.event.store(task.event, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// Owner only. Takes the most recently pushed task. Returns false if the deque is empty.
+    bool Pop(Task& task) {
+        int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = m_top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            // Deque was already empty
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        Read(b, task);
+        if (t == b) {
+            // Last element: Race against thieves for it
+            bool won = m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /// Any thread. Takes the oldest task. Returns false if the deque is empty or if another thread won the race.
+    bool Steal(Task& task) {
+        int64_t t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = m_bottom.load(std::memory_order_acquire);
+        if (t >= b) {
+            return false;
+        }
+        Read(t, task);
+        return m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+private:
+    void Read(int64_t index, Task& task) {
+        Slot& slot = m_slots[static_cast<size_t>(index) & m_mask];
+        task.arrow_id = slot.arrow_id.load(std::memory_order_relaxed);
+        task.input_port = slot.input_port.load(std::memory_order_relaxed);
+        task.event = slot.event.load(std::memory_order_relaxed);
+    }
+};
+
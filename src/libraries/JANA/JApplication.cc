@@ -5,10 +5,12 @@
 #include <JANA/JApplication.h>
 #include <JANA/JEventSource.h>
 #include <JANA/Engine/JExecutionEngine.h>
+#include <JANA/Engine/JAutoscaler.h>
 #include <JANA/Services/JComponentManager.h>
 #include <JANA/Services/JGlobalRootLock.h>
 #include <JANA/Services/JParameterManager.h>
 #include <JANA/Services/JPluginLoader.h>
+#include <JANA/Services/JRunCache.h>
 #include <JANA/Topology/JTopologyBuilder.h>
 #include <JANA/Services/JWiringService.h>
 #include <JANA/Utils/JCpuInfo.h>
@@ -41,6 +43,7 @@ JApplication::JApplication(JParameterManager* params) {
     m_plugin_loader = std::make_shared<JPluginLoader>();
     m_service_locator = std::make_unique<JServiceLocator>();
     m_execution_engine = std::make_unique<JExecutionEngine>();
+    m_component_manager->SetSubtaskEngine(m_execution_engine.get());
 
     ProvideService(m_params);
     ProvideService(m_component_manager);
@@ -48,6 +51,7 @@ JApplication::JApplication(JParameterManager* params) {
     ProvideService(m_execution_engine);
     ProvideService(std::make_shared<JGlobalRootLock>());
     ProvideService(std::make_shared<JTopologyBuilder>());
+    ProvideService(std::make_shared<JRunCache>());
     ProvideService(std::make_shared<jana::services::JWiringService>());
 
 }
@@ -166,6 +170,10 @@ void JApplication::Initialize() {
     m_params->SetDefaultParameter("jana:inspect", m_inspect, "Controls whether to drop immediately into the Inspector upon Run()");
 
     auto execution_engine = m_service_locator->get<JExecutionEngine>();
+    if (execution_engine->IsAutoscaleEnabled()) {
+        // Only registered when it is wanted, so that its parameters don't show up otherwise
+        ProvideService(std::make_shared<JAutoscaler>());
+    }
 
     // Make sure that Init() is called on any remaining JServices
     m_service_locator->InitAllServices();
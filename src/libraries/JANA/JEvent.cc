@@ -144,6 +144,21 @@ std::vector<JEvent*> JEvent::ReleaseAllParents() {
     return released_parents;
 }
 
+/// Lets an arrow hold onto a parent the same way its children do, e.g. while it is still being unfolded, so that
+/// the parent can't be considered finished before all of its children exist. ReleaseReference() returns true if
+/// that was the last reference.
+void JEvent::AddReference() {
+    mReferenceCount.fetch_add(1);
+}
+
+bool JEvent::ReleaseReference() {
+    auto remaining_refs = mReferenceCount.fetch_sub(1);
+    if (remaining_refs < 1) {
+        throw JException("Refcount has gone negative!");
+    }
+    return remaining_refs == 1;
+}
+
 int JEvent::GetChildCount() {
     return mReferenceCount;
 }
@@ -155,9 +170,25 @@ void JEvent::Clear(bool processed_successfully) {
     }
     mFactorySet.Clear();
     mInspector.Reset();
+    mCallGraph.FlushSummary();
     mCallGraph.Reset();
 }
 
+/// Used instead of Clear() when an event goes back to its pool while children still reference it, so that they can
+/// keep reading from its databundles, e.g. through views that an unfolder created. JEventPool calls ClearIfDeferred()
+/// once the last child has been released.
+void JEvent::DeferClear(bool processed_successfully) {
+    mIsClearDeferred = true;
+    mDeferredClearSucceeded = processed_successfully;
+}
+
+void JEvent::ClearIfDeferred() {
+    if (mIsClearDeferred) {
+        mIsClearDeferred = false;
+        Clear(mDeferredClearSucceeded);
+    }
+}
+
 void JEvent::Finish() {
     mFactorySet.Finish();
 }
@@ -24,6 +24,7 @@
 #include <JANA/Utils/JInspector.h>
 
 #include <typeindex>
+#include <chrono>
 #include <cstdint>
 #include <vector>
 #include <memory>
@@ -48,12 +49,16 @@ private:
     std::map<std::string, std::string> mDefaultTags;
     JEventSource* mEventSource = nullptr;
     bool mIsBarrierEvent = false;
+    uint64_t mEpoch = 0;
     bool mIsWarmedUp = false;
 
     // Hierarchical event memory management
     std::vector<std::pair<JEventLevel, std::pair<JEvent*, uint64_t>>> mParents;
     std::atomic_int mReferenceCount {0};
+    bool mIsClearDeferred = false;
+    bool mDeferredClearSucceeded = false;
     int64_t mEventIndex = -1;
+    std::chrono::steady_clock::time_point mInflightSince; // Set by JExecutionEngine when an event source checks this event out of its JEventPool
 
     void MakeEventStamp() const;
 
@@ -68,6 +73,7 @@ public:
     void SetJEventSource(JEventSource* aSource){mEventSource = aSource;}
     void SetDefaultTags(std::map<std::string, std::string> aDefaultTags){mDefaultTags=aDefaultTags; mUseDefaultTags = !mDefaultTags.empty();}
     void SetSequential(bool isSequential) {mIsBarrierEvent = isSequential;}
+    void SetEpoch(uint64_t epoch) {mEpoch = epoch;}
 
     JFactorySet* GetFactorySet() const { return &mFactorySet; }
     int32_t GetRunNumber() const {return mRunNumber;}
@@ -78,6 +84,9 @@ public:
     JInspector* GetJInspector() const {return &mInspector;}
     void Inspect() const { mInspector.Loop();}
     bool GetSequential() const {return mIsBarrierEvent;}
+    /// The number of barrier events (or, for a multilevel source, parent events) that this event's source emitted
+    /// up to and including this event. Events of the same epoch all saw the same barrier as their latest one.
+    uint64_t GetEpoch() const {return mEpoch;}
     bool IsWarmedUp() { return mIsWarmedUp; }
 
     // Hierarchical
@@ -85,6 +94,8 @@ public:
     void SetLevel(JEventLevel level) { mFactorySet.SetLevel(level); }
     void SetEventIndex(int event_index) { mEventIndex = event_index; }
     int64_t GetEventIndex() const { return mEventIndex; }
+    void SetInflightSince(std::chrono::steady_clock::time_point t) { mInflightSince = t; }
+    std::chrono::steady_clock::time_point GetInflightSince() const { return mInflightSince; }
     const std::string& GetEventStamp() const;
 
     bool HasParent(JEventLevel level) const;
@@ -92,12 +103,17 @@ public:
     void SetParent(JEvent* parent);
     JEvent* ReleaseParent(JEventLevel level);
     std::vector<JEvent*> ReleaseAllParents();
+    void AddReference();
+    bool ReleaseReference();
     int GetChildCount();
     uint64_t GetParentNumber(JEventLevel level) const;
     void SetParentNumber(JEventLevel level, uint64_t number);
 
     // Lifecycle
     void Clear(bool processed_successfully=true);
+    void DeferClear(bool processed_successfully=true);
+    void ClearIfDeferred();
+    bool IsClearDeferred() const { return mIsClearDeferred; }
     void Finish();
 
     JFactory* GetFactory(const std::string& object_name, const std::string& tag) const;
@@ -144,12 +160,12 @@ public:
 template<class T>
 inline JFactoryT<T>* JEvent::GetFactory(const std::string& tag, bool throw_on_missing) const
 {
-    std::string resolved_tag = tag;
+    const std::string* resolved_tag = &tag; // Avoid copying the tag on the hot path
     if (mUseDefaultTags && tag.empty()) {
         auto defaultTag = mDefaultTags.find(JTypeInfo::demangle<T>());
-        if (defaultTag != mDefaultTags.end()) resolved_tag = defaultTag->second;
+        if (defaultTag != mDefaultTags.end()) resolved_tag = &defaultTag->second;
     }
-    auto* databundle = mFactorySet.GetDatabundle(std::type_index(typeid(T)), resolved_tag);
+    auto* databundle = mFactorySet.GetDatabundle(std::type_index(typeid(T)), *resolved_tag);
     if (databundle == nullptr) {
         if (throw_on_missing) {
             JException ex("Could not find databundle with type_index=" + JTypeInfo::demangle<T>() + " and tag=" + tag);
@@ -184,12 +200,12 @@ inline JFactoryT<T>* JEvent::GetFactory(const std::string& tag, bool throw_on_mi
 
 template<class T>
 JLightweightDatabundleT<T>* JEvent::GetLightweightDatabundle(const std::string& tag, bool throw_on_missing, bool call_factory_create) const {
-    std::string resolved_tag = tag;
+    const std::string* resolved_tag = &tag; // Avoid copying the tag on the hot path
     if (mUseDefaultTags && tag.empty()) {
         auto defaultTag = mDefaultTags.find(JTypeInfo::demangle<T>());
-        if (defaultTag != mDefaultTags.end()) resolved_tag = defaultTag->second;
+        if (defaultTag != mDefaultTags.end()) resolved_tag = &defaultTag->second;
     }
-    auto* databundle = mFactorySet.GetDatabundle(std::type_index(typeid(T)), resolved_tag);
+    auto* databundle = mFactorySet.GetDatabundle(std::type_index(typeid(T)), *resolved_tag);
     if (databundle == nullptr) {
         if (throw_on_missing) {
             JException ex("Could not find databundle with type_index=" + JTypeInfo::demangle<T>() + " and tag=" + tag);
@@ -19,6 +19,7 @@ private:
     int32_t m_last_run_number = -1;
     JEventLevel m_child_level;
     bool m_call_preprocess_upstream = true;
+    bool m_enable_commutative_fold = false;
 
 
 public:
@@ -43,7 +44,15 @@ public:
     void SetChildLevel(JEventLevel level) { m_child_level = level; }
 
     void SetCallPreprocessUpstream(bool call_upstream) { m_call_preprocess_upstream = call_upstream; }
-    
+
+    /// Declares that Fold() produces the same parent no matter which order the children arrive in, e.g. because
+    /// it only sums or histograms them. Children are then folded as soon as they finish, instead of waiting in an
+    /// ordered queue behind the slowest child of the parent. The parent is still only released once every one of its
+    /// children has been folded. Because the children aren't put back in order, Fold() shouldn't rely on item_nr.
+    void EnableCommutativeFold(bool enable=true) { m_enable_commutative_fold = enable; }
+
+    bool IsCommutativeFoldEnabled() const { return m_enable_commutative_fold; }
+
     JEventLevel GetChildLevel() { return m_child_level; }
 
 
@@ -56,6 +65,7 @@ public:
                 throw JException("JEventFolder: Component needs to be initialized and not finalized before Fold can be called");
             }
         }
+        CreateInputsConcurrently(child);
         for (auto* input : m_inputs) {
             input->TriggerFactoryCreate(child);
         }
@@ -37,12 +37,18 @@ public:
 
     void EnableOrdering(bool enable=true) { m_enable_ordering = enable; }
 
+    /// With jana:latency_histograms, ProcessParallel() is recorded under "ProcessParallel", apart from ProcessSequential()
+    void SetParallelLatencyHistogram(JLatencyHistogram* histogram) { m_parallel_latency_histogram = histogram; }
+
+    JLatencyHistogram* GetParallelLatencyHistogram() const { return m_parallel_latency_histogram; }
+
 
     virtual void DoMap(const JEvent& event) {
 
         if (m_callback_style == CallbackStyle::LegacyMode) {
             throw JException("Called DoMap() on a legacy-mode JEventProcessor");
         }
+        CreateInputsConcurrently(event);
         for (auto* input : m_inputs) {
             input->TriggerFactoryCreate(event);
         }
@@ -198,6 +204,7 @@ private:
     bool m_enable_ordering = false;
     std::string m_resource_name;
     std::atomic_ullong m_event_count {0};
+    JLatencyHistogram* m_parallel_latency_histogram = nullptr; // Shared by all processors with the same type name and prefix
 
 };
 
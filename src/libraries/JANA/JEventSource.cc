@@ -1,4 +1,6 @@
 #include <JANA/JEventSource.h>
+#include <JANA/JApplication.h>
+#include <JANA/Engine/JExecutionEngine.h>
 
 void JEventSource::DoOpen(bool with_lock) {
     if (with_lock) {
@@ -196,6 +198,14 @@ void JEventSource::DoFinishEvent(JEvent& event) {
     }
 }
 
+void JEventSource::NotifyDataAvailable() {
+    if (m_app == nullptr || !m_app->IsInitialized()) {
+        // Nobody is polling us yet, so there is nobody to wake up
+        return;
+    }
+    m_app->GetService<JExecutionEngine>()->NotifyDataAvailable();
+}
+
 void JEventSource::Summarize(JComponentSummary& summary) const {
 
     auto* result = new JComponentSummary::Component(
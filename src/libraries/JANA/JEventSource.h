@@ -71,7 +71,8 @@ public:
     // Exceptions are reserved for unrecoverable errors. It accepts an out parameter JEvent. If there is another 
     // entry in the file, or another message waiting at the socket, the user reads the data into the JEvent and returns
     // Result::Success, at which point JANA pushes the JEvent onto the downstream queue. If there is no data waiting yet,
-    // the user returns Result::FailureTryAgain, at which point JANA recycles the JEvent to the pool. If there is no more
+    // the user returns Result::FailureTryAgain, at which point JANA recycles the JEvent to the pool and backs off for a
+    // while (see jana:backoff_interval) before calling Emit() again. If there is no more
     // data, the user returns Result::FailureFinished, at which point JANA recycles the JEvent to the pool and calls Close().
 
     virtual Result Emit(JEvent&) { return Result::Success; };
@@ -185,6 +186,12 @@ public:
     JEventLevel GetNextInputLevel() const { return m_next_level; }
 
 
+    /// NotifyDataAvailable() tells JANA that a source which previously returned Result::FailureTryAgain now has data,
+    /// so that JANA calls Emit() right away instead of waiting out its backoff interval. This is intended for sources
+    /// which are fed by a thread that JANA doesn't own, e.g. a DAQ receiver thread, and is safe to call from any thread.
+    void NotifyDataAvailable();
+
+
     // Internal
 
     void DoOpen(bool with_lock=true);
@@ -21,6 +21,7 @@ private:
     JEventLevel m_child_level;
     int m_child_number = 0;
     bool m_call_preprocess_upstream = true;
+    bool m_enable_parallel_unfold = false;
 
 
 public:
@@ -54,6 +55,17 @@ public:
     void SetChildLevel(JEventLevel level) { m_child_level = level; }
 
     void SetCallPreprocessUpstream(bool call_upstream) { m_call_preprocess_upstream = call_upstream; }
+
+    /// Lets JANA unfold several parents at once on different threads. Each parent is still unfolded one child at
+    /// a time, and the children are still emitted in the same order as sequential unfolding would produce. In exchange,
+    /// Unfold() must be safe to call concurrently for different parents, which means it can't keep any per-parent
+    /// state in member variables. It also can't use Input or Output members, because those are shared by all calls;
+    /// read from the parent and insert into the child directly instead. JTopologyBuilder rejects unfolders which have
+    /// any. In particular, this rules out Output<T>::EnableParentView(), so children of a parallel unfolder have to
+    /// hold copies of the parent's data, or read it through JEvent::GetParent().
+    void EnableParallelUnfold(bool enable=true) { m_enable_parallel_unfold = enable; }
+
+    bool IsParallelUnfoldEnabled() const { return m_enable_parallel_unfold; }
     
     JEventLevel GetChildLevel() { return m_child_level; }
 
@@ -68,6 +80,7 @@ public:
                 throw JException("JEventUnfolder: Component needs to be initialized and not finalized before Unfold can be called");
             }
         }
+        CreateInputsConcurrently(parent);
         for (auto* input : m_inputs) {
             input->TriggerFactoryCreate(parent);
         }
@@ -141,6 +154,53 @@ public:
         }
     }
 
+    /// Throws unless this unfolder can be used with EnableParallelUnfold(). Called by JTopologyBuilder.
+    void CheckParallelUnfold() {
+        if (!m_inputs.empty() || !m_variadic_inputs.empty() || !GetOutputs().empty() || !GetVariadicOutputs().empty()) {
+            throw JException("JEventUnfolder '%s': Parallel unfolding doesn't support Input or Output members. Use parent.Get() and child.Insert() instead.", GetTypeName().c_str());
+        }
+    }
+
+    /// Backend for EnableParallelUnfold(), called once for each parent before any of its children get unfolded.
+    /// Checks for a run change, which is the only part that needs the lock.
+    void DoParallelOpenParent(const JEvent& parent) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_is_initialized) {
+            throw JException("Component needs to be initialized and not finalized before Unfold can be called");
+        }
+        if (m_last_run_number != parent.GetRunNumber()) {
+            for (auto* resource : m_resources) {
+                resource->ChangeRun(parent.GetRunNumber(), m_app);
+            }
+            CallWithJExceptionWrapper("JEventUnfolder::ChangeRun", [&](){
+                ChangeRun(parent);
+            });
+            m_last_run_number = parent.GetRunNumber();
+        }
+    }
+
+    /// Backend for EnableParallelUnfold(). Unlike DoUnfold(), the caller keeps track of item_nr, and no lock is held,
+    /// so that Unfold() can run concurrently for different parents. DoParallelOpenParent() has to be called first.
+    Result DoParallelUnfold(const JEvent& parent, JEvent& child, int item_nr) {
+        if (!m_call_preprocess_upstream && !m_enable_simplified_callbacks) {
+            CallWithJExceptionWrapper("JEventUnfolder::Preprocess", [&](){
+                Preprocess(parent);
+            });
+        }
+        Result result;
+        if (m_enable_simplified_callbacks) {
+            CallWithJExceptionWrapper("JEventUnfolder::Unfold", [&](){
+                result = Unfold(parent.GetEventNumber(), child.GetEventNumber(), item_nr);
+            });
+        }
+        else {
+            CallWithJExceptionWrapper("JEventUnfolder::Unfold", [&](){
+                result = Unfold(parent, child, item_nr);
+            });
+        }
+        return result;
+    }
+
     void DoFinish() {
         std::lock_guard<std::mutex> lock(m_mutex);
         if (!m_is_finalized) {
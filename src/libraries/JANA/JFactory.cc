@@ -8,6 +8,8 @@
 #include <JANA/JEvent.h>
 #include <JANA/JEventSource.h>
 #include <JANA/Utils/JTypeInfo.h>
+#include <JANA/Utils/JLatencyHistogram.h>
+#include <JANA/Engine/JExecutionEngine.h>
 #include <JANA/JVersion.h>
 
 #if JANA2_HAVE_PERFETTO
@@ -38,6 +40,14 @@ void JFactory::Create(const std::shared_ptr<const JEvent>& event) {
 
 void JFactory::Create(const JEvent& event) {
 
+    // With jana:enable_factory_parallelism, several threads may ask for this factory's data at once. The first one
+    // creates it and the others wait. The mutex is recursive so that re-entering from the same thread still reaches
+    // the cycle check below.
+    std::unique_lock<std::recursive_mutex> create_lock(mCreateMutex, std::defer_lock);
+    if (event.GetFactorySet()->IsFactoryParallelismEnabled()) {
+        create_lock.lock();
+    }
+
     if (mInsideCreate && (mStatus != Status::Inserted)) {
         // Ideally, we disallow any calls to Create() that end up calling it right back. However, we do allow
         // calls that go down to GetObjects, who inserts the data, but then RETRIEVES the same data it just inserted,
@@ -96,7 +106,7 @@ void JFactory::Create(const JEvent& event) {
                 found_data = src->GetObjects(event.shared_from_this(), this); });
 
             if (found_data) {
-                mStatus = Status::Inserted;
+                SetStatus(Status::Inserted);
                 return;
             }
         }
@@ -115,7 +125,7 @@ void JFactory::Create(const JEvent& event) {
         for (auto* output : GetVariadicOutputs()) {
             output->LagrangianStore(*event.GetFactorySet(), JDatabundle::Status::Excepted);
         }
-        mStatus = Status::Excepted;
+        SetStatus(Status::Excepted);
         std::rethrow_exception(mException);
     }
 
@@ -168,7 +178,7 @@ void JFactory::Create(const JEvent& event) {
         }
         catch(...) {
             // If Init() excepts, we still need to store an empty collection
-            mStatus = Status::Excepted;
+            SetStatus(Status::Excepted);
             for (auto* output : GetOutputs()) {
                 output->LagrangianStore(*event.GetFactorySet(), JDatabundle::Status::Excepted);
             }
@@ -187,8 +197,13 @@ void JFactory::Create(const JEvent& event) {
         else if (mStatus == Status::Empty) {
             // Now we know that we need to run Process() to create the data in the first place
             try {
+                // Self time only: the upstream factories we trigger record their own time and it gets subtracted from ours
+                JLatencyHistogram::SelfTimer latency_timer(m_latency_histogram);
                 auto run_number = event.GetRunNumber();
                 if (mPreviousRunNumber != run_number) {
+                    for (auto* resource : m_resources) {
+                        resource->ChangeRun(run_number, GetApplication());
+                    }
                     if (m_callback_style == CallbackStyle::LegacyMode) {
                         if (mPreviousRunNumber != -1) {
                             {
@@ -225,6 +240,7 @@ void JFactory::Create(const JEvent& event) {
                     }
                     mPreviousRunNumber = run_number;
                 }
+                CreateInputsConcurrently(event);
                 for (auto* input : GetInputs()) {
                     input->Populate(event);
                 }
@@ -250,7 +266,7 @@ void JFactory::Create(const JEvent& event) {
 
                 LOG_DEBUG(GetLogger()) << "Exception in JFactory::Create, prefix=" << GetPrefix()
                                        << ", message=" << ex.GetMessage();
-                mStatus = Status::Excepted;
+                SetStatus(Status::Excepted);
                 mException = std::current_exception();
                 for (auto* output : GetOutputs()) {
                     output->LagrangianStore(*event.GetFactorySet(), JDatabundle::Status::Excepted);
@@ -267,7 +283,7 @@ void JFactory::Create(const JEvent& event) {
                 // Note that the collections themselves won't know that they exited early
 
                 LOG_DEBUG(GetLogger()) << "Exception in JFactory::Create, prefix=" << GetPrefix();
-                mStatus = Status::Excepted;
+                SetStatus(Status::Excepted);
                 mException = std::current_exception();
                 for (auto* output : GetOutputs()) {
                     output->LagrangianStore(*event.GetFactorySet(), JDatabundle::Status::Excepted);
@@ -279,7 +295,7 @@ void JFactory::Create(const JEvent& event) {
             }
 
             // Save the (successfully processed) data
-            mStatus = Status::Processed;
+            SetStatus(Status::Processed);
             for (auto* output : GetOutputs()) {
                 output->LagrangianStore(*event.GetFactorySet(), JDatabundle::Status::Created);
             }
@@ -340,4 +356,61 @@ void JFactory::Summarize(JComponentSummary& summary) const {
     summary.Add(fs);
 }
 
+void JFactory::ParallelFor(size_t begin, size_t end, size_t grain_size, const std::function<void(size_t, size_t)>& fn) {
+    if (grain_size == 0) {
+        throw JException("JFactory::ParallelFor: grain_size needs to be at least 1");
+    }
+    if (end <= begin) {
+        return;
+    }
+    auto run_chunk = [this, &fn](size_t chunk_begin, size_t chunk_end) {
+        JLatencyHistogram::Timer latency_timer(m_chunk_latency_histogram);
+        fn(chunk_begin, chunk_end);
+    };
+    auto get_chunk_end = [end, grain_size](size_t chunk_begin) {
+        return (end - chunk_begin > grain_size) ? chunk_begin + grain_size : end;
+    };
+
+    // The engine is set up front by JComponentManager::ConfigureEvent, so factories outside of a pooled event run serially
+    JExecutionEngine* engine = nullptr;
+    if (end - begin > grain_size && mFactorySet != nullptr) {
+        engine = mFactorySet->GetSubtaskEngine();
+    }
+    if (engine == nullptr) {
+        // A single chunk, or nobody to share with
+        for (size_t chunk_begin=begin; chunk_begin<end; chunk_begin=get_chunk_end(chunk_begin)) {
+            run_chunk(chunk_begin, get_chunk_end(chunk_begin));
+        }
+        return;
+    }
+
+    // Offer all but the first chunk to the idle workers, and run the first one on this thread
+    std::vector<std::shared_ptr<JExecutionEngine::Subtask>> subtasks;
+    for (size_t chunk_begin=get_chunk_end(begin); chunk_begin<end; chunk_begin=get_chunk_end(chunk_begin)) {
+        auto chunk_end = get_chunk_end(chunk_begin);
+        subtasks.push_back(engine->SubmitSubtask([&run_chunk, chunk_begin, chunk_end](){ run_chunk(chunk_begin, chunk_end); }));
+    }
+    std::exception_ptr first_exception;
+    try {
+        run_chunk(begin, get_chunk_end(begin));
+    }
+    catch (...) {
+        first_exception = std::current_exception();
+    }
+    // We can't leave before the other chunks finish, because they still reference fn
+    for (auto& subtask : subtasks) {
+        engine->WaitForSubtask(*subtask);
+        try {
+            subtask->result.get();
+        }
+        catch (...) {
+            if (first_exception == nullptr) {
+                first_exception = std::current_exception();
+            }
+        }
+    }
+    if (first_exception != nullptr) {
+        std::rethrow_exception(first_exception);
+    }
+}
 
@@ -13,14 +13,18 @@
 #include <JANA/Components/JHasOutputs.h>
 #include <JANA/Components/JHasRunCallbacks.h>
 #include <JANA/JVersion.h>
+#include <JANA/JFactorySet.h>
 #if JANA2_HAVE_PODIO
 #include <JANA/Components/JPodioOutput.h>
 #endif
 #include <JANA/Components/JLightweightOutput.h>
+#include <JANA/Components/JColumnarOutput.h>
 
+#include <functional>
 #include <string>
 #include <typeindex>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 
@@ -82,7 +86,14 @@ public:
     uint32_t GetPreviousRunNumber(void) const { return mPreviousRunNumber; }
 
     void SetFactoryName(std::string factoryName) { SetTypeName(factoryName); }
-    void SetStatus(Status status){ mStatus = status; }
+    void SetStatus(Status status) {
+        if (mStatus == Status::Empty && status != Status::Empty && mFactorySet != nullptr) {
+            // Let JFactorySet::Clear() know that this factory needs clearing
+            mFactorySet->MarkDirty(this);
+        }
+        mStatus = status;
+    }
+    void SetFactorySet(JFactorySet* factory_set) { mFactorySet = factory_set; } ///< Called automatically by JFactorySet::Add()
     void SetInsertOrigin(JCallGraphRecorder::JDataOrigin origin) { m_insert_origin = origin; } ///< Called automatically by JEvent::Insert() to records whether that call was made by a source or factory.
 
     void SetPreviousRunNumber(uint32_t aRunNumber) { mPreviousRunNumber = aRunNumber; }
@@ -181,6 +192,17 @@ public:
 
     virtual void Set(const std::vector<JObject *>&) { throw JException("Not supported!"); }
 
+    /// Splits [begin, end) into chunks of at most grain_size and calls fn(chunk_begin, chunk_end) on each, e.g. to fit
+    /// the tracks of one event in parallel from inside Process(). Every chunk but the first is offered to idle workers,
+    /// the same way as with jana:enable_factory_parallelism, and the calling thread runs whatever nobody has picked up
+    /// yet. Returns once every chunk has finished; if any of them threw, the first exception is rethrown afterwards.
+    /// Chunks may run concurrently, so fn should only write to state belonging to its own chunk, and it shouldn't call
+    /// JEvent::Get(). Pick grain_size so that each chunk takes at least tens of microseconds. With jana:latency_histograms,
+    /// the chunk durations show up under "ParallelFor".
+    void ParallelFor(size_t begin, size_t end, size_t grain_size, const std::function<void(size_t, size_t)>& fn);
+
+    void SetChunkLatencyHistogram(JLatencyHistogram* histogram) { m_chunk_latency_histogram = histogram; }
+
 
 protected:
 
@@ -190,12 +212,15 @@ protected:
 
     int32_t mPreviousRunNumber = -1;
     bool mInsideCreate = false; // Use this to detect cycles in factory dependencies
+    std::recursive_mutex mCreateMutex; // Only locked when jana:enable_factory_parallelism is set
     std::string mObjectName;
 
     Status mStatus = Status::Empty;
+    JFactorySet* mFactorySet = nullptr;
     InitStatus mInitStatus = InitStatus::InitNotRun;
     JCallGraphRecorder::JDataOrigin m_insert_origin = JCallGraphRecorder::ORIGIN_NOT_AVAILABLE; // (see note at top of JCallGraphRecorder.h)
     std::exception_ptr mException;
+    JLatencyHistogram* m_chunk_latency_histogram = nullptr; // Shared by all pooled copies, like m_latency_histogram
 };
 
 // We are moving away from JFactory::GetAs because it only considers the first databundle
@@ -2,7 +2,11 @@
 // Copyright 2020, Jefferson Science Associates, LLC.
 // Subject to the terms in the LICENSE file found in the top-level directory.
 
+#include <algorithm>
 #include <iterator>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
 #include <unistd.h>
 
 #include "JFactorySet.h"
@@ -61,6 +65,11 @@ void JFactorySet::Add(JDatabundle* databundle) {
         throw ex;
     }
 
+    databundle->SetArena(&mArena);
+    databundle->SetFactorySet(this);
+    if (databundle->GetStatus() != JDatabundle::Status::Empty && databundle->GetFactory() == nullptr) {
+        MarkDirty(databundle);
+    }
     mDatabundles.push_back(databundle);
     mDatabundleFromUniqueName[databundle->GetUniqueName()] = databundle;
     mDatabundleFromTypeIndexAndEitherName[{databundle->GetTypeIndex(), databundle->GetUniqueName()}] = databundle;
@@ -69,6 +78,14 @@ void JFactorySet::Add(JDatabundle* databundle) {
     mDatabundleFromTypeNameAndEitherName[{databundle->GetTypeName(), databundle->GetShortName()}] = databundle;
     mDatabundlesFromTypeIndex[databundle->GetTypeIndex()].push_back(databundle);
     mDatabundlesFromTypeName[databundle->GetTypeName()].push_back(databundle);
+
+    for (auto slot : {ResolveSlot(databundle->GetTypeIndex(), databundle->GetUniqueName()),
+                      ResolveSlot(databundle->GetTypeIndex(), databundle->GetShortName())}) {
+        if (slot >= mDatabundlesFromSlot.size()) {
+            mDatabundlesFromSlot.resize(slot + 1, nullptr);
+        }
+        mDatabundlesFromSlot[slot] = databundle;
+    }
 }
 
 //---------------------------------
@@ -90,6 +107,12 @@ void JFactorySet::Add(JFactory* factory)
         delete factory;
         return;
     }
+    if (mPrunedFactories != nullptr && mPrunedFactories->count({factory->GetTypeName(), factory->GetPrefix()}) != 0) {
+        // Nothing can reach this factory, so don't bother keeping it around
+        mPrunedFactoryCount += 1;
+        delete factory;
+        return;
+    }
     /*
     else {
         LOG << "    Adding factory with type_name=" << factory->GetTypeName()
@@ -99,6 +122,10 @@ void JFactorySet::Add(JFactory* factory)
     */
 
     mFactories.push_back(factory);
+    factory->SetFactorySet(this);
+    if (factory->GetStatus() != JFactory::Status::Empty) {
+        MarkDirty(factory);
+    }
 
     for (auto* output : factory->GetOutputs()) {
         if (output->GetLevel() != mLevel && output->GetLevel() != JEventLevel::None) {
@@ -164,6 +191,18 @@ JDatabundle* JFactorySet::GetDatabundle(std::type_index object_type_index, const
     return nullptr;
 }
 
+//---------------------------------
+// ResolveSlot
+//---------------------------------
+size_t JFactorySet::ResolveSlot(std::type_index object_type_index, const std::string& short_or_unique_name) {
+    static std::mutex slots_mutex;
+    static std::map<std::pair<std::type_index, std::string>, size_t> slots;
+
+    std::lock_guard<std::mutex> lock(slots_mutex);
+    auto result = slots.emplace(std::make_pair(object_type_index, short_or_unique_name), slots.size());
+    return result.first->second;
+}
+
 //---------------------------------
 // GetDatabundles
 //---------------------------------
@@ -176,6 +215,81 @@ const std::vector<JDatabundle*>& JFactorySet::GetDatabundles(std::type_index ind
     return no_databundles;
 }
 
+//---------------------------------
+// CheckForCycles
+//---------------------------------
+void JFactorySet::CheckForCycles() const {
+    std::unordered_map<JFactory*, size_t> waves;
+    std::vector<JFactory*> path;
+    for (auto* factory : mFactories) {
+        ComputeWave(factory, waves, path);
+    }
+}
+
+//---------------------------------
+// GetUpstreamWaves
+//---------------------------------
+std::vector<std::vector<JFactory*>> JFactorySet::GetUpstreamWaves(const std::vector<jana::components::JHasInputs*>& consumers) const {
+
+    std::unordered_map<JFactory*, size_t> waves;
+    std::vector<JFactory*> path;
+    std::vector<JFactory*> needed;
+    for (auto* consumer : consumers) {
+        consumer->GetUpstreamFactories(*this, needed);
+    }
+    for (auto* factory : needed) {
+        ComputeWave(factory, waves, path);
+    }
+
+    // Keep the factories in the same order as mFactories, so that the result doesn't depend on hash order
+    std::vector<std::vector<JFactory*>> result;
+    for (auto* factory : mFactories) {
+        auto it = waves.find(factory);
+        if (it == waves.end()) continue;
+        if (result.size() <= it->second) {
+            result.resize(it->second + 1);
+        }
+        result[it->second].push_back(factory);
+    }
+    return result;
+}
+
+//---------------------------------
+// ComputeWave
+//---------------------------------
+size_t JFactorySet::ComputeWave(JFactory* factory, std::unordered_map<JFactory*, size_t>& waves, std::vector<JFactory*>& path) const {
+
+    // Depth-first search. Finding a factory which is already on the path means we followed a back edge.
+    constexpr size_t in_progress = static_cast<size_t>(-1);
+    auto it = waves.find(factory);
+    if (it != waves.end() && it->second != in_progress) {
+        return it->second;
+    }
+    if (it != waves.end()) {
+        std::ostringstream oss;
+        for (auto path_it = std::find(path.begin(), path.end(), factory); path_it != path.end(); ++path_it) {
+            oss << (*path_it)->GetPrefix() << " -> ";
+        }
+        oss << factory->GetPrefix();
+        auto ex = JException("Encountered a cycle in the factory dependency graph: %s", oss.str().c_str());
+        ex.function_name = "JFactorySet::CheckForCycles";
+        ex.plugin_name = factory->GetPluginName();
+        throw ex;
+    }
+    waves[factory] = in_progress;
+    path.push_back(factory);
+
+    std::vector<JFactory*> upstream;
+    factory->GetUpstreamFactories(*this, upstream);
+    size_t wave = 0;
+    for (auto* upstream_factory : upstream) {
+        wave = std::max(wave, ComputeWave(upstream_factory, waves, path) + 1);
+    }
+    path.pop_back();
+    waves[factory] = wave;
+    return wave;
+}
+
 //---------------------------------
 // Print
 //---------------------------------
@@ -245,15 +359,31 @@ void JFactorySet::Print() const {
 //---------------------------------
 void JFactorySet::Clear() {
 
-    for (auto* factory : mFactories) {
+    // Only the factories and databundles that left the Empty status since the last Clear() can be holding any data.
+    // Persistent ones stay non-empty, so we keep them on the dirty list for next time.
+    size_t kept = 0;
+    for (auto* factory : mDirtyFactories) {
         factory->ClearData();
+        if (factory->GetStatus() != JFactory::Status::Empty) {
+            mDirtyFactories[kept++] = factory;
+        }
     }
-    for (auto* databundle : mDatabundles) {
-        // Clear any databundles that did not come from a JFactory
+    mDirtyFactories.resize(kept);
+
+    kept = 0;
+    for (auto* databundle : mDirtyDatabundles) {
+        // Databundles that came from a JFactory got cleared along with it
         if (databundle->GetFactory() == nullptr) {
             databundle->ClearData();
+            if (databundle->GetStatus() != JDatabundle::Status::Empty) {
+                mDirtyDatabundles[kept++] = databundle;
+            }
         }
     }
+    mDirtyDatabundles.resize(kept);
+
+    // Every databundle has run the destructors for its arena objects by now, so we can free them all at once
+    mArena.Reset();
 }
 
 //---------------------------------
@@ -7,12 +7,18 @@
 #include <string>
 #include <typeindex>
 #include <map>
+#include <mutex>
+#include <set>
+#include <unordered_map>
 
 #include <JANA/Components/JComponentSummary.h>
 #include <JANA/Components/JDatabundle.h>
 #include <JANA/Utils/JEventLevel.h>
+#include <JANA/Utils/JArena.h>
 
 class JFactory;
+class JExecutionEngine;
+namespace jana::components { struct JHasInputs; }
 
 class JFactorySet {
 
@@ -25,9 +31,24 @@ private:
     std::map<std::pair<std::type_index, std::string>, JDatabundle*> mDatabundleFromTypeIndexAndEitherName;
     std::map<std::pair<std::string, std::string>, JDatabundle*> mDatabundleFromTypeNameAndEitherName;
 
+    std::vector<JDatabundle*> mDatabundlesFromSlot;
+
     std::map<std::type_index, std::vector<JDatabundle*>> mDatabundlesFromTypeIndex;
     std::map<std::string, std::vector<JDatabundle*>> mDatabundlesFromTypeName;
 
+    bool mEnableFactoryParallelism = false;
+    JExecutionEngine* mSubtaskEngine = nullptr;
+
+    JArena mArena;
+
+    // Factories and factory-less databundles which may be holding data, so that Clear() doesn't have to visit the rest
+    std::vector<JFactory*> mDirtyFactories;
+    std::vector<JDatabundle*> mDirtyDatabundles;
+    std::mutex mDirtyMutex; // Only locked when factory parallelism is enabled
+
+    const std::set<std::pair<std::string, std::string>>* mPrunedFactories = nullptr;
+    size_t mPrunedFactoryCount = 0;
+
 public:
     JFactorySet();
     virtual ~JFactorySet();
@@ -48,9 +69,75 @@ public:
     JDatabundle* GetDatabundle(const std::string& object_type_name, const std::string& short_or_unique_name) const;
     JDatabundle* GetDatabundle(std::type_index object_type_index, const std::string& short_or_unique_name) const;
 
+    /// Returns the integer slot for a (type, short-or-unique name) pair. Slots are global, so that the same pair maps
+    /// to the same slot in every JFactorySet. Resolve the slot once when wiring a component (this takes a lock), and
+    /// then look the databundle up on each event via GetDatabundle(slot), which is a single indexed load.
+    static size_t ResolveSlot(std::type_index object_type_index, const std::string& short_or_unique_name);
+
+    JDatabundle* GetDatabundle(size_t slot) const {
+        return (slot < mDatabundlesFromSlot.size()) ? mDatabundlesFromSlot[slot] : nullptr;
+    }
+
     const std::vector<JDatabundle*>& GetDatabundles(std::type_index index) const;
     const std::vector<JDatabundle*>& GetDatabundles(const std::string& object_type_name) const;
 
+    /// When enabled, independent factories for the same event may run concurrently on the worker pool.
+    /// See jana:enable_factory_parallelism.
+    void EnableFactoryParallelism(bool enable) { mEnableFactoryParallelism = enable; mArena.SetThreadSafe(enable); }
+    bool IsFactoryParallelismEnabled() const { return mEnableFactoryParallelism; }
+
+    /// Memory that lives exactly as long as the current event. Clear() resets it after all databundles have been cleared.
+    /// See Output<T>::EnableArena().
+    JArena& GetArena() { return mArena; }
+    const JArena& GetArena() const { return mArena; }
+
+    /// Restricts which of the factories added from now on actually get kept. A factory whose (type name, prefix) is in
+    /// `pruned` is deleted right away. JComponentManager::ConfigureEvent only sets this while the factory generators run,
+    /// and resets it to nullptr afterwards, so that factories created later by JEvent::Insert() are unaffected.
+    /// `pruned` has to outlive that. See jana:prune_unreachable_factories.
+    void SetPrunedFactories(const std::set<std::pair<std::string, std::string>>* pruned) { mPrunedFactories = pruned; }
+    size_t GetPrunedFactoryCount() const { return mPrunedFactoryCount; }
+
+    /// Called automatically whenever a factory or a factory-less databundle in this set leaves the Empty status.
+    /// Clear() only visits what has been marked dirty, so its cost scales with the work done on the event instead of
+    /// with the number of factories.
+    void MarkDirty(JFactory* factory) {
+        if (mEnableFactoryParallelism) {
+            std::lock_guard<std::mutex> lock(mDirtyMutex);
+            mDirtyFactories.push_back(factory);
+        }
+        else {
+            mDirtyFactories.push_back(factory);
+        }
+    }
+    void MarkDirty(JDatabundle* databundle) {
+        if (mEnableFactoryParallelism) {
+            std::lock_guard<std::mutex> lock(mDirtyMutex);
+            mDirtyDatabundles.push_back(databundle);
+        }
+        else {
+            mDirtyDatabundles.push_back(databundle);
+        }
+    }
+    size_t GetDirtyFactoryCount() const { return mDirtyFactories.size(); }
+    size_t GetDirtyDatabundleCount() const { return mDirtyDatabundles.size(); }
+
+    // Set by JComponentManager::ConfigureEvent before the event is ever shared between workers, and read-only afterwards
+    JExecutionEngine* GetSubtaskEngine() const { return mSubtaskEngine; }
+    void SetSubtaskEngine(JExecutionEngine* engine) { mSubtaskEngine = engine; }
+
+    /// Throws if the factories' declared inputs and outputs form a cycle. Concurrent factories can't detect
+    /// cycles at runtime the way JFactory::Create() does, so we check the whole wiring graph up front instead.
+    void CheckForCycles() const;
+
+    /// Groups the factories which `consumers` need, directly or transitively, into waves. Every factory lands in a
+    /// later wave than all of the factories it depends on, so the factories within a wave are independent of each other.
+    /// Throws if the factories form a cycle.
+    std::vector<std::vector<JFactory*>> GetUpstreamWaves(const std::vector<jana::components::JHasInputs*>& consumers) const;
+
+private:
+    size_t ComputeWave(JFactory* factory, std::unordered_map<JFactory*, size_t>& waves, std::vector<JFactory*>& path) const;
+
 };
 
 
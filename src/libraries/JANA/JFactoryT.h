@@ -87,13 +87,13 @@ public:
             // Ideally, they would use a temporary vector and not access mData at all, but they are used to this
             // from JANA1 and I haven't found a cleaner solution that gives them what they want yet.
             mOutput.GetDatabundle().SetStatus(JDatabundle::Status::Inserted);
-            mStatus = Status::Inserted;
+            SetStatus(Status::Inserted);
         }
         else {
             ClearData();
             mData = aData;
             mOutput.GetDatabundle().SetStatus(JDatabundle::Status::Inserted);
-            mStatus = Status::Inserted;
+            SetStatus(Status::Inserted);
         }
     }
 
@@ -101,13 +101,13 @@ public:
         ClearData();
         mData = std::move(aData);
         mOutput.GetDatabundle().SetStatus(JDatabundle::Status::Inserted);
-        mStatus = Status::Inserted;
+        SetStatus(Status::Inserted);
     }
 
     virtual void Insert(T* aDatum) {
         mData.push_back(aDatum);
         mOutput.GetDatabundle().SetStatus(JDatabundle::Status::Inserted);
-        mStatus = Status::Inserted;
+        SetStatus(Status::Inserted);
     }
 
     /// Set a flag (or flags)
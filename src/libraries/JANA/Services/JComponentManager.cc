@@ -10,6 +10,12 @@
 #include <JANA/JEventUnfolder.h>
 #include <JANA/JEventFolder.h>
 #include <JANA/Utils/JAutoActivator.h>
+#include <JANA/Utils/JCallGraphSummary.h>
+#include <JANA/Utils/JTablePrinter.h>
+
+#include <algorithm>
+#include <set>
+#include <sstream>
 
 JComponentManager::JComponentManager() {
     SetPrefix("jana");
@@ -64,6 +70,42 @@ void JComponentManager::ConfigureComponents() {
                                   m_enable_call_graph_recording,
                                   "Records a trace of who called each factory. Reduces performance but necessary for plugins such as janadot.")
             ->SetIsAdvanced(true);
+    m_params->SetDefaultParameter("jana:enable_factory_parallelism",
+                                  m_enable_factory_parallelism,
+                                  "Run independent factories for the same event concurrently, using idle worker threads. Reduces per-event latency for large events.")
+            ->SetIsAdvanced(true);
+    m_params->SetDefaultParameter("jana:event_arena_block_size",
+                                  m_event_arena_block_size,
+                                  "Initial size (in bytes) of each event's arena, which backs Output<T>::EnableArena(). Tune using the high-water marks reported at the end of the run.")
+            ->SetIsAdvanced(true);
+    m_params->SetDefaultParameter("jana:prune_unreachable_factories",
+                                  m_prune_unreachable_factories,
+                                  "Delete factories that no processor, unfolder, folder, or autoactivated factory can reach via declared inputs, right after they are generated. Saves resident memory when there are many pooled events. Skipped if any component uses legacy mode or declares no inputs.")
+            ->SetIsAdvanced(true);
+    m_params->SetDefaultParameter("jana:call_graph_summary",
+                                  m_enable_call_graph_summary,
+                                  "Aggregates who called each factory, and for how long, into a single call graph which is printed at the end of the run. Much cheaper than record_call_stack.")
+            ->SetIsAdvanced(true);
+    m_params->SetDefaultParameter("jana:call_graph_sampling",
+                                  m_call_graph_sampling_interval,
+                                  "Only record the call graph of one in every N events. Used with jana:call_graph_summary.")
+            ->SetIsAdvanced(true);
+    m_params->SetDefaultParameter("jana:call_graph_buffer_size",
+                                  m_call_graph_buffer_size,
+                                  "Max number of factory calls recorded per event. Used with jana:call_graph_summary. Calls beyond this are counted but not timed.")
+            ->SetIsAdvanced(true);
+    if (m_enable_factory_parallelism && (m_enable_call_graph_recording || m_enable_call_graph_summary)) {
+        // JCallGraphRecorder assumes that one factory runs at a time
+        LOG_WARN(GetLogger()) << "jana:enable_factory_parallelism is incompatible with record_call_stack and jana:call_graph_summary. Running factories sequentially instead." << LOG_END;
+        m_enable_factory_parallelism = false;
+    }
+    if (m_enable_call_graph_summary) {
+        m_call_graph_summary = std::make_unique<JCallGraphSummary>();
+    }
+    m_params->SetDefaultParameter("jana:latency_histograms",
+                                  m_enable_latency_histograms,
+                                  "Record a latency histogram for every factory, processor, and source, and print the p50/p99/max of each at the end of the run.")
+            ->SetIsAdvanced(true);
     m_params->SetDefaultParameter("jana:nevents", m_nevents, "Max number of events that sources can emit");
     m_params->SetDefaultParameter("jana:nskip", m_nskip, "Number of events that sources should skip before starting emitting");
     m_params->SetDefaultParameter("autoactivate", m_autoactivate, "List of factories to activate regardless of what the event processors request. Format is typename:tag,typename:tag");
@@ -124,11 +166,16 @@ void JComponentManager::InitializeComponents() {
     // Event sources
     for (auto * src : m_evt_srces) {
         src->Summarize(m_summary);
+        src->SetLatencyHistogram(GetLatencyHistogram("Source", src->GetTypeName(), src->GetPrefix()));
     }
 
     // Event processors
     for (auto * evt_proc : m_evt_procs) {
         evt_proc->Summarize(m_summary);
+        evt_proc->SetLatencyHistogram(GetLatencyHistogram("Processor", evt_proc->GetTypeName(), evt_proc->GetPrefix()));
+        if (evt_proc->GetCallbackStyle() != JEventProcessor::CallbackStyle::LegacyMode) {
+            evt_proc->SetParallelLatencyHistogram(GetLatencyHistogram("ProcessParallel", evt_proc->GetTypeName(), evt_proc->GetPrefix()));
+        }
     }
 
     // Unfolders
@@ -206,16 +253,155 @@ void JComponentManager::Add(JEventFolder* folder) {
 
 void JComponentManager::ConfigureEvent(JEvent& event) {
     auto* factory_set = event.GetFactorySet();
+    if (m_prune_unreachable_factories) {
+        factory_set->SetPrunedFactories(&GetPrunedFactories(event.GetLevel()));
+    }
     for (auto gen : m_fac_gens) {
         gen->GenerateFactories(factory_set);
     }
+    factory_set->SetPrunedFactories(nullptr); // Factories which JEvent::Insert() creates later are always kept
+    if (m_enable_latency_histograms) {
+        for (auto* factory : factory_set->GetAllFactories()) {
+            factory->SetLatencyHistogram(GetLatencyHistogram("Factory", factory->GetTypeName(), factory->GetPrefix()));
+            factory->SetChunkLatencyHistogram(GetLatencyHistogram("ParallelFor", factory->GetTypeName(), factory->GetPrefix()));
+        }
+    }
     event.SetDefaultTags(m_default_tags);
+    factory_set->GetArena().SetBlockSize(m_event_arena_block_size);
     event.GetJCallGraphRecorder()->SetEnabled(m_enable_call_graph_recording);
+    if (m_call_graph_summary != nullptr) {
+        event.GetJCallGraphRecorder()->EnableSummary(m_call_graph_summary.get(), m_call_graph_sampling_interval, m_call_graph_buffer_size);
+    }
+    if (m_enable_factory_parallelism) {
+        factory_set->CheckForCycles();
+        factory_set->EnableFactoryParallelism(true);
+    }
+    factory_set->SetSubtaskEngine(m_subtask_engine);
     event.SetJApplication(GetApplication());
 }
 
 
 
+/// GetPrunedFactories figures out which of the factories generated for `level` can't be reached from any sink, by
+/// generating them all once into a throwaway JFactorySet and walking upstream from the declared inputs of each processor,
+/// unfolder, and folder at that level, as well as from each autoactivated factory. Components and factories at other levels
+/// count too, via inputs which explicitly ask for this level, e.g. a PhysicsEvent processor reading a Timeslice collection.
+/// The result is keyed by factory type name and prefix, computed once per level, and then reused for every pooled event,
+/// whose factory sets never keep the unreachable factories.
+/// Note that this can only see inputs which are declared via Input/VariadicInput. Anything else might call JEvent::Get()
+/// from inside Process(), so if any enabled component or reachable factory uses legacy mode or declares no inputs at
+/// all, nothing gets pruned at this level.
+const std::set<std::pair<std::string, std::string>>& JComponentManager::GetPrunedFactories(JEventLevel level) {
+
+    std::lock_guard<std::mutex> lock(m_pruned_factories_mutex);
+    auto it = m_pruned_factories.find(level);
+    if (it != m_pruned_factories.end()) {
+        return it->second;
+    }
+
+    auto make_prototype = [this](JFactorySet& facset, JEventLevel facset_level) {
+        facset.SetLevel(facset_level);
+        for (auto* gen : m_fac_gens) {
+            gen->GenerateFactories(&facset);
+        }
+    };
+    JFactorySet prototype;
+    make_prototype(prototype, level);
+
+    // Each component's inputs default to the level of the events it sees. For folders, those are the children.
+    std::vector<std::pair<jana::components::JHasInputs*, JEventLevel>> components;
+    std::set<JEventLevel> levels;
+    for (auto* source : m_evt_srces) {
+        levels.insert(source->GetLevel());
+    }
+    for (auto* proc : m_evt_procs) {
+        if (proc->IsEnabled()) components.push_back({proc, proc->GetLevel()});
+        levels.insert(proc->GetLevel());
+    }
+    for (auto* unfolder : m_unfolders) {
+        if (unfolder->IsEnabled()) components.push_back({unfolder, unfolder->GetLevel()});
+        levels.insert(unfolder->GetLevel());
+        levels.insert(unfolder->GetChildLevel());
+    }
+    for (auto* folder : m_folders) {
+        if (folder->IsEnabled()) components.push_back({folder, folder->GetChildLevel()});
+        levels.insert(folder->GetLevel());
+        levels.insert(folder->GetChildLevel());
+    }
+
+    // Collect the factories at this level which something reads directly. The upstream walk below takes it from there.
+    std::vector<JFactory*> needed;
+    for (auto& [component, component_level] : components) {
+        component->GetUpstreamFactories(prototype, needed, component_level != level);
+    }
+    // Factories at the other levels may read from this one as well. We don't bother figuring out which of them are
+    // reachable themselves, so this may keep a few more factories than strictly necessary, but never fewer.
+    for (auto other_level : levels) {
+        if (other_level == level) continue;
+        JFactorySet other_prototype;
+        make_prototype(other_prototype, other_level);
+        for (auto* factory : other_prototype.GetAllFactories()) {
+            factory->GetUpstreamFactories(prototype, needed, true);
+        }
+    }
+
+    // Autoactivated factories are sinks in their own right. Use the same "typename:tag,typename:tag" parsing as JAutoActivator
+    std::stringstream autoactivate_ss(m_autoactivate);
+    std::string autoactivate_item;
+    while (std::getline(autoactivate_ss, autoactivate_item, ',')) {
+        if (autoactivate_item.empty()) continue;
+        auto pair = JAutoActivator::Split(autoactivate_item);
+        auto* databundle = prototype.GetDatabundle(pair.first, pair.second);
+        if (databundle != nullptr && databundle->GetFactory() != nullptr) {
+            needed.push_back(databundle->GetFactory());
+        }
+    }
+
+    std::set<JFactory*> reachable(needed.begin(), needed.end());
+    std::vector<jana::components::JHasInputs*> consumers(needed.begin(), needed.end());
+    for (auto& wave : prototype.GetUpstreamWaves(consumers)) {
+        reachable.insert(wave.begin(), wave.end());
+    }
+
+    auto& pruned = m_pruned_factories[level];
+
+    // Same as with jana:pipeline_barriers, we can't see what legacy components do, so we fall back to keeping everything
+    std::vector<std::string> opaque;
+    // Unfolders and folders don't have a legacy mode, so only their inputs count
+    auto check_opaque = [&opaque](auto* component, bool has_legacy_mode) {
+        if ((has_legacy_mode && component->GetCallbackStyle() == jana::components::JComponent::CallbackStyle::LegacyMode) ||
+            (component->GetInputs().empty() && component->GetVariadicInputs().empty())) {
+            opaque.push_back(component->GetTypeName());
+        }
+    };
+    for (auto* proc : m_evt_procs) {
+        if (proc->IsEnabled()) check_opaque(proc, true);
+    }
+    for (auto* unfolder : m_unfolders) {
+        if (unfolder->IsEnabled()) check_opaque(unfolder, false);
+    }
+    for (auto* folder : m_folders) {
+        if (folder->IsEnabled()) check_opaque(folder, false);
+    }
+    for (auto* factory : reachable) {
+        check_opaque(factory, true);
+    }
+    if (!opaque.empty()) {
+        LOG_WARN(GetLogger()) << "jana:prune_unreachable_factories: '" << opaque[0] << "' uses legacy mode or declares no inputs, "
+                              << "so it might call JEvent::Get() on anything. Not pruning any factories at level " << toString(level) << LOG_END;
+        return pruned;
+    }
+    auto factories = prototype.GetAllFactories();
+    for (auto* factory : factories) {
+        if (reachable.count(factory) == 0) {
+            pruned.insert({factory->GetTypeName(), factory->GetPrefix()});
+        }
+    }
+    LOG_INFO(GetLogger()) << "Pruned " << pruned.size() << " of " << factories.size()
+                          << " factories at level " << toString(level) << " because no sink can reach them" << LOG_END;
+    return pruned;
+}
+
 void JComponentManager::ResolveEventSources() {
 
     m_user_evt_src_gen = ResolveUserEventSourceGenerator();
@@ -326,3 +512,54 @@ const JComponentSummary& JComponentManager::GetComponentSummary() {
     return m_summary;
 }
 
+JCallGraphSummary* JComponentManager::GetCallGraphSummary() {
+    return m_call_graph_summary.get();
+}
+
+JLatencyHistogram* JComponentManager::GetLatencyHistogram(const std::string& kind, const std::string& type_name, const std::string& prefix) {
+    if (!m_enable_latency_histograms) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(m_latency_histograms_mutex);
+    auto& histogram = m_latency_histograms[std::make_tuple(kind, type_name, prefix)];
+    if (histogram == nullptr) {
+        histogram = std::make_unique<JLatencyHistogram>();
+    }
+    return histogram.get();
+}
+
+std::vector<JComponentManager::LatencySummary> JComponentManager::GetLatencySummaries() {
+    std::vector<LatencySummary> summaries;
+    {
+        std::lock_guard<std::mutex> lock(m_latency_histograms_mutex);
+        for (auto& it : m_latency_histograms) {
+            auto snapshot = it.second->GetSnapshot();
+            if (snapshot.count == 0) continue;
+            summaries.push_back({std::get<0>(it.first), std::get<1>(it.first), std::get<2>(it.first), snapshot});
+        }
+    }
+    std::sort(summaries.begin(), summaries.end(), [](const LatencySummary& a, const LatencySummary& b) {
+        return a.snapshot.total_ns > b.snapshot.total_ns;
+    });
+    return summaries;
+}
+
+void JComponentManager::PrintLatencySummaries(std::ostream& os) {
+    JTablePrinter table;
+    table.AddColumn("Kind");
+    table.AddColumn("Type");
+    table.AddColumn("Prefix");
+    table.AddColumn("Count", JTablePrinter::Justify::Right);
+    table.AddColumn("Mean [ms]", JTablePrinter::Justify::Right);
+    table.AddColumn("p50 [ms]", JTablePrinter::Justify::Right);
+    table.AddColumn("p99 [ms]", JTablePrinter::Justify::Right);
+    table.AddColumn("Max [ms]", JTablePrinter::Justify::Right);
+    for (const auto& summary : GetLatencySummaries()) {
+        table | summary.kind | summary.type_name | summary.prefix | summary.snapshot.count;
+        table | summary.snapshot.GetMeanNs() / 1e6;
+        table | summary.snapshot.GetQuantileNs(0.5) / 1e6;
+        table | summary.snapshot.GetQuantileNs(0.99) / 1e6;
+        table | summary.snapshot.max_ns / 1e6;
+    }
+    table.Render(os);
+}
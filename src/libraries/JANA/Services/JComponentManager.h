@@ -9,12 +9,20 @@
 #include <JANA/Services/JParameterManager.h>
 #include <JANA/Components/JComponentSummary.h>
 #include <JANA/Services/JServiceLocator.h>
+#include <JANA/Utils/JLatencyHistogram.h>
 
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <ostream>
+#include <tuple>
 
 class JEventProcessor;
 class JEventUnfolder;
 class JEventFolder;
+class JCallGraphSummary;
+class JExecutionEngine;
 
 class JComponentManager : public JService {
 public:
@@ -61,8 +69,33 @@ public:
 
     void ConfigureEvent(JEvent& event);
 
+    // Set once by JApplication before any events exist, so that factory subtasks never have to look it up themselves
+    void SetSubtaskEngine(JExecutionEngine* engine) { m_subtask_engine = engine; }
+
+    // Returns nullptr unless jana:call_graph_summary is set
+    JCallGraphSummary* GetCallGraphSummary();
+
+    struct LatencySummary {
+        std::string kind; // "Source", "Factory", or "Processor"
+        std::string type_name;
+        std::string prefix;
+        JLatencyHistogram::Snapshot snapshot;
+    };
+
+    bool IsLatencyHistogramsEnabled() const { return m_enable_latency_histograms; }
+
+    // Returns nullptr unless jana:latency_histograms is set. All components with the same kind, type name, and prefix
+    // (i.e. all pooled copies of the same factory) share one histogram.
+    JLatencyHistogram* GetLatencyHistogram(const std::string& kind, const std::string& type_name, const std::string& prefix);
+
+    // Safe to call while the topology is running. Ordered by total time spent.
+    std::vector<LatencySummary> GetLatencySummaries();
+    void PrintLatencySummaries(std::ostream& os);
+
 private:
 
+    const std::set<std::pair<std::string, std::string>>& GetPrunedFactories(JEventLevel level);
+
     Service<JParameterManager> m_params {this};
 
     std::string m_current_plugin_name;
@@ -76,6 +109,19 @@ private:
 
     std::map<std::string, std::string> m_default_tags;
     bool m_enable_call_graph_recording = false;
+    bool m_enable_call_graph_summary = false;
+    size_t m_call_graph_sampling_interval = 1;
+    size_t m_call_graph_buffer_size = 256;
+    std::unique_ptr<JCallGraphSummary> m_call_graph_summary;
+    bool m_enable_latency_histograms = false;
+    std::mutex m_latency_histograms_mutex;
+    std::map<std::tuple<std::string, std::string, std::string>, std::unique_ptr<JLatencyHistogram>> m_latency_histograms;
+    bool m_enable_factory_parallelism = false;
+    JExecutionEngine* m_subtask_engine = nullptr;
+    size_t m_event_arena_block_size = 64*1024;
+    bool m_prune_unreachable_factories = false;
+    std::mutex m_pruned_factories_mutex;
+    std::map<JEventLevel, std::set<std::pair<std::string, std::string>>> m_pruned_factories;
     std::string m_autoactivate;
 
     uint64_t m_nskip=0;
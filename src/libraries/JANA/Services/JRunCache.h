@@ -0,0 +1,86 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#pragma once
+#include <JANA/JService.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+
+/// JRunCache holds run-scoped data (calibrations, lookup tables, geometry) that would otherwise get computed
+/// separately by every pooled copy of a component. GetOrCompute() runs the computation once per (key, run number),
+/// and hands every caller a shared_ptr to the same immutable result. The cache itself only holds weak references,
+/// so a run's data gets freed as soon as the last component holding on to it moves on to a different run.
+///
+/// Most components should use JHasRunCallbacks::SharedResource instead of calling this directly.
+class JRunCache : public JService {
+
+    struct Entry {
+        std::mutex mutex;
+        std::weak_ptr<const void> data;
+    };
+
+    std::mutex m_mutex;
+    std::map<std::pair<std::string, int32_t>, std::shared_ptr<Entry>> m_entries;
+    size_t m_compute_count = 0;
+
+public:
+
+    template <typename T, typename F>
+    std::shared_ptr<const T> GetOrCompute(const std::string& key, int32_t run_nr, F&& compute) {
+
+        std::shared_ptr<Entry> entry;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // Forget about any entries whose data has been freed, so that the map doesn't grow with the number of runs
+            for (auto it = m_entries.begin(); it != m_entries.end();) {
+                if (it->second->data.expired() && it->second.use_count() == 1) {
+                    it = m_entries.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+            auto& slot = m_entries[{key, run_nr}];
+            if (slot == nullptr) {
+                slot = std::make_shared<Entry>();
+            }
+            entry = slot;
+        }
+
+        // Hold the entry's lock while computing, so that the other pooled components wait for our result instead of
+        // computing the same thing themselves. Computations for different keys or runs proceed independently.
+        std::lock_guard<std::mutex> lock(entry->mutex);
+        auto data = entry->data.lock();
+        if (data != nullptr) {
+            return std::static_pointer_cast<const T>(data);
+        }
+        auto result = std::make_shared<const T>(compute());
+        entry->data = result;
+        {
+            std::lock_guard<std::mutex> map_lock(m_mutex);
+            m_compute_count += 1;
+        }
+        return result;
+    }
+
+    /// Number of times GetOrCompute() actually ran a computation, rather than returning a cached result
+    size_t GetComputeCount() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_compute_count;
+    }
+
+    /// Number of (key, run number) pairs whose data is still held by at least one component
+    size_t GetLiveEntryCount() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t count = 0;
+        for (auto& it : m_entries) {
+            if (!it.second->data.expired()) count += 1;
+        }
+        return count;
+    }
+};
+
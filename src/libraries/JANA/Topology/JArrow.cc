@@ -6,7 +6,7 @@ JArrow::Port& JArrow::AddPort(std::string name, JEventLevel level, PortDirection
     if (m_port_lookup.find(name) != m_port_lookup.end()) {
         throw JException("Port with name '%s' already exists", name.c_str());
     }
-    auto port = std::make_unique<Port>(name, level);
+    auto port = std::make_unique<Port>(name, level, direction);
     auto port_raw_ptr = port.get();
     m_ports.push_back(std::move(port));
     m_port_lookup[name] = m_ports.size()-1;
@@ -40,7 +40,7 @@ JEvent* JArrow::Pull(size_t port_index, size_t location_id) {
 }
 
 
-void JArrow::Push(OutputData& outputs, size_t output_count, size_t location_id) {
+void JArrow::Push(OutputData& outputs, size_t output_count, size_t location_id, std::vector<JEventPool::AwaitingClear>* awaiting_clear) {
     for (size_t output = 0; output < output_count; ++output) {
         JEvent* event = outputs[output].first;
         int port_index = outputs[output].second;
@@ -49,8 +49,14 @@ void JArrow::Push(OutputData& outputs, size_t output_count, size_t location_id)
             port.GetQueue()->Push(event, location_id);
         }
         else if (port.GetPool() != nullptr) {
-            event->Clear(!port.GetSkipFinishEvent());
-            port.GetPool()->Ingest(event, location_id);
+            if (event->GetChildCount() == 0) {
+                event->Clear(!port.GetSkipFinishEvent());
+            }
+            else {
+                // Children may still be reading this event's data, so the pool clears it once they are all done
+                event->DeferClear(!port.GetSkipFinishEvent());
+            }
+            port.GetPool()->Ingest(event, location_id, awaiting_clear);
         }
         else {
             throw JException("Arrow %s: Port %s not wired!", m_name.c_str(), port.GetName().c_str());
@@ -3,6 +3,7 @@
 // Subject to the terms in the LICENSE file found in the top-level directory.
 
 #pragma once
+#include <atomic>
 #include <cassert>
 #include <vector>
 
@@ -25,19 +26,23 @@ public:
         std::vector<JEventLevel> m_levels;
         JEventQueue* m_queue = nullptr;
         JEventPool* m_pool = nullptr;
+        PortDirection m_direction = PortDirection::In;
         bool m_skip_finish_event = false;
         bool m_establishes_ordering = false;
         bool m_enforces_ordering = false;
 
     public:
-        Port(std::string name, std::vector<JEventLevel> levels): m_name(name), m_levels(levels) {};
+        Port(std::string name, std::vector<JEventLevel> levels, PortDirection direction=PortDirection::In)
+            : m_name(name), m_levels(levels), m_direction(direction) {};
 
-        Port(std::string name, JEventLevel level): m_name(name) {
+        Port(std::string name, JEventLevel level, PortDirection direction=PortDirection::In)
+            : m_name(name), m_direction(direction) {
             m_levels.push_back(level);
         };
 
         const std::string& GetName() { return m_name; }
         const std::vector<JEventLevel>& GetLevels() { return m_levels; }
+        PortDirection GetDirection() { return m_direction; }
         bool GetEstablishesOrdering() { return m_establishes_ordering; }
         bool GetEnforcesOrdering() { return m_enforces_ordering; }
         bool GetSkipFinishEvent() { return m_skip_finish_event; }
@@ -81,7 +86,7 @@ private:
 protected:
     using clock_t = std::chrono::steady_clock;
 
-    int m_next_input_port=0; // -1 denotes "no input necessary", e.g. for barrier events
+    std::atomic_int m_next_input_port {0}; // -1 denotes "no input necessary", e.g. for barrier events. Atomic because parallel arrows update it from Fire()
     clock_t::time_point m_next_visit_time=clock_t::now();
     std::vector<std::unique_ptr<Port>> m_ports;
     std::map<std::string, int> m_port_lookup;
@@ -104,7 +109,9 @@ public:
 
     JEvent* Pull(size_t input_port, size_t location_id);
 
-    void Push(OutputData& outputs, size_t output_count, size_t location_id);
+    /// If awaiting_clear is given, parents whose deferred Clear() became due are handed back through it instead of
+    /// being cleared and recycled right away. See JEventPool::Ingest()
+    void Push(OutputData& outputs, size_t output_count, size_t location_id, std::vector<JEventPool::AwaitingClear>* awaiting_clear=nullptr);
 
 
     const std::string& GetName() { return m_name; }
@@ -114,6 +121,7 @@ public:
     bool IsSource() { return m_is_source; }
     bool IsSink() { return m_is_sink; }
     int GetNextPortIndex() { return m_next_input_port; }
+    clock_t::time_point GetNextVisitTime() { return m_next_visit_time; }
 
     void SetName(std::string name) { m_name = name; }
     void SetId(int id) { m_id = id; }
@@ -121,8 +129,10 @@ public:
     void SetIsParallel(bool is_parallel) { m_is_parallel = is_parallel; }
     void SetIsSource(bool is_source) { m_is_source = is_source; }
     void SetIsSink(bool is_sink) { m_is_sink = is_sink; }
+    void SetNextVisitTime(clock_t::time_point next_visit_time) { m_next_visit_time = next_visit_time; }
 
     Port& AddPort(std::string port_name, JEventLevel level, PortDirection direction);
+    size_t GetPortCount() { return m_ports.size(); }
     Port& GetPort(size_t port_index) { return *m_ports.at(port_index); }
     Port& GetPort(JEventLevel level, PortDirection direction) { return *m_ports.at(m_auto_port_lookup.at({level, direction})); }
 
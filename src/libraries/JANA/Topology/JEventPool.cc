@@ -5,6 +5,7 @@
 #include "JANA/JEvent.h"
 #include "JANA/Utils/JEventLevel.h"
 #include <JANA/Topology/JEventPool.h>
+#include <algorithm>
 
 
 JEventPool::JEventPool(std::shared_ptr<JComponentManager> component_manager,
@@ -45,12 +46,8 @@ void JEventPool::Scale(size_t capacity) {
         return;
     }
 
-    // Resize queues to fit new capacity
-    m_capacity = capacity;
-    for (auto& local_queue: m_local_queues) {
-        local_queue->ringbuffer.resize(capacity, nullptr);
-        local_queue->capacity = capacity;
-    }
+    // Resize queues to fit new capacity. Any events already in the pool stay put.
+    Resize(capacity);
 
     // Create new JEvents, add to owned_events, and distribute to queues
     m_owned_events.reserve(capacity);
@@ -64,14 +61,14 @@ void JEventPool::Scale(size_t capacity) {
     }
 }
 
-void JEventPool::Ingest(JEvent* event, size_t location) {
+void JEventPool::Ingest(JEvent* event, size_t location, std::vector<AwaitingClear>* awaiting_clear) {
 
     // Check if event even belongs here. If not, forward to the correct pool
     // This is necessary for interleaved events
     auto incoming_event_level = event->GetLevel();
     if (incoming_event_level != m_level) {
         //LOG << "Pool " << toString(m_level) << " forwarding event " << event->GetEventNumber() << " to parent pool " << toString(event->GetLevel());
-        m_parent_pools.at(incoming_event_level)->Ingest(event, location);
+        m_parent_pools.at(incoming_event_level)->Ingest(event, location, awaiting_clear);
         return;
     }
 
@@ -80,14 +77,14 @@ void JEventPool::Ingest(JEvent* event, size_t location) {
     // TODO: I'd prefer to not have to do an allocation each time, but this will work for now
     for (auto* parent : finished_parents) {
         //LOG << "JEventPool::Ingest: Found finished parent of level " << toString(parent->GetLevel());
-        m_parent_pools.at(parent->GetLevel())->NotifyThatAllChildrenFinished(parent, location);
+        m_parent_pools.at(parent->GetLevel())->NotifyThatAllChildrenFinished(parent, location, awaiting_clear);
         // TODO: This is likely the wrong location. Obtain from parent event?
     }
 
     if (event->GetChildCount() == 0) {
         // There's no way for additional children to appear because Ingest takes the "original" parent
         //LOG << "JEventPool::Ingest: " << toString(m_level) << " event is pushed";
-        Push(event, location);
+        Recycle(event, location, awaiting_clear);
     }
     else {
         // We've received the original but we can't push it until all children have been pushed to 
@@ -98,15 +95,24 @@ void JEventPool::Ingest(JEvent* event, size_t location) {
 }
 
 
-void JEventPool::NotifyThatAllChildrenFinished(JEvent* event, size_t location) {
+void JEventPool::NotifyThatAllChildrenFinished(JEvent* event, size_t location, std::vector<AwaitingClear>* awaiting_clear) {
     //LOG << "JEventPool::Notify called for level " << toString(m_level);
     size_t was_present = m_pending.erase(event);
     if (was_present == 1) {
-        Push(event, location);
+        Recycle(event, location, awaiting_clear);
         //LOG << "JEventPool at level " << toString(m_level) << " has pushed a parent event";
     }
 }
 
+void JEventPool::Recycle(JEvent* event, size_t location, std::vector<AwaitingClear>* awaiting_clear) {
+    if (awaiting_clear != nullptr && event->IsClearDeferred()) {
+        awaiting_clear->push_back({this, event, location});
+        return;
+    }
+    event->ClearIfDeferred();
+    Push(event, location);
+}
+
 
 void JEventPool::Finalize() {
     for (auto& evt : m_owned_events) {
@@ -114,4 +120,16 @@ void JEventPool::Finalize() {
     }
 }
 
+size_t JEventPool::GetArenaHighWaterMark() const {
+    return GetArenaHighWaterMark(m_owned_events);
+}
+
+size_t JEventPool::GetArenaHighWaterMark(const std::vector<std::shared_ptr<JEvent>>& events) {
+    size_t high_water_mark = 0;
+    for (auto& evt : events) {
+        high_water_mark = std::max(high_water_mark, evt->GetFactorySet()->GetArena().GetHighWaterMark());
+    }
+    return high_water_mark;
+}
+
 
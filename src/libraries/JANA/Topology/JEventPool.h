@@ -11,6 +11,15 @@
 
 
 class JEventPool : public JEventQueue {
+public:
+    /// A parent event whose last child has been released, but which still needs its deferred Clear() before it can
+    /// go back into `pool`. Nobody else can reach it in the meantime.
+    struct AwaitingClear {
+        JEventPool* pool;
+        JEvent* event;
+        size_t location;
+    };
+
 private:
     std::map<JEventLevel, JEventPool*> m_parent_pools;
     std::unordered_set<JEvent*> m_pending;
@@ -30,12 +39,29 @@ public:
 
     void Scale(size_t capacity);
 
-    void Ingest(JEvent* event, size_t location);
+    JEventLevel GetLevel() const { return m_level; }
+
+    /// Every event in the pool has the same factories, so this is handy for inspecting them before anything is in flight
+    const JEvent& GetSampleEvent() const { return *m_owned_events.at(0); }
+
+    /// Clearing a parent whose clear was deferred can take as long as processing it, so a caller holding a lock can pass
+    /// awaiting_clear to do that afterwards: it runs ClearIfDeferred() on each entry and then pushes it into its pool.
+    /// Otherwise the parent is cleared and recycled right here.
+    void Ingest(JEvent* event, size_t location, std::vector<AwaitingClear>* awaiting_clear=nullptr);
 
-    void NotifyThatAllChildrenFinished(JEvent* event, size_t location);
+    void NotifyThatAllChildrenFinished(JEvent* event, size_t location, std::vector<AwaitingClear>* awaiting_clear=nullptr);
 
     void Finalize();
 
+    /// Largest number of bytes any single event in this pool has needed from its JArena so far
+    size_t GetArenaHighWaterMark() const;
+
+    /// Largest number of bytes any one of these events has needed from its JArena so far. Shared with JLockFreeEventPool.
+    static size_t GetArenaHighWaterMark(const std::vector<std::shared_ptr<JEvent>>& events);
+
+private:
+    void Recycle(JEvent* event, size_t location, std::vector<AwaitingClear>* awaiting_clear);
+
 };
 
 
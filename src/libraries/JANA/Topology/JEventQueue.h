@@ -19,9 +19,9 @@
 // - Locality-aware, so that events that live in one location (e.g. NUMA domain) can stay within that location
 // - NOT thread-safe, because all queue accesses are protected by the JExecutionEngine mutex.
 //
-// - Previous versions of JEventQueue have allowed work stealing (taking events out of a different 
-//   NUMA domain when none are otherwise available). The current version does not, though we may
-//   bring this feature back later.
+// - Optionally allows work stealing (taking events out of a different location when none are available
+//   locally). Stealing is enabled by providing a steal order, so that each location tries its nearest
+//   neighbors first. See JProcessorMapping::get_neighbor_locs().
 //
 /// To handle memory locality at different granularities, we introduce the concept of a location.
 /// Each thread belongs to exactly one location, represented by contiguous unsigned
@@ -53,6 +53,11 @@ protected:
     int m_min_index = 0;
     int m_max_index = 0;
 
+    // Stealing state
+    std::vector<std::vector<size_t>> m_steal_order; // For each location, the other locations to try, nearest first. Empty disables stealing.
+    size_t m_pop_count = 0;
+    size_t m_stolen_count = 0;
+
 public:
     inline JEventQueue(size_t initial_capacity, size_t locations_count) {
 
@@ -82,6 +87,25 @@ public:
         return m_enforces_ordering;
     }
 
+    void SetStealOrder(std::vector<std::vector<size_t>> steal_order) {
+        assert(steal_order.empty() || steal_order.size() == m_local_queues.size());
+        m_steal_order = std::move(steal_order);
+    }
+
+    bool GetIsStealingEnabled() const {
+        return !m_steal_order.empty();
+    }
+
+    /// Number of events popped from this queue so far, including stolen ones
+    size_t GetPopCount() const {
+        return m_pop_count;
+    }
+
+    /// Number of events popped from a location other than the one requested
+    size_t GetStolenCount() const {
+        return m_stolen_count;
+    }
+
     virtual void Scale(size_t capacity) {
         if (capacity < m_capacity) {
             for (auto& local_queue : m_local_queues) {
@@ -90,14 +114,44 @@ public:
                 }
             }
         }
-        m_capacity = capacity;
-        m_max_index = capacity - 1; // zero-indexed
+        Resize(capacity);
+    }
+
+protected:
+    /// Changes the capacity while preserving any events that are already in the queue, along with their order.
+    /// This lets us grow the queue while the topology is running (e.g. from JExecutionEngine::ScaleInflightEvents),
+    /// as long as the caller holds the JExecutionEngine mutex.
+    void Resize(size_t capacity) {
+        std::vector<JEvent*> slots;
+        if (m_enforces_ordering) {
+            // Ordered queues use m_local_queues[0] as an associative array keyed off of event index modulo
+            // capacity, so each pending event has to move to its new slot.
+            slots.resize(capacity, nullptr);
+            for (JEvent* event : m_local_queues[0]->ringbuffer) {
+                if (event != nullptr) {
+                    slots[event->GetEventIndex() % capacity] = event;
+                }
+            }
+        }
         for (auto& local_queue: m_local_queues) {
-            local_queue->ringbuffer.resize(capacity, nullptr);
+            std::vector<JEvent*> ringbuffer(capacity, nullptr);
+            for (size_t i=0; i<local_queue->size; ++i) {
+                ringbuffer[i] = local_queue->ringbuffer[(local_queue->back + i) % local_queue->capacity];
+            }
+            local_queue->ringbuffer = std::move(ringbuffer);
             local_queue->capacity = capacity;
+            local_queue->back = 0;
+            local_queue->front = (capacity == 0) ? 0 : local_queue->size % capacity;
         }
+        if (m_enforces_ordering) {
+            m_local_queues[0]->ringbuffer = std::move(slots);
+        }
+        m_capacity = capacity;
+        m_next_slot = (capacity == 0) ? 0 : m_min_index % capacity;
+        m_max_index = m_min_index + (int) capacity - 1; // zero-indexed
     }
 
+public:
     inline size_t GetLocationCount() {
         return m_local_queues.size();
     }
@@ -135,6 +189,7 @@ public:
                 throw JException("Collision when pushing to ordered queue. slot=%lu", slot);
             }
             buffer[slot] = event;
+            m_local_queues[0]->size += 1; // Counts pending events, including ones that can't be popped yet
         }
         else {
             // Use local_queue as intended
@@ -161,6 +216,8 @@ public:
                 return nullptr;
             }
             buffer[m_next_slot] = nullptr;
+            m_local_queues[0]->size -= 1;
+            m_pop_count += 1;
             m_min_index += 1;
             m_max_index += 1;
             m_next_slot += 1;
@@ -168,18 +225,35 @@ public:
             return event;
         }
         else {
-            auto& local_queue= *m_local_queues[location];
-            if (local_queue.size == 0) {
-                return nullptr;
+            JEvent* result = PopLocal(*m_local_queues[location]);
+            if (result == nullptr && !m_steal_order.empty()) {
+                for (size_t victim : m_steal_order[location]) {
+                    result = PopLocal(*m_local_queues[victim]);
+                    if (result != nullptr) {
+                        m_stolen_count += 1;
+                        break;
+                    }
+                }
+            }
+            if (result != nullptr) {
+                m_pop_count += 1;
             }
-            JEvent* result = local_queue.ringbuffer[local_queue.back];
-            local_queue.ringbuffer[local_queue.back] = nullptr;
-            local_queue.back = (local_queue.back + 1) % local_queue.capacity;
-            local_queue.size -= 1;
             return result;
         }
     };
 
+private:
+    inline JEvent* PopLocal(LocalQueue& local_queue) {
+        if (local_queue.size == 0) {
+            return nullptr;
+        }
+        JEvent* result = local_queue.ringbuffer[local_queue.back];
+        local_queue.ringbuffer[local_queue.back] = nullptr;
+        local_queue.back = (local_queue.back + 1) % local_queue.capacity;
+        local_queue.size -= 1;
+        return result;
+    }
+
 };
 
 
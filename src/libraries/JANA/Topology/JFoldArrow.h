@@ -34,6 +34,8 @@ public:
 
     void SetFolder(JEventFolder* folder) {
         m_folder = folder;
+        // Commutative folders don't care which order the children show up in, so we don't make them wait
+        GetPort(CHILD_IN).SetEnforcesOrdering(!folder->IsCommutativeFoldEnabled());
     }
 
     void Initialize() final {
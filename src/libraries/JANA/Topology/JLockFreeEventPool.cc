@@ -0,0 +1,55 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#include <JANA/Topology/JLockFreeEventPool.h>
+#include <JANA/Topology/JEventPool.h>
+
+
+JLockFreeEventPool::JLockFreeEventPool(std::shared_ptr<JComponentManager> component_manager,
+                                       size_t max_inflight_events,
+                                       size_t location_count,
+                                       JEventLevel level)
+        : JLockFreeEventQueue(0, location_count)
+        , m_component_manager(component_manager)
+        , m_level(level) {
+
+    Scale(max_inflight_events);
+}
+
+void JLockFreeEventPool::Scale(size_t capacity) {
+    auto old_capacity = m_owned_events.size();
+    if (capacity <= old_capacity) {
+        return; // See JEventPool::Scale for why we never shrink
+    }
+
+    // Resize queues to fit new capacity. Any events already in the pool stay put.
+    Resize(capacity);
+
+    // Create new JEvents, add to owned_events, and distribute to queues
+    m_owned_events.reserve(capacity);
+    for (size_t evt_idx=old_capacity; evt_idx<capacity; evt_idx++) {
+        m_owned_events.push_back(std::make_shared<JEvent>());
+        auto evt = &m_owned_events.back();
+        (*evt)->SetLevel(m_level); // Level needs to be set before factories get added in configure_event
+        m_component_manager->ConfigureEvent(**evt);
+        Push(evt->get(), evt_idx % GetLocationCount());
+    }
+}
+
+void JLockFreeEventPool::Ingest(JEvent* event, size_t location) {
+    if (event->GetLevel() != m_level || event->GetChildCount() != 0) {
+        throw JException("JLockFreeEventPool doesn't support multilevel topologies. Use JEventPool instead.");
+    }
+    Push(event, location);
+}
+
+void JLockFreeEventPool::Finalize() {
+    for (auto& evt : m_owned_events) {
+        evt->Finish();
+    }
+}
+
+
+size_t JLockFreeEventPool::GetArenaHighWaterMark() const {
+    return JEventPool::GetArenaHighWaterMark(m_owned_events);
+}
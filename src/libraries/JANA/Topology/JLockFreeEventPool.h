@@ -0,0 +1,40 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#pragma once
+
+#include <JANA/Topology/JLockFreeEventQueue.h>
+#include <JANA/Services/JComponentManager.h>
+#include <vector>
+
+
+/// JLockFreeEventPool is the JLockFreeEventQueue counterpart of JEventPool's free list. Any thread may take a
+/// free event via Pop(location) and return it via Ingest() without holding the JExecutionEngine mutex.
+/// It only supports single-level topologies, since returning parents when their last child finishes
+/// needs JEventPool's pending set.
+class JLockFreeEventPool : public JLockFreeEventQueue {
+private:
+    std::vector<std::shared_ptr<JEvent>> m_owned_events;
+    std::shared_ptr<JComponentManager> m_component_manager;
+    JEventLevel m_level;
+
+public:
+    JLockFreeEventPool(std::shared_ptr<JComponentManager> component_manager,
+                       size_t max_inflight_events,
+                       size_t location_count,
+                       JEventLevel level = JEventLevel::PhysicsEvent);
+
+    /// Grows the pool. Like JEventPool, this never shrinks it. NOT thread-safe.
+    void Scale(size_t capacity) override;
+
+    JEventLevel GetLevel() const { return m_level; }
+
+    void Ingest(JEvent* event, size_t location);
+
+    void Finalize();
+
+    /// Largest number of bytes any single event in this pool has needed from its JArena so far
+    size_t GetArenaHighWaterMark() const;
+};
+
+
@@ -0,0 +1,322 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#pragma once
+#include <JANA/Utils/JCpuInfo.h>
+#include <JANA/JEvent.h>
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// JLockFreeEventQueue is a thread-safe drop-in for JEventQueue, with the same Push()/Pop(location) API,
+// locality, stealing, and ordering features. Any number of threads may push and pop concurrently
+// without holding the JExecutionEngine mutex, which makes it the building block for a less centralized scheduler.
+//
+// - Each location gets its own bounded MPMC ringbuffer, following Dmitry Vyukov's design: every cell carries
+//   a sequence number which tells producers and consumers whose turn it is, so the only contended
+//   operations are a CAS on the enqueue or dequeue position. Nothing is allocated during processing.
+// - The ringbuffer capacity is rounded up to the next power of two. Because the number of events in flight is
+//   bounded by the event pools, Push() still throws if a location is ever full, just like JEventQueue.
+// - Pop() may briefly miss an event whose producer has claimed a cell but not yet published it. Callers
+//   already have to cope with empty queues, so this is harmless.
+// - Ordered queues use a slot array keyed off of event index modulo capacity. A consumer claims the next
+//   event by swapping its slot back to nullptr, and only then advances the next index, so a slot is always
+//   empty by the time an event that maps to it is allowed in.
+// - Scale() is NOT thread-safe. Only call it while nobody else is using the queue.
+// - GetSize() is approximate while other threads are pushing or popping.
+
+class JLockFreeEventQueue {
+
+protected:
+    struct Cell {
+        std::atomic<size_t> sequence {0};
+        std::atomic<JEvent*> event {nullptr};
+    };
+
+    struct alignas(JANA2_CACHE_LINE_BYTES) LocalQueue {
+        alignas(JANA2_CACHE_LINE_BYTES) std::atomic<size_t> enqueue_pos {0};
+        alignas(JANA2_CACHE_LINE_BYTES) std::atomic<size_t> dequeue_pos {0};
+        alignas(JANA2_CACHE_LINE_BYTES) std::unique_ptr<Cell[]> cells;
+        size_t mask = 0;
+    };
+
+    std::vector<std::unique_ptr<LocalQueue>> m_local_queues;
+    size_t m_capacity = 0;
+
+    // Order-establishing state
+    bool m_establishes_ordering = false;
+    alignas(JANA2_CACHE_LINE_BYTES) std::atomic<int64_t> m_next_event_index {0};
+
+    // Order-enforcing state
+    bool m_enforces_ordering = false;
+    std::unique_ptr<std::atomic<JEvent*>[]> m_slots;
+    alignas(JANA2_CACHE_LINE_BYTES) std::atomic<int64_t> m_min_index {0};
+    std::atomic<size_t> m_pending_count {0};
+
+    // Stealing state
+    std::vector<std::vector<size_t>> m_steal_order; // For each location, the other locations to try, nearest first. Empty disables stealing.
+    alignas(JANA2_CACHE_LINE_BYTES) std::atomic<size_t> m_pop_count {0};
+    std::atomic<size_t> m_stolen_count {0};
+
+public:
+    inline JLockFreeEventQueue(size_t initial_capacity, size_t locations_count) {
+
+        assert(locations_count >= 1);
+        for (size_t location=0; location<locations_count; ++location) {
+            m_local_queues.push_back(std::make_unique<LocalQueue>());
+        }
+        Scale(initial_capacity);
+    }
+
+    virtual ~JLockFreeEventQueue() = default;
+
+
+    void SetEstablishesOrdering(bool establishes_ordering=true) {
+        m_establishes_ordering = establishes_ordering;
+    }
+
+    void SetEnforcesOrdering(bool enforces_ordering=true) {
+        m_enforces_ordering = enforces_ordering;
+        Resize(m_capacity);
+    }
+
+    bool GetEstablishesOrdering() const {
+        return m_establishes_ordering;
+    }
+
+    bool GetEnforcesOrdering() const {
+        return m_enforces_ordering;
+    }
+
+    void SetStealOrder(std::vector<std::vector<size_t>> steal_order) {
+        assert(steal_order.empty() || steal_order.size() == m_local_queues.size());
+        m_steal_order = std::move(steal_order);
+    }
+
+    bool GetIsStealingEnabled() const {
+        return !m_steal_order.empty();
+    }
+
+    /// Number of events popped from this queue so far, including stolen ones
+    size_t GetPopCount() const {
+        return m_pop_count.load(std::memory_order_relaxed);
+    }
+
+    /// Number of events popped from a location other than the one requested
+    size_t GetStolenCount() const {
+        return m_stolen_count.load(std::memory_order_relaxed);
+    }
+
+    virtual void Scale(size_t capacity) {
+        if (capacity < m_capacity) {
+            for (size_t location=0; location<m_local_queues.size(); ++location) {
+                if (GetSize(location) != 0) {
+                    throw JException("Attempted to shrink a non-empty JLockFreeEventQueue. Please drain the topology before attempting to downscale.");
+                }
+            }
+        }
+        Resize(capacity);
+    }
+
+protected:
+    /// Changes the capacity while preserving any events that are already in the queue, along with their order.
+    /// Unlike everything else, this is NOT thread-safe.
+    void Resize(size_t capacity) {
+
+        // Drain everything that is currently queued
+        std::vector<std::vector<JEvent*>> contents(m_local_queues.size());
+        for (size_t location=0; location<m_local_queues.size(); ++location) {
+            auto& local_queue = *m_local_queues[location];
+            if (local_queue.cells == nullptr) {
+                continue; // Called from the constructor
+            }
+            for (JEvent* event = PopLocal(local_queue); event != nullptr; event = PopLocal(local_queue)) {
+                contents[location].push_back(event);
+            }
+        }
+        std::vector<JEvent*> pending;
+        for (size_t i=0; m_slots != nullptr && i<m_capacity; ++i) {
+            JEvent* event = m_slots[i].load(std::memory_order_relaxed);
+            if (event != nullptr) {
+                pending.push_back(event);
+            }
+        }
+
+        // Vyukov's algorithm needs at least two cells, and a power of two lets us mask instead of mod
+        size_t cell_count = 2;
+        while (cell_count < capacity) cell_count <<= 1;
+
+        for (auto& local_queue : m_local_queues) {
+            local_queue->cells = std::unique_ptr<Cell[]>(new Cell[cell_count]);
+            local_queue->mask = cell_count - 1;
+            for (size_t i=0; i<cell_count; ++i) {
+                local_queue->cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            local_queue->enqueue_pos.store(0, std::memory_order_relaxed);
+            local_queue->dequeue_pos.store(0, std::memory_order_relaxed);
+        }
+        m_capacity = capacity;
+
+        if (m_enforces_ordering) {
+            m_slots = std::unique_ptr<std::atomic<JEvent*>[]>(new std::atomic<JEvent*>[capacity]);
+            for (size_t i=0; i<capacity; ++i) {
+                m_slots[i].store(nullptr, std::memory_order_relaxed);
+            }
+            for (JEvent* event : pending) {
+                m_slots[event->GetEventIndex() % capacity].store(event, std::memory_order_relaxed);
+            }
+        }
+        else {
+            m_slots = nullptr;
+        }
+
+        for (size_t location=0; location<m_local_queues.size(); ++location) {
+            for (JEvent* event : contents[location]) {
+                PushLocal(*m_local_queues[location], event);
+            }
+        }
+    }
+
+public:
+    inline size_t GetLocationCount() {
+        return m_local_queues.size();
+    }
+
+    inline size_t GetSize(size_t location) {
+        if (m_enforces_ordering) {
+            return (location == 0) ? m_pending_count.load(std::memory_order_relaxed) : 0;
+        }
+        auto& local_queue = *m_local_queues[location];
+        size_t dequeue_pos = local_queue.dequeue_pos.load(std::memory_order_relaxed);
+        size_t enqueue_pos = local_queue.enqueue_pos.load(std::memory_order_relaxed);
+        return (enqueue_pos > dequeue_pos) ? enqueue_pos - dequeue_pos : 0;
+    }
+
+    inline size_t GetCapacity() {
+        return m_capacity;
+    }
+
+    inline void Push(JEvent* event, size_t location) {
+
+        if (m_establishes_ordering) {
+            event->SetEventIndex(m_next_event_index.fetch_add(1, std::memory_order_relaxed));
+        }
+
+        if (m_enforces_ordering) {
+            auto index = event->GetEventIndex();
+            auto min_index = m_min_index.load(std::memory_order_acquire);
+            if (min_index + (int64_t) m_capacity <= index) {
+                throw JException("Event index=%lu is above max=%lu", index, min_index + m_capacity - 1);
+            }
+            if (min_index > index) {
+                throw JException("Event index=%lu is below min=%lu", index, min_index);
+            }
+            size_t slot = index % m_capacity;
+            JEvent* expected = nullptr;
+            if (!m_slots[slot].compare_exchange_strong(expected, event, std::memory_order_release, std::memory_order_relaxed)) {
+                throw JException("Collision when pushing to ordered queue. slot=%lu", slot);
+            }
+            m_pending_count.fetch_add(1, std::memory_order_relaxed);
+        }
+        else if (!PushLocal(*m_local_queues[location], event)) {
+            throw JException("Attempted to push to a full JLockFreeEventQueue. This probably means there is an error in your topology wiring");
+        }
+    }
+
+    inline JEvent* Pop(size_t location) {
+        if (m_enforces_ordering) {
+            auto index = m_min_index.load(std::memory_order_acquire);
+            auto& slot = m_slots[index % m_capacity];
+            JEvent* event = slot.load(std::memory_order_acquire);
+
+            // The slot may already hold a later event if another consumer got here first
+            if (event == nullptr || event->GetEventIndex() != index) {
+                return nullptr;
+            }
+            if (!slot.compare_exchange_strong(event, nullptr, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            m_min_index.store(index + 1, std::memory_order_release);
+            m_pending_count.fetch_sub(1, std::memory_order_relaxed);
+            m_pop_count.fetch_add(1, std::memory_order_relaxed);
+            return event;
+        }
+        else {
+            JEvent* result = PopLocal(*m_local_queues[location]);
+            if (result == nullptr && !m_steal_order.empty()) {
+                for (size_t victim : m_steal_order[location]) {
+                    result = PopLocal(*m_local_queues[victim]);
+                    if (result != nullptr) {
+                        m_stolen_count.fetch_add(1, std::memory_order_relaxed);
+                        break;
+                    }
+                }
+            }
+            if (result != nullptr) {
+                m_pop_count.fetch_add(1, std::memory_order_relaxed);
+            }
+            return result;
+        }
+    }
+
+private:
+    inline bool PushLocal(LocalQueue& local_queue, JEvent* event) {
+        size_t pos = local_queue.enqueue_pos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &local_queue.cells[pos & local_queue.mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (local_queue.enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                // The cell is still being read by a consumer which claimed it a full lap ago. That only
+                // means we are full if the consumers really are a full lap behind; otherwise wait for it.
+                if (pos - local_queue.dequeue_pos.load(std::memory_order_acquire) > local_queue.mask) {
+                    return false;
+                }
+                std::this_thread::yield();
+                pos = local_queue.enqueue_pos.load(std::memory_order_relaxed);
+            }
+            else {
+                pos = local_queue.enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->event.store(event, std::memory_order_relaxed);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    inline JEvent* PopLocal(LocalQueue& local_queue) {
+        size_t pos = local_queue.dequeue_pos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &local_queue.cells[pos & local_queue.mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (local_queue.dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                return nullptr; // Empty
+            }
+            else {
+                pos = local_queue.dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        JEvent* event = cell->event.load(std::memory_order_relaxed);
+        cell->sequence.store(pos + local_queue.mask + 1, std::memory_order_release);
+        return event;
+    }
+};
+
+
@@ -7,7 +7,9 @@
 
 #include <JANA/JEventSource.h>
 #include <JANA/JEventUnfolder.h>
+#include <JANA/JEventFolder.h>
 #include <JANA/JEvent.h>
+#include <JANA/Utils/JLatencyHistogram.h>
 
 
 JMapArrow::JMapArrow(std::string name, JEventLevel level) {
@@ -33,26 +35,84 @@ void JMapArrow::AddProcessor(JEventProcessor* processor) {
     m_procs.push_back(processor);
 }
 
+void JMapArrow::SetEagerPrefetch(bool enable) {
+    m_enable_eager_prefetch = enable;
+}
+
+std::vector<jana::components::JHasInputs*> JMapArrow::GetConsumers() const {
+    std::vector<jana::components::JHasInputs*> consumers;
+    consumers.insert(consumers.end(), m_unfolders.begin(), m_unfolders.end());
+    consumers.insert(consumers.end(), m_folders.begin(), m_folders.end());
+    consumers.insert(consumers.end(), m_procs.begin(), m_procs.end());
+    return consumers;
+}
+
+void JMapArrow::Prefetch(const JEvent& event) {
+
+    auto* facset = event.GetFactorySet();
+    auto& factories = facset->GetAllFactories();
+
+    std::call_once(m_prefetch_plan_flag, [&](){
+        std::map<JFactory*, size_t> indices;
+        for (size_t i=0; i<factories.size(); ++i) {
+            indices[factories[i]] = i;
+        }
+        for (auto& wave : facset->GetUpstreamWaves(GetConsumers())) {
+            m_prefetch_plan.emplace_back();
+            for (auto* factory : wave) {
+                m_prefetch_plan.back().push_back(indices.at(factory));
+            }
+        }
+        m_prefetch_factory_count = factories.size();
+    });
+
+    if (factories.size() != m_prefetch_factory_count) {
+        // Somebody's JFactoryGenerator doesn't produce the same factories every time, so we can't reuse the plan
+        for (auto& wave : facset->GetUpstreamWaves(GetConsumers())) {
+            jana::components::CreateFactoriesConcurrently(event, wave);
+        }
+        return;
+    }
+    std::vector<JFactory*> wave_factories;
+    for (auto& wave : m_prefetch_plan) {
+        wave_factories.clear();
+        for (size_t index : wave) {
+            wave_factories.push_back(factories[index]);
+        }
+        jana::components::CreateFactoriesConcurrently(event, wave_factories);
+    }
+}
+
 void JMapArrow::Fire(JEvent* event, OutputData& outputs, size_t& output_count, JArrow::FireResult& status) {
 
     LOG_DEBUG(m_logger) << "Executing arrow " << GetName() << " for event# " << event->GetEventNumber() << LOG_END;
     if (m_parallel_source) {
         auto* source = event->GetJEventSource();
         if (source != nullptr) {
-            JCallGraphEntryMaker cg_entry(*event->GetJCallGraphRecorder(), source->GetTypeName()); // times execution until this goes out of scope
+            JCallGraphEntryMaker cg_entry(*event->GetJCallGraphRecorder(), source->GetTypeName(), source); // times execution until this goes out of scope
             event->GetJEventSource()->ProcessParallel(*event);
         }
     }
+    if (m_enable_eager_prefetch) {
+        Prefetch(*event);
+    }
     for (JEventUnfolder* unfolder : m_unfolders) {
-        JCallGraphEntryMaker cg_entry(*event->GetJCallGraphRecorder(), unfolder->GetTypeName()); // times execution until this goes out of scope
+        JCallGraphEntryMaker cg_entry(*event->GetJCallGraphRecorder(), unfolder->GetTypeName(), unfolder); // times execution until this goes out of scope
         unfolder->DoPreprocess(*event);
     }
+    for (JEventFolder* folder : m_folders) {
+        JCallGraphEntryMaker cg_entry(*event->GetJCallGraphRecorder(), folder->GetTypeName(), folder); // times execution until this goes out of scope
+        folder->DoPreprocess(*event);
+    }
     for (JEventProcessor* processor : m_procs) {
-        JCallGraphEntryMaker cg_entry(*event->GetJCallGraphRecorder(), processor->GetTypeName()); // times execution until this goes out of scope
+        JCallGraphEntryMaker cg_entry(*event->GetJCallGraphRecorder(), processor->GetTypeName(), processor); // times execution until this goes out of scope
         if (processor->GetCallbackStyle() == JEventProcessor::CallbackStyle::LegacyMode) {
+            JLatencyHistogram::SelfTimer latency_timer(processor->GetLatencyHistogram());
             processor->DoLegacyProcess(event->shared_from_this());
         }
         else {
+            // ProcessSequential is recorded separately by JTapArrow, under "Processor"
+            JLatencyHistogram::SelfTimer latency_timer(processor->GetParallelLatencyHistogram());
             processor->DoMap(*event);
         }
     }
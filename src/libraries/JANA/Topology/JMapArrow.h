@@ -4,6 +4,7 @@
 #pragma once
 
 #include <JANA/Topology/JArrow.h>
+#include <mutex>
 
 class JEventPool;
 class JEventSource;
@@ -11,6 +12,8 @@ class JEventUnfolder;
 class JEventFolder;
 class JEventProcessor;
 class JEvent;
+class JFactory;
+namespace jana::components { struct JHasInputs; }
 
 
 class JMapArrow : public JArrow {
@@ -24,6 +27,14 @@ private:
     std::vector<JEventFolder*> m_folders;
     std::vector<JEventProcessor*> m_procs;
 
+    // Eager prefetch: Create every factory our components need, wave by wave, before running the components themselves.
+    // The plan is computed from the first event and stored as indices into its JFactorySet, since every event of a
+    // given level has the same factories in the same order.
+    bool m_enable_eager_prefetch = false;
+    std::once_flag m_prefetch_plan_flag;
+    std::vector<std::vector<size_t>> m_prefetch_plan;
+    size_t m_prefetch_factory_count = 0;
+
 public:
     JMapArrow(std::string name, JEventLevel level);
 
@@ -31,8 +42,13 @@ public:
     void AddUnfolder(JEventUnfolder* unfolder);
     void AddFolder(JEventFolder* folder);
     void AddProcessor(JEventProcessor* proc);
+    void SetEagerPrefetch(bool enable);
+
+    std::vector<jana::components::JHasInputs*> GetConsumers() const;
+    const std::vector<std::vector<size_t>>& GetPrefetchPlan() const { return m_prefetch_plan; }
 
     void Fire(JEvent* input, OutputData& outputs, size_t& output_count, JArrow::FireResult& status);
+    void Prefetch(const JEvent& event);
 
     void Initialize() final;
     void Finalize() final;
@@ -65,6 +65,13 @@ void JMultilevelSourceArrow::Fire(JEvent* input, OutputData& outputs, size_t& ou
         if (result == JEventSource::Result::Success) {
             // We have a newly filled event we have to do something with
 
+            // Every new parent, e.g. a SlowControls event, starts a new epoch. Unlike barrier events, this never drains the
+            // topology, because each child holds on to the parents from its own epoch
+            if (input->GetLevel() != m_child_event_level) {
+                m_epoch += 1;
+            }
+            input->SetEpoch(m_epoch);
+
             if (input->GetLevel() == m_child_event_level) {
                 // We acquired a child! Attach it to its parents and push it into the big wide world
 
@@ -12,6 +12,7 @@ private:
 
     std::unordered_map<JEventLevel, std::pair<JEvent*, size_t>> m_pending_parents;
     bool m_finish_in_progress = false;
+    uint64_t m_epoch = 0;
 
 private:
     void EvictNextParent(OutputData& outputs, size_t& output_count);
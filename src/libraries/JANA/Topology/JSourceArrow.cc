@@ -6,6 +6,7 @@
 #include <JANA/JApplication.h>
 #include <JANA/JEventSource.h>
 #include <JANA/Topology/JSourceArrow.h>
+#include <JANA/Utils/JLatencyHistogram.h>
 
 
 
@@ -93,8 +94,24 @@ void JSourceArrow::Fire(JEvent* event, OutputData& outputs, size_t& output_count
 
     while (m_current_source < m_sources.size()) {
 
+        // Only successful emits go into the latency histogram, because polling for data that isn't there yet isn't latency
+        auto* latency_histogram = m_sources[m_current_source]->GetLatencyHistogram();
+        auto start_time = (latency_histogram == nullptr) ? std::chrono::steady_clock::time_point() : std::chrono::steady_clock::now();
+
         auto source_status = m_sources[m_current_source]->DoNext(event->shared_from_this());
 
+        if (latency_histogram != nullptr && source_status == JEventSource::Result::Success) {
+            auto duration = std::chrono::steady_clock::now() - start_time;
+            latency_histogram->Record(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+        }
+        if (source_status == JEventSource::Result::Success) {
+            // A barrier event starts a new epoch, which includes the barrier event itself
+            if (event->GetSequential()) {
+                m_epoch += 1;
+            }
+            event->SetEpoch(m_epoch);
+        }
+
         if (source_status == JEventSource::Result::FailureFinished) {
             LOG_DEBUG(m_logger) << "Executed arrow " << GetName() << " with result FailureFinished"<< LOG_END;
             m_current_source++;
@@ -108,8 +125,8 @@ void JSourceArrow::Fire(JEvent* event, OutputData& outputs, size_t& output_count
             status = JArrow::FireResult::ComeBackLater;
             return;
         }
-        else if (event->GetSequential()){
-            // Source succeeded, but returned a barrier event
+        else if (event->GetSequential() && !m_pipeline_barriers){
+            // Source succeeded, but returned a barrier event that has to wait for the topology to drain
             LOG_DEBUG(m_logger) << "Executed arrow " << GetName() << " with result Success, holding back barrier event# " << event->GetEventNumber() << LOG_END;
             m_pending_barrier_event = event;
             m_barrier_active = true;
@@ -121,8 +138,9 @@ void JSourceArrow::Fire(JEvent* event, OutputData& outputs, size_t& output_count
             return;
         }
         else {
-            // Source succeeded, did NOT return a barrier event
-            LOG_DEBUG(m_logger) << "Executed arrow " << GetName() << " with result Success, emitting event# " << event->GetEventNumber() << LOG_END;
+            // Source succeeded, and returned either a regular event or a pipelined barrier event. The latter relies on
+            // the processors seeing events in order, so that its ProcessSequential() only affects later epochs
+            LOG_DEBUG(m_logger) << "Executed arrow " << GetName() << " with result Success, emitting event# " << event->GetEventNumber() << " from epoch " << m_epoch << LOG_END;
             outputs[0] = {event, 1}; // SUCCESS!
             output_count = 1;
             status = JArrow::FireResult::KeepGoing;
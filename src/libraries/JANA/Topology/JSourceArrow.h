@@ -15,10 +15,16 @@ private:
     size_t m_current_source = 0;
     bool m_barrier_active = false;
     JEvent* m_pending_barrier_event = nullptr;
+    bool m_pipeline_barriers = false;
+    uint64_t m_epoch = 0;
 
 public:
     JSourceArrow(std::string name, JEventLevel level, std::vector<JEventSource*> sources);
 
+    /// Send barrier events downstream right away instead of waiting for the topology to drain. This is only correct if
+    /// every processor that reads barrier-updated state does so from an ordered ProcessSequential(). See jana:pipeline_barriers.
+    void SetPipelineBarriers(bool pipeline_barriers) { m_pipeline_barriers = pipeline_barriers; }
+
     void Initialize() final;
     void Finalize() final;
     void Fire(JEvent* input, OutputData& outputs, size_t& output_count, JArrow::FireResult& status);
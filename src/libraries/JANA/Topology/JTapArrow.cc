@@ -6,6 +6,7 @@
 #include <JANA/JEventProcessor.h>
 #include <JANA/JEventUnfolder.h>
 #include <JANA/JEvent.h>
+#include <JANA/Utils/JLatencyHistogram.h>
 
 
 JTapArrow::JTapArrow(std::string name, JEventLevel level) {
@@ -25,8 +26,9 @@ void JTapArrow::Fire(JEvent* event, OutputData& outputs, size_t& output_count, J
 
     LOG_DEBUG(m_logger) << "Executing arrow " << GetName() << " for event# " << event->GetEventNumber() << LOG_END;
     for (JEventProcessor* proc : m_procs) {
-        JCallGraphEntryMaker cg_entry(*event->GetJCallGraphRecorder(), proc->GetTypeName()); // times execution until this goes out of scope
+        JCallGraphEntryMaker cg_entry(*event->GetJCallGraphRecorder(), proc->GetTypeName(), proc); // times execution until this goes out of scope
         if (proc->GetCallbackStyle() != JEventProcessor::CallbackStyle::LegacyMode) {
+            JLatencyHistogram::SelfTimer latency_timer(proc->GetLatencyHistogram());
             proc->DoTap(*event);
         }
     }
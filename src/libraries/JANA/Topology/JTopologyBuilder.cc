@@ -4,6 +4,7 @@
 
 #include "JTopologyBuilder.h"
 
+#include <cstdio>
 #include <string>
 #include <vector>
 
@@ -164,8 +165,22 @@ void JTopologyBuilder::SetConfigureFn(std::function<void(JTopologyBuilder&, JCom
 }
 
 void JTopologyBuilder::CreateTopology() {
-    mapping.initialize(static_cast<JProcessorMapping::AffinityStrategy>(m_affinity),
-                       static_cast<JProcessorMapping::LocalityStrategy>(m_locality));
+    if (m_simulated_numa_layout.empty()) {
+        mapping.initialize(static_cast<JProcessorMapping::AffinityStrategy>(m_affinity),
+                           static_cast<JProcessorMapping::LocalityStrategy>(m_locality));
+    }
+    else {
+        size_t socket_count = 0, numa_domains_per_socket = 0, cpus_per_numa_domain = 0;
+        char trailing;
+        if (sscanf(m_simulated_numa_layout.c_str(), "%zux%zux%zu%c", &socket_count, &numa_domains_per_socket, &cpus_per_numa_domain, &trailing) != 3 ||
+            socket_count == 0 || numa_domains_per_socket == 0 || cpus_per_numa_domain == 0) {
+            throw JException("Invalid jana:simulated_numa_layout '%s'. Expected e.g. 2x1x4", m_simulated_numa_layout.c_str());
+        }
+        mapping.initialize_simulated(socket_count, numa_domains_per_socket, cpus_per_numa_domain,
+                                     static_cast<JProcessorMapping::LocalityStrategy>(m_locality));
+    }
+    // Pools need one local queue per location, just like the queues, since workers push and pop at their own location
+    m_location_count = mapping.get_loc_count();
 
     if (m_configure_topology) {
         m_configure_topology(*this, *m_components);
@@ -192,7 +207,84 @@ void JTopologyBuilder::CreateTopology() {
             queue->SetEstablishesOrdering(false);
         }
     }
+
+    if (m_enable_stealing && m_location_count > 1) {
+        std::vector<std::vector<size_t>> steal_order;
+        for (size_t location=0; location<m_location_count; ++location) {
+            steal_order.push_back(mapping.get_neighbor_locs(location));
+        }
+        for (auto* queue : queues) {
+            queue->SetStealOrder(steal_order);
+        }
+        for (auto* pool : pools) {
+            pool->SetStealOrder(steal_order);
+        }
+    }
+    for (auto* arrow : arrows) {
+        auto* map_arrow = dynamic_cast<JMapArrow*>(arrow);
+        if (map_arrow != nullptr) {
+            map_arrow->SetEagerPrefetch(m_enable_eager_prefetch);
+        }
+    }
     LOG_INFO(GetLogger()) << "Arrow topology is:\n" << PrintTopology() << LOG_END;
+    if (m_enable_eager_prefetch) {
+        LOG_INFO(GetLogger()) << "Factory reachability is:\n" << PrintFactoryReachability() << LOG_END;
+    }
+}
+
+/// PrintFactoryReachability shows which factories are needed by some processor, unfolder, or folder, according to their
+/// declared inputs, and in which wave eager prefetch creates them. Unreachable factories aren't prefetched,
+/// but they still run if something requests them via JEvent::Get().
+/// Note that factories which only get requested by calling JEvent::Get() from inside Process() show up as unreachable.
+std::string JTopologyBuilder::PrintFactoryReachability() {
+
+    JTablePrinter t;
+    t.AddColumn("Level", JTablePrinter::Justify::Left, 0);
+    t.AddColumn("Factory", JTablePrinter::Justify::Left, 0);
+    t.AddColumn("Prefix", JTablePrinter::Justify::Left, 0);
+    t.AddColumn("Wave", JTablePrinter::Justify::Left, 0);
+
+    size_t factory_count = 0;
+    size_t reachable_count = 0;
+    for (JEventPool* pool : pools) {
+        auto level = pool->GetLevel();
+        std::vector<jana::components::JHasInputs*> consumers;
+        for (auto* proc : m_components->GetProcessors()) {
+            if (proc->IsEnabled() && proc->GetLevel() == level) consumers.push_back(proc);
+        }
+        for (auto* unfolder : m_components->GetUnfolders()) {
+            if (unfolder->IsEnabled() && unfolder->GetLevel() == level) consumers.push_back(unfolder);
+        }
+        for (auto* folder : m_components->GetFolders()) {
+            if (folder->IsEnabled() && folder->GetChildLevel() == level) consumers.push_back(folder);
+        }
+        auto* facset = pool->GetSampleEvent().GetFactorySet();
+        auto waves = facset->GetUpstreamWaves(consumers);
+        std::map<JFactory*, size_t> wave_lookup;
+        for (size_t wave=0; wave<waves.size(); ++wave) {
+            for (auto* factory : waves[wave]) {
+                wave_lookup[factory] = wave;
+            }
+        }
+        for (auto* factory : facset->GetAllFactories()) {
+            factory_count += 1;
+            t | toString(level);
+            t | factory->GetTypeName();
+            t | factory->GetPrefix();
+            auto it = wave_lookup.find(factory);
+            if (it == wave_lookup.end()) {
+                t | "Unreachable";
+            }
+            else {
+                t | it->second;
+                reachable_count += 1;
+            }
+        }
+    }
+    std::ostringstream oss;
+    t.Render(oss);
+    oss << "  " << reachable_count << " of " << factory_count << " factories are reachable" << std::endl;
+    return oss.str();
 }
 
 void JTopologyBuilder::CreateTopologyFromScratch() {
@@ -213,6 +305,15 @@ void JTopologyBuilder::CreateTopologyFromScratch() {
     int map_counter = 1;
     std::set<JEventLevel> levels_present;
 
+    // Pipelined barriers rely on every processor seeing events in order, which legacy processors can't do
+    bool pipeline_barriers = m_pipeline_barriers;
+    for (auto* proc : m_components->GetProcessors()) {
+        if (pipeline_barriers && proc->IsEnabled() && proc->GetCallbackStyle() == JEventProcessor::CallbackStyle::LegacyMode) {
+            LOG_WARN(GetLogger()) << "jana:pipeline_barriers: Legacy processor '" << proc->GetTypeName() << "' can't see events in order, so barrier events will drain the topology instead" << LOG_END;
+            pipeline_barriers = false;
+        }
+    }
+
     // Place all sources on grid
     // -----------------------------
     std::map<JEventLevel, std::vector<JEventSource*>> sources;
@@ -246,7 +347,9 @@ void JTopologyBuilder::CreateTopologyFromScratch() {
             }
         }
         else {
-            src_arrow = new JSourceArrow(level_str+"Source", level, it.second);
+            auto* plain_src_arrow = new JSourceArrow(level_str+"Source", level, it.second);
+            plain_src_arrow->SetPipelineBarriers(pipeline_barriers);
+            src_arrow = plain_src_arrow;
         }
         AddArrow(src_arrow);
 
@@ -305,7 +408,7 @@ void JTopologyBuilder::CreateTopologyFromScratch() {
         levels_present.insert(parent_level);
         levels_present.insert(child_level);
 
-        auto* map_arrow = new JMapArrow(toString(child_level)+"Map"+std::to_string(map_counter++), parent_level);
+        auto* map_arrow = new JMapArrow(toString(child_level)+"Map"+std::to_string(map_counter++), child_level);
         auto* fold_arrow = new JFoldArrow(toString(parent_level)+"Fold", parent_level, child_level);
         fold_arrow->SetFolder(folder);
         map_arrow->AddFolder(folder);
@@ -321,6 +424,13 @@ void JTopologyBuilder::CreateTopologyFromScratch() {
         }
         grid[{parent_level, Column::FoldBelow}] = {fold_arrow, fold_arrow};
         grid[{child_level, Column::FoldAbove}] = {map_arrow, fold_arrow};
+
+        // The matching unfolder has to leave the parent to us as long as any of its children are still unfolded
+        auto unfold_above_it = grid.find({child_level, Column::UnfoldAbove});
+        auto unfold_below_it = grid.find({parent_level, Column::UnfoldBelow});
+        if (unfold_above_it != grid.end() && unfold_below_it != grid.end() && unfold_above_it->second.end == unfold_below_it->second.end) {
+            static_cast<JUnfoldArrow*>(unfold_above_it->second.end)->SetHasFolder(true);
+        }
     }
 
     // Place all processors on grid
@@ -333,6 +443,12 @@ void JTopologyBuilder::CreateTopologyFromScratch() {
             if (proc->GetCallbackStyle() == JEventProcessor::CallbackStyle::LegacyMode && proc->IsOrderingEnabled()) {
                 throw JException("%s: Ordering can only be used with non-legacy JEventProcessors", proc->GetTypeName().c_str());
             }
+            if (pipeline_barriers && !proc->IsOrderingEnabled() && sources.find(proc->GetLevel()) != sources.end()) {
+                // A barrier's ProcessSequential() has to run after every earlier event's and before every later event's.
+                // We can't tell whether the processor overrides ProcessSequential(), so it gets ordered regardless.
+                LOG_INFO(GetLogger()) << "jana:pipeline_barriers: Enabling ordering for processor '" << proc->GetTypeName() << "'" << LOG_END;
+                proc->EnableOrdering();
+            }
             mappable_processors[proc->GetLevel()].push_back(proc);
             if (proc->GetCallbackStyle() != JEventProcessor::CallbackStyle::LegacyMode) {
                 tappable_processors[proc->GetLevel()].push_back(proc);
@@ -369,32 +485,43 @@ void JTopologyBuilder::CreateTopologyFromScratch() {
     for (JEventLevel level : levels_present) {
 
         auto* pool = GetOrCreatePool(level);
-        JArrow* last_arrow = nullptr;
+        std::vector<JArrow*> last_arrows;
         for (auto column : columns) {
             auto it = grid.find({level, column});
             if (it == grid.end()) { continue; }
 
+            if (column == Column::FoldBelow) {
+                // The fold arrow doesn't take parents as input. Instead, a parent leaves either the unfold arrow or
+                // the fold arrow, depending on which of them is done with it last, so both feed the next column.
+                last_arrows.push_back(it->second.end);
+                continue;
+            }
+
             JArrow* current_arrow = it->second.start;
-            if (last_arrow == nullptr) {
+            if (last_arrows.empty()) {
                 // This is the first arrow we've found, so connect the pool here
                 auto port_index = current_arrow->GetPortIndex(level, JArrow::PortDirection::In);
                 current_arrow->GetPort(port_index).Attach(pool);
             }
             else {
-                Connect(last_arrow,
-                        last_arrow->GetPortIndex(level, JArrow::PortDirection::Out),
-                        current_arrow, 
-                        current_arrow->GetPortIndex(level, JArrow::PortDirection::In));
+                for (auto* last_arrow : last_arrows) {
+                    Connect(last_arrow,
+                            last_arrow->GetPortIndex(level, JArrow::PortDirection::Out),
+                            current_arrow,
+                            current_arrow->GetPortIndex(level, JArrow::PortDirection::In));
+                }
             }
-            last_arrow = it->second.end;
+            last_arrows = {it->second.end};
 
         }
-        // Connect last_arrow to pool
-        auto port_index = last_arrow->GetPortIndex(level, JArrow::PortDirection::Out);
-        if (level == JEventLevel::PhysicsEvent) {
-            last_arrow->SetIsSink(true);
+        // Connect last_arrows to pool
+        for (auto* last_arrow : last_arrows) {
+            auto port_index = last_arrow->GetPortIndex(level, JArrow::PortDirection::Out);
+            if (level == JEventLevel::PhysicsEvent) {
+                last_arrow->SetIsSink(true);
+            }
+            last_arrow->GetPort(port_index).Attach(pool);
         }
-        last_arrow->GetPort(port_index).Attach(pool);
     }
 
     // -----------------------------
@@ -451,17 +578,24 @@ void JTopologyBuilder::Init() {
     m_max_inflight_events[JEventLevel::Task] = m_params->RegisterParameter("jana:max_inflight_tasks", 8*nthreads,
                                 "The number of tasks which may be in-flight at once.");
 
-    /*
     m_params->SetDefaultParameter("jana:enable_stealing", m_enable_stealing,
-                                    "Enable work stealing. Improves load balancing when jana:locality != 0; otherwise does nothing.")
+                                    "Enable work stealing. Improves load balancing when jana:locality != 0; otherwise does nothing. Workers whose location has no events take them from the nearest location that does.")
+            ->SetIsAdvanced(true);
+    m_params->SetDefaultParameter("jana:enable_eager_prefetch", m_enable_eager_prefetch,
+                                    "Create every factory that the processors, unfolders, and folders need, according to their declared inputs, before running them. Factories are created in dependency order, with independent factories running concurrently when jana:enable_factory_parallelism is set.")
+            ->SetIsAdvanced(true);
+    m_params->SetDefaultParameter("jana:pipeline_barriers", m_pipeline_barriers,
+                                    "Keep events flowing around barrier events instead of draining the topology. Each barrier event starts a new epoch (see JEvent::GetEpoch), and processors see events in order, so whatever a barrier's ProcessSequential() updates only applies to later epochs. State that factories or ProcessParallel() read has to come from the event instead, e.g. from a SlowControls parent. Falls back to draining if there are any legacy processors.")
             ->SetIsAdvanced(true);
-    */
     m_params->SetDefaultParameter("jana:affinity", m_affinity,
                                     "Constrain worker thread CPU affinity. 0=Let the OS decide. 1=Avoid extra memory movement at the expense of using hyperthreads. 2=Avoid hyperthreads at the expense of extra memory movement")
             ->SetIsAdvanced(true);
     m_params->SetDefaultParameter("jana:locality", m_locality,
                                     "Constrain memory locality. 0=No constraint. 1=Events stay on the same socket. 2=Events stay on the same NUMA domain. 3=Events stay on same core. 4=Events stay on same cpu/hyperthread.")
             ->SetIsAdvanced(true);
+    m_params->SetDefaultParameter("jana:simulated_numa_layout", m_simulated_numa_layout,
+                                    "For testing locality on machines without NUMA: Pretend the machine has this layout instead of querying lscpu. Format is <sockets>x<numa domains per socket>x<cpus per numa domain>, e.g. 2x1x4. Disables thread pinning.")
+            ->SetIsAdvanced(true);
 };
 
 
@@ -38,7 +38,10 @@ class JTopologyBuilder : public JService {
     // Topology configuration
     std::map<JEventLevel, size_t> m_max_inflight_events;
     size_t m_location_count = 1;
-    //bool m_enable_stealing = false;
+    bool m_enable_stealing = false;
+    bool m_enable_eager_prefetch = false;
+    bool m_pipeline_barriers = false;
+    std::string m_simulated_numa_layout;
     int m_affinity = 0;
     int m_locality = 0;
 
@@ -72,6 +75,7 @@ public:
     void CreateTopologyFromScratch();
 
     std::string PrintTopology();
+    std::string PrintFactoryReachability();
 
     const std::vector<JArrow*>& GetArrows() { return arrows; };
     const std::vector<JEventPool*>& GetPools() { return pools; };
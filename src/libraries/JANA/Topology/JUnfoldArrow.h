@@ -6,6 +6,9 @@
 #include <JANA/Topology/JArrow.h>
 #include <JANA/JEventUnfolder.h>
 
+#include <deque>
+#include <mutex>
+
 class JUnfoldArrow : public JArrow {
 public:
     enum PortIndex {PARENT_IN=0, CHILD_IN=1, CHILD_OUT=2, PARENT_OUT=3};
@@ -14,6 +17,23 @@ private:
     JEventUnfolder* m_unfolder = nullptr;
     JEvent* m_parent_event = nullptr;
     JEvent* m_child_event = nullptr;
+    bool m_has_folder = false;
+
+    // Parallel unfolding state, see JEventUnfolder::EnableParallelUnfold()
+    struct ParentCursor {
+        JEvent* parent = nullptr;
+        int item_nr = 0;
+        bool is_busy = false;      // A worker is inside Unfold() for this parent right now
+        bool is_finished = false;  // Unfold() returned NextParent
+        bool emit_parent = false;  // Whether the parent goes to PARENT_OUT once all of its children have been emitted
+        std::deque<JEvent*> pending_children; // Unfolded, but waiting for the parents ahead of this one to finish
+    };
+    std::mutex m_mutex;
+    std::deque<ParentCursor> m_cursors; // In arrival order. Only the front cursor may emit children
+    std::vector<JEvent*> m_idle_children;
+    size_t m_pending_child_count = 0;
+    size_t m_max_pending_child_count = 0;
+    size_t m_next_child_index = 0;
 
 public:
     JUnfoldArrow(std::string name, JEventUnfolder* unfolder) : m_unfolder(unfolder) {
@@ -22,15 +42,32 @@ public:
         auto child_level = unfolder->GetChildLevel();
         AddPort("parent_in", parent_level, PortDirection::In);
         AddPort("child_in", child_level, PortDirection::In);
-        AddPort("child_out", child_level, PortDirection::Out).SetEstablishesOrdering(true);
+        AddPort("child_out", child_level, PortDirection::Out).SetEstablishesOrdering(!unfolder->IsParallelUnfoldEnabled());
         // Just in case there's a folder that needs this.
-        // establishes_ordering is cheap; enforces_ordering is the expensive one
+        // establishes_ordering is cheap; enforces_ordering is the expensive one.
+        // When unfolding in parallel, children are checked in out of order, so we number them ourselves instead
 
         AddPort("parent_out", parent_level, PortDirection::Out);
         m_next_input_port = GetPortIndex("parent_in");
+        SetIsParallel(unfolder->IsParallelUnfoldEnabled());
+        if (unfolder->IsParallelUnfoldEnabled()) {
+            unfolder->CheckParallelUnfold();
+        }
     }
 
+    /// Set by JTopologyBuilder when a JFoldArrow downstream folds our children back into their parents. In that
+    /// case the parent is only sent to PARENT_OUT if no children still reference it; otherwise the JFoldArrow emits
+    /// it once it has folded the last one. Without a folder, the parent always goes to PARENT_OUT as soon as we are
+    /// done unfolding it, and its JEventPool holds onto it until its children have been returned.
+    void SetHasFolder(bool has_folder) { m_has_folder = has_folder; }
+
     void Initialize() final {
+        if (IsParallel()) {
+            // Children waiting behind an earlier parent can't tie up more than half of the child pool, so that the 
+            // earliest parent can always get hold of a child eventually and we can't deadlock
+            auto* child_pool = GetPort(CHILD_IN).GetPool();
+            m_max_pending_child_count = (child_pool == nullptr) ? 0 : child_pool->GetCapacity() / 2;
+        }
         m_unfolder->DoInit();
         LOG_INFO(m_logger) << "Initialized JEventUnfolder '" << m_unfolder->GetTypeName() << "'" << LOG_END;
     }
@@ -42,10 +79,18 @@ public:
 
     void Fire(JEvent* event, OutputData& outputs, size_t& output_count, JArrow::FireResult& status) final {
 
+        if (IsParallel()) {
+            FireParallel(event, outputs, output_count, status);
+            return;
+        }
+
         // Take whatever we were given
         if (this->m_next_input_port == PARENT_IN) {
             assert(m_parent_event == nullptr);
             m_parent_event = event;
+            // Hold a reference to the parent while we are unfolding it, so that a folder can't release it
+            // after folding the children we've emitted so far
+            m_parent_event->AddReference();
         }
         else if (this->m_next_input_port == CHILD_IN) {
             assert(m_child_event == nullptr);
@@ -87,28 +132,17 @@ public:
         LOG_DEBUG(m_logger) << "Unfold succeeded: Parent event = " << m_parent_event->GetEventNumber() << ", child event = " << m_child_event->GetEventNumber() << LOG_END;
 
         if (result == JEventUnfolder::Result::KeepChildNextParent) {
-            // KeepChildNextParent is a little more complicated because we have to handle the case of the parent having no children.
-            // In this case the parent obviously doesn't get shared among any children, and instead it is sent to the PARENT_OUT port.
-            int child_count = m_parent_event->GetChildCount();
-            LOG_DEBUG(m_logger) << "Unfold finished with parent event = " << m_parent_event->GetEventNumber() << " (" << child_count << " children emitted)";
-
-            if (child_count > 0) {
-                // Parent DOES have children even though this particular child isn't one of them
-                m_parent_event = nullptr;
-                output_count = 0;
-                m_next_input_port = PARENT_IN;
-                status = JArrow::FireResult::KeepGoing;
-                return;
-            }
-            else {
-                // Parent has NO children
-                output_count = 1;
+            // The child isn't used, so we hold onto it for the next parent
+            LOG_DEBUG(m_logger) << "Unfold finished with parent event = " << m_parent_event->GetEventNumber() << LOG_END;
+            output_count = 0;
+            if (ReleaseFinishedParent(m_parent_event)) {
                 outputs[0] = {m_parent_event, PARENT_OUT};
-                m_parent_event = nullptr;
-                m_next_input_port = PARENT_IN;
-                status = JArrow::FireResult::KeepGoing;
-                return;
+                output_count = 1;
             }
+            m_parent_event = nullptr;
+            m_next_input_port = PARENT_IN;
+            status = JArrow::FireResult::KeepGoing;
+            return;
         }
         else if (result == JEventUnfolder::Result::NextChildKeepParent) {
             m_child_event->SetParent(m_parent_event);
@@ -120,11 +154,14 @@ public:
             return;
         }
         else if (result == JEventUnfolder::Result::NextChildNextParent) {
+            LOG_DEBUG(m_logger) << "Unfold finished with parent event = " << m_parent_event->GetEventNumber() << LOG_END;
             m_child_event->SetParent(m_parent_event);
             outputs[0] = {m_child_event, CHILD_OUT};
-            outputs[1] = {m_parent_event, PARENT_OUT};
-            output_count = 2;
-            LOG_DEBUG(m_logger) << "Unfold finished with parent event = " << m_parent_event->GetEventNumber() << LOG_END;
+            output_count = 1;
+            if (ReleaseFinishedParent(m_parent_event)) {
+                outputs[1] = {m_parent_event, PARENT_OUT};
+                output_count = 2;
+            }
             m_child_event = nullptr;
             m_parent_event = nullptr;
             m_next_input_port = PARENT_IN;
@@ -135,6 +172,156 @@ public:
             throw JException("Unsupported (corrupt?) JEventUnfolder::Result");
         }
     }
+
+private:
+    /// Drops the reference we took when we accepted the parent, and decides whether the parent goes to PARENT_OUT
+    bool ReleaseFinishedParent(JEvent* parent) {
+        bool is_last_reference = parent->ReleaseReference();
+        return is_last_reference || !m_has_folder;
+    }
+
+    void FireParallel(JEvent* event, OutputData& outputs, size_t& output_count, JArrow::FireResult& status) {
+
+        // Several workers may be in here at once. m_next_input_port may have changed between when the engine 
+        // pulled our input and now, so we use the event level to figure out where it came from.
+
+        if (event != nullptr && event->GetLevel() == m_unfolder->GetLevel()) {
+            // Once per parent rather than once per child, and before anybody else can see it
+            m_unfolder->DoParallelOpenParent(*event);
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        status = JArrow::FireResult::KeepGoing;
+        output_count = 0;
+
+        if (event != nullptr) {
+            if (event->GetLevel() == m_unfolder->GetLevel()) {
+                m_cursors.emplace_back();
+                m_cursors.back().parent = event;
+                event->AddReference();
+            }
+            else if (event->GetLevel() == m_unfolder->GetChildLevel()) {
+                m_idle_children.push_back(event);
+            }
+            else {
+                throw JException("JUnfolder: Expected event with level %s or %s, got %s", toString(m_unfolder->GetLevel()).c_str(), toString(m_unfolder->GetChildLevel()).c_str(), toString(event->GetLevel()).c_str());
+            }
+        }
+
+        // Emitting what is already finished takes priority over unfolding more
+        EmitFinished_Unsafe(outputs, output_count);
+        if (output_count != 0) {
+            m_next_input_port = FindNextInputPort_Unsafe();
+            return;
+        }
+
+        ParentCursor* cursor = FindReadyCursor_Unsafe();
+        if (cursor == nullptr || m_idle_children.empty()) {
+            m_next_input_port = FindNextInputPort_Unsafe();
+            return;
+        }
+        JEvent* parent = cursor->parent;
+        JEvent* child = m_idle_children.back();
+        m_idle_children.pop_back();
+        int item_nr = cursor->item_nr++;
+        cursor->is_busy = true;
+        m_next_input_port = FindNextInputPort_Unsafe();
+        lock.unlock();
+
+        JEventUnfolder::Result result;
+        try {
+            result = m_unfolder->DoParallelUnfold(*parent, *child, item_nr);
+        }
+        catch (...) {
+            lock.lock();
+            cursor->is_busy = false;
+            m_idle_children.push_back(child);
+            throw;
+        }
+        LOG_DEBUG(m_logger) << "Unfold succeeded: Parent event = " << parent->GetEventNumber() << ", child event = " << child->GetEventNumber() << LOG_END;
+
+        lock.lock();
+        cursor->is_busy = false;
+
+        if (result == JEventUnfolder::Result::KeepChildNextParent) {
+            LOG_DEBUG(m_logger) << "Unfold finished with parent event = " << parent->GetEventNumber() << LOG_END;
+            m_idle_children.push_back(child);
+            cursor->is_finished = true;
+            cursor->emit_parent = ReleaseFinishedParent(parent);
+        }
+        else if (result == JEventUnfolder::Result::NextChildKeepParent || result == JEventUnfolder::Result::NextChildNextParent) {
+            child->SetParent(parent);
+            cursor->pending_children.push_back(child);
+            m_pending_child_count += 1;
+            if (result == JEventUnfolder::Result::NextChildNextParent) {
+                LOG_DEBUG(m_logger) << "Unfold finished with parent event = " << parent->GetEventNumber() << LOG_END;
+                cursor->is_finished = true;
+                cursor->emit_parent = ReleaseFinishedParent(parent);
+            }
+        }
+        else {
+            throw JException("Unsupported (corrupt?) JEventUnfolder::Result");
+        }
+
+        EmitFinished_Unsafe(outputs, output_count);
+        m_next_input_port = FindNextInputPort_Unsafe();
+    }
+
+    /// Emits the children of the front cursor, followed by its parent once it has finished, until we
+    /// run out of output slots or reach a parent that is still being unfolded. Each child is numbered as it is
+    /// emitted, so that downstream queues which enforce ordering see them in the order sequential unfolding would produce.
+    void EmitFinished_Unsafe(OutputData& outputs, size_t& output_count) {
+        while (output_count < outputs.size() && !m_cursors.empty()) {
+            auto& front = m_cursors.front();
+            if (!front.pending_children.empty()) {
+                JEvent* child = front.pending_children.front();
+                front.pending_children.pop_front();
+                m_pending_child_count -= 1;
+                child->SetEventIndex(m_next_child_index++);
+                outputs[output_count++] = {child, CHILD_OUT};
+            }
+            else if (front.is_finished) {
+                if (front.emit_parent) {
+                    outputs[output_count++] = {front.parent, PARENT_OUT};
+                }
+                m_cursors.pop_front();
+            }
+            else {
+                break;
+            }
+        }
+    }
+
+    ParentCursor* FindReadyCursor_Unsafe() {
+        size_t busy_count = 0;
+        for (auto& cursor : m_cursors) {
+            busy_count += cursor.is_busy;
+        }
+        bool is_front = true;
+        for (auto& cursor : m_cursors) {
+            if (!cursor.is_busy && !cursor.is_finished) {
+                if (is_front || m_pending_child_count + busy_count < m_max_pending_child_count) {
+                    return &cursor;
+                }
+            }
+            is_front = false;
+        }
+        return nullptr;
+    }
+
+    int FindNextInputPort_Unsafe() {
+        if (!m_cursors.empty() && (!m_cursors.front().pending_children.empty() || m_cursors.front().is_finished)) {
+            return -1; // Something is ready to emit
+        }
+        if (FindReadyCursor_Unsafe() == nullptr) {
+            // Every parent we have is either busy or waiting on the ones ahead of it
+            return PARENT_IN;
+        }
+        if (m_idle_children.empty()) {
+            return CHILD_IN;
+        }
+        return -1; // We have a parent and a child, so we can unfold right away
+    }
 };
 
 
@@ -4,6 +4,7 @@
 #include "JANA/Topology/JTopologyBuilder.h"
 #include <JANA/JApplication.h>
 #include <JANA/Engine/JExecutionEngine.h>
+#include <JANA/Services/JComponentManager.h>
 
 
 void PrintMenu() {
@@ -15,6 +16,7 @@ void PrintMenu() {
     std::cout << "  icl  InspectCollections" << std::endl;
     std::cout << "  icl  InspectCollection collection_name" << std::endl;
     std::cout << "  it   InspectTopology" << std::endl;
+    std::cout << "  il   InspectLatencies" << std::endl;
     std::cout << "  ip   InspectPlace arrow_id place_id" << std::endl;
     std::cout << "  ie   InspectEvent arrow_id place_id slot_id" << std::endl;
     std::cout << "  f    Fire arrow_id" << std::endl;
@@ -30,6 +32,15 @@ void InspectTopology(JApplication* app) {
     std::cout << topology->PrintTopology() << std::endl;
 }
 
+void InspectLatencies(JApplication* app) {
+    auto component_manager = app->GetService<JComponentManager>();
+    if (!component_manager->IsLatencyHistogramsEnabled()) {
+        std::cout << "Latency histograms are disabled. Hint: Set jana:latency_histograms=true" << std::endl;
+        return;
+    }
+    component_manager->PrintLatencySummaries(std::cout);
+}
+
 void Fire(JApplication* app, int arrow_id) {
     auto engine = app->GetService<JExecutionEngine>();
     engine->Fire(arrow_id, 0);
@@ -111,6 +122,9 @@ void InspectApplication(JApplication* app) {
             else if ((token == "InspectTopology" || token == "it") && args.empty()) {
                 InspectTopology(app);
             }
+            else if ((token == "InspectLatencies" || token == "il") && args.empty()) {
+                InspectLatencies(app);
+            }
             else if ((token == "InspectPlace" || token == "ip") && args.size() == 2) {
                 // InspectPlace(std::stoi(args[0]), std::stoi(args[1]));
             }
@@ -0,0 +1,45 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#include <JANA/Utils/JArena.h>
+
+
+void JArena::Reset() {
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    if (m_is_thread_safe) {
+        lock.lock();
+    }
+    if (m_bytes_in_use > m_high_water_mark) {
+        m_high_water_mark = m_bytes_in_use;
+    }
+    if (m_blocks.size() > 1) {
+        // This event overflowed the first block. Replace all of the blocks with a single one that
+        // fits the largest event so far, so that we don't have to regrow on every event.
+        size_t block_size = (m_high_water_mark > m_block_size) ? m_high_water_mark : m_block_size;
+        m_blocks.clear();
+        m_blocks.push_back({std::unique_ptr<char[]>(new char[block_size]), block_size});
+    }
+    m_current_block = 0;
+    m_offset = 0;
+    m_bytes_in_use = 0;
+}
+
+bool JArena::Contains(const void* ptr) const {
+    auto p = reinterpret_cast<uintptr_t>(ptr);
+    for (const auto& block : m_blocks) {
+        auto base = reinterpret_cast<uintptr_t>(block.data.get());
+        if (p >= base && p < base + block.size) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t JArena::GetCapacity() const {
+    size_t capacity = 0;
+    for (const auto& block : m_blocks) {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
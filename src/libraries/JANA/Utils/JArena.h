@@ -0,0 +1,103 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+/// JArena is a monotonic (bump) allocator. Allocate() hands out memory by advancing an offset into a block,
+/// and Reset() frees everything at once by rewinding that offset. Each JFactorySet owns one, so that objects
+/// which live exactly as long as an event can be freed in one step when the event gets cleared, instead of
+/// one `delete` at a time. Reset() never runs destructors; that is the caller's job.
+///
+/// Blocks are only allocated once something is actually requested. If an event needs more than one block,
+/// the next Reset() replaces them with a single block that is large enough, so that from then on every event
+/// fits in one block and Reset() is O(1).
+class JArena {
+
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size = 0;
+    };
+
+    std::vector<Block> m_blocks;
+    size_t m_current_block = 0;
+    size_t m_offset = 0;
+    size_t m_bytes_in_use = 0;
+    size_t m_high_water_mark = 0;
+    size_t m_block_size = 64*1024;
+    bool m_is_thread_safe = false;
+    std::mutex m_mutex;
+
+public:
+    JArena() = default;
+    explicit JArena(size_t block_size) : m_block_size(block_size) {}
+    JArena(const JArena&) = delete;
+    JArena& operator=(const JArena&) = delete;
+
+    /// Returns `bytes` of uninitialized memory aligned to `alignment`, which must be a power of two
+    void* Allocate(size_t bytes, size_t alignment);
+
+    /// Frees everything allocated since the last Reset(). Any objects still living in the arena become invalid.
+    void Reset();
+
+    bool Contains(const void* ptr) const;
+
+    /// Needed when several factories may allocate from the same event concurrently. See jana:enable_factory_parallelism.
+    void SetThreadSafe(bool thread_safe) { m_is_thread_safe = thread_safe; }
+    bool IsThreadSafe() const { return m_is_thread_safe; }
+
+    /// Size of the first block, and the minimum size of any block added later. Only affects blocks allocated after this call.
+    void SetBlockSize(size_t block_size) { m_block_size = block_size; }
+    size_t GetBlockSize() const { return m_block_size; }
+
+    /// Bytes handed out since the last Reset(), including alignment padding
+    size_t GetBytesInUse() const { return m_bytes_in_use; }
+
+    /// The most bytes that were ever in use at once, i.e. the block size that would have avoided all regrowth
+    size_t GetHighWaterMark() const { return (m_bytes_in_use > m_high_water_mark) ? m_bytes_in_use : m_high_water_mark; }
+
+    /// Total bytes held in blocks, used or not
+    size_t GetCapacity() const;
+
+    size_t GetBlockCount() const { return m_blocks.size(); }
+
+private:
+    void* AllocateUnlocked(size_t bytes, size_t alignment);
+};
+
+
+inline void* JArena::Allocate(size_t bytes, size_t alignment) {
+    if (m_is_thread_safe) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return AllocateUnlocked(bytes, alignment);
+    }
+    return AllocateUnlocked(bytes, alignment);
+}
+
+inline void* JArena::AllocateUnlocked(size_t bytes, size_t alignment) {
+    while (m_current_block < m_blocks.size()) {
+        auto& block = m_blocks[m_current_block];
+        auto base = reinterpret_cast<uintptr_t>(block.data.get());
+        auto start = (base + m_offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        if (start + bytes <= base + block.size) {
+            m_bytes_in_use += (start + bytes) - (base + m_offset);
+            m_offset = (start + bytes) - base;
+            return reinterpret_cast<void*>(start);
+        }
+        // Whatever is left at the end of this block is wasted until the next Reset()
+        m_bytes_in_use += block.size - m_offset;
+        m_current_block += 1;
+        m_offset = 0;
+    }
+    size_t block_size = (bytes + alignment > m_block_size) ? bytes + alignment : m_block_size;
+    m_blocks.push_back({std::unique_ptr<char[]>(new char[block_size]), block_size});
+    m_current_block = m_blocks.size() - 1;
+    return AllocateUnlocked(bytes, alignment);
+}
+
@@ -20,16 +20,34 @@ class JCallGraphEntryMaker{
 public:
 
     JCallGraphEntryMaker(JCallGraphRecorder &callgraphrecorder, JFactory *factory) : m_call_graph(callgraphrecorder), m_factory(factory){
-        m_call_graph.StartFactoryCall(m_factory->GetObjectName(), m_factory->GetTag());
+        if (m_call_graph.IsEnabled()) {
+            m_call_graph.StartFactoryCall(m_factory->GetObjectName(), m_factory->GetTag());
+        }
+        if (m_call_graph.IsSampling()) {
+            uint32_t id;
+            if (!m_call_graph.FindId(m_factory, id)) {
+                id = m_call_graph.InternId(m_factory, m_factory->GetObjectName(), m_factory->GetTag());
+            }
+            m_call_graph.StartCompactCall(id);
+        }
     }
 
-    JCallGraphEntryMaker(JCallGraphRecorder &callgraphrecorder, std::string name) : m_call_graph(callgraphrecorder) {
-        // This is used mainly for JEventProcessors
+    JCallGraphEntryMaker(JCallGraphRecorder &callgraphrecorder, const std::string& name, const void* component=nullptr) : m_call_graph(callgraphrecorder) {
+        // This is used mainly for JEventProcessors. Passing the component lets summary mode skip the name lookup.
         m_call_graph.StartFactoryCall(name, "");
+        if (m_call_graph.IsSampling()) {
+            uint32_t id;
+            if (component == nullptr || !m_call_graph.FindId(component, id)) {
+                id = m_call_graph.InternId(component, name, "");
+            }
+            m_call_graph.StartCompactCall(id);
+        }
     }
 
     ~JCallGraphEntryMaker(){
-        m_call_graph.FinishFactoryCall( m_factory ? m_factory->GetDataSource():JCallGraphRecorder::DATA_NOT_AVAILABLE );
+        auto data_source = m_factory ? m_factory->GetDataSource() : JCallGraphRecorder::DATA_NOT_AVAILABLE;
+        m_call_graph.FinishFactoryCall(data_source);
+        m_call_graph.FinishCompactCall(data_source);
     }
 
 protected:
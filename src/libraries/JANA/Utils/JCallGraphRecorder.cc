@@ -3,6 +3,7 @@
 //
 
 #include "JCallGraphRecorder.h"
+#include "JCallGraphSummary.h"
 
 #include <JANA/JLogger.h>
 
@@ -18,6 +19,36 @@ void JCallGraphRecorder::Reset() {
     m_error_call_stack.clear();
 }
 
+void JCallGraphRecorder::EnableSummary(JCallGraphSummary* summary, size_t sampling_interval, size_t node_capacity) {
+    m_summary = summary;
+    m_sampling_interval = (sampling_interval == 0) ? 1 : sampling_interval;
+    m_node_capacity = node_capacity;
+    m_event_count = 0;
+    m_is_sampling = (summary != nullptr);
+    m_compact_nodes.reserve(node_capacity);
+    m_compact_stack.reserve(16);
+}
+
+uint32_t JCallGraphRecorder::InternId(const void* component, const std::string& name, const std::string& tag) {
+    auto id = m_summary->Intern(name, tag);
+    m_ids[component] = id;
+    return id;
+}
+
+void JCallGraphRecorder::FlushSummary() {
+    if (m_summary == nullptr) return;
+    if (m_is_sampling) {
+        m_summary->Merge(m_compact_nodes, m_dropped_node_count);
+    }
+    m_compact_nodes.clear();
+    m_compact_stack.clear();
+    m_dropped_node_count = 0;
+
+    // Every recorder samples its own events, so that deciding doesn't need any shared state
+    m_event_count += 1;
+    m_is_sampling = (m_event_count % m_sampling_interval == 0);
+}
+
 void JCallGraphRecorder::PrintErrorCallStack() const {
 
     // Create a list of the call strings while finding the longest one
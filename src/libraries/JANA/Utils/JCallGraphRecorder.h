@@ -7,8 +7,12 @@
 #include <vector>
 #include <string>
 #include <cassert>
+#include <cstdint>
 #include <sys/time.h>
 #include <chrono>
+#include <unordered_map>
+
+class JCallGraphSummary;
 
 
 // Note on tracking how/where Insert() objects came from.
@@ -70,6 +74,19 @@ public:
         int line = 0;
     };
 
+    /// What summary mode records instead of a JCallGraphNode. Names are replaced by ids from JCallGraphSummary::Intern().
+    struct JCompactNode {
+        uint32_t caller_id;
+        uint32_t callee_id;
+        uint64_t duration_ns;
+        JDataSource data_source;
+    };
+
+    struct JCompactFrame {
+        uint32_t id;
+        std::chrono::steady_clock::time_point start_time;
+    };
+
 private:
     bool m_enabled = false;
     std::vector<JCallStackFrame> m_call_stack;
@@ -77,6 +94,17 @@ private:
     std::vector<JCallGraphNode> m_call_graph;
     JDataOrigin m_insert_dataorigin_type = ORIGIN_FROM_FACTORY; // See note at top of file
 
+    // Summary mode. See jana:call_graph_summary
+    JCallGraphSummary* m_summary = nullptr;
+    bool m_is_sampling = false;
+    size_t m_sampling_interval = 1;
+    size_t m_event_count = 0;
+    size_t m_node_capacity = 0;
+    size_t m_dropped_node_count = 0;
+    std::vector<JCompactFrame> m_compact_stack;
+    std::vector<JCompactNode> m_compact_nodes; // Never grows past m_node_capacity
+    std::unordered_map<const void*, uint32_t> m_ids; // Ids of the components we've seen, so we only intern each one once
+
 public:
     inline bool IsEnabled() const { return m_enabled; }
     inline void SetEnabled(bool recordingEnabled=true){ m_enabled = recordingEnabled; }
@@ -91,6 +119,19 @@ public:
     void PrintErrorCallStack() const; ///< Print the current factory call stack
     void Reset();
     std::vector<std::pair<std::string, std::string>> TopologicalSort() const;
+
+    /// Summary mode records calls into a fixed-size buffer using integer ids, and merges that buffer into `summary` when
+    /// the event is recycled. Only one in every `sampling_interval` events is recorded. This is cheap enough to leave on
+    /// in production, unlike SetEnabled(), which keeps the complete call graph for every event.
+    void EnableSummary(JCallGraphSummary* summary, size_t sampling_interval, size_t node_capacity);
+    JCallGraphSummary* GetSummary() const { return m_summary; }
+    inline bool IsSampling() const { return m_is_sampling; } ///< True if summary mode is enabled and the current event is being sampled
+    inline bool FindId(const void* component, uint32_t& id) const;
+    uint32_t InternId(const void* component, const std::string& name, const std::string& tag);
+    inline void StartCompactCall(uint32_t callee_id);
+    inline void FinishCompactCall(JDataSource data_source=JDataSource::DATA_FROM_FACTORY);
+    const std::vector<JCompactNode>& GetCompactNodes() const { return m_compact_nodes; }
+    void FlushSummary(); ///< Merges this event's calls into the JCallGraphSummary and decides whether to sample the next event
 };
 
 
@@ -141,3 +182,36 @@ void JCallGraphRecorder::FinishFactoryCall(JCallGraphRecorder::JDataSource data_
 }
 
 
+bool JCallGraphRecorder::FindId(const void* component, uint32_t& id) const {
+    auto it = m_ids.find(component);
+    if (it == m_ids.end()) return false;
+    id = it->second;
+    return true;
+}
+
+void JCallGraphRecorder::StartCompactCall(uint32_t callee_id) {
+    if (!m_is_sampling) return;
+    m_compact_stack.push_back({callee_id, std::chrono::steady_clock::now()});
+}
+
+void JCallGraphRecorder::FinishCompactCall(JCallGraphRecorder::JDataSource data_source) {
+
+    if (!m_is_sampling) return;
+    assert(!m_compact_stack.empty());
+    auto callee_frame = m_compact_stack.back();
+    m_compact_stack.pop_back();
+
+    // Like FinishFactoryCall(), we only record calls which have a caller
+    if (!m_compact_stack.empty()) {
+        if (m_compact_nodes.size() < m_node_capacity) {
+            auto duration = std::chrono::steady_clock::now() - callee_frame.start_time;
+            m_compact_nodes.push_back({m_compact_stack.back().id,
+                                       callee_frame.id,
+                                       static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()),
+                                       data_source});
+        }
+        else {
+            m_dropped_node_count += 1;
+        }
+    }
+}
@@ -0,0 +1,106 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#include "JCallGraphSummary.h"
+#include <JANA/Utils/JTablePrinter.h>
+
+#include <algorithm>
+
+
+uint32_t JCallGraphSummary::Intern(const std::string& name, const std::string& tag) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto result = m_ids.emplace(std::make_pair(name, tag), static_cast<uint32_t>(m_names.size()));
+    if (result.second) {
+        m_names.emplace_back(name, tag);
+    }
+    return result.first->second;
+}
+
+void JCallGraphSummary::Merge(const std::vector<JCallGraphRecorder::JCompactNode>& nodes, size_t dropped_node_count) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& node : nodes) {
+        auto& stats = m_edges[(static_cast<uint64_t>(node.caller_id) << 32) | node.callee_id][node.data_source];
+        stats.call_count += 1;
+        stats.total_ns += node.duration_ns;
+        stats.max_ns = std::max(stats.max_ns, node.duration_ns);
+    }
+    m_sampled_event_count += 1;
+    m_dropped_node_count += dropped_node_count;
+}
+
+std::vector<JCallGraphSummary::Edge> JCallGraphSummary::GetEdges() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<Edge> edges;
+    edges.reserve(m_edges.size());
+    for (const auto& it : m_edges) {
+        auto caller_id = static_cast<uint32_t>(it.first >> 32);
+        auto callee_id = static_cast<uint32_t>(it.first & 0xffffffff);
+        for (size_t data_source=0; data_source<it.second.size(); ++data_source) {
+            const auto& stats = it.second[data_source];
+            if (stats.call_count == 0) continue;
+            Edge edge;
+            edge.caller_name = m_names[caller_id].first;
+            edge.caller_tag = m_names[caller_id].second;
+            edge.callee_name = m_names[callee_id].first;
+            edge.callee_tag = m_names[callee_id].second;
+            edge.data_source = static_cast<JCallGraphRecorder::JDataSource>(data_source);
+            edge.call_count = stats.call_count;
+            edge.total_ns = stats.total_ns;
+            edge.max_ns = stats.max_ns;
+            edges.push_back(edge);
+        }
+    }
+    return edges;
+}
+
+uint64_t JCallGraphSummary::GetSampledEventCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_sampled_event_count;
+}
+
+uint64_t JCallGraphSummary::GetDroppedNodeCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dropped_node_count;
+}
+
+void JCallGraphSummary::Print(std::ostream& os) const {
+
+    auto edges = GetEdges();
+    std::sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) { return a.total_ns > b.total_ns; });
+
+    auto make_nametag = [](const std::string& name, const std::string& tag) {
+        return tag.empty() ? name : name + ":" + tag;
+    };
+
+    JTablePrinter table;
+    table.AddColumn("Caller");
+    table.AddColumn("Callee");
+    table.AddColumn("Data source");
+    table.AddColumn("Calls", JTablePrinter::Justify::Right);
+    table.AddColumn("Avg [ms]", JTablePrinter::Justify::Right);
+    table.AddColumn("Max [ms]", JTablePrinter::Justify::Right);
+    table.AddColumn("Total [ms]", JTablePrinter::Justify::Right);
+
+    for (const auto& edge : edges) {
+        table | make_nametag(edge.caller_name, edge.caller_tag);
+        table | make_nametag(edge.callee_name, edge.callee_tag);
+        switch (edge.data_source) {
+            case JCallGraphRecorder::DATA_NOT_AVAILABLE: table | "Not available"; break;
+            case JCallGraphRecorder::DATA_FROM_CACHE:    table | "Cache"; break;
+            case JCallGraphRecorder::DATA_FROM_SOURCE:   table | "Source"; break;
+            case JCallGraphRecorder::DATA_FROM_FACTORY:  table | "Factory"; break;
+        }
+        table | edge.call_count;
+        table | (edge.total_ns / 1e6 / edge.call_count);
+        table | (edge.max_ns / 1e6);
+        table | (edge.total_ns / 1e6);
+    }
+    table.Render(os);
+    os << "  " << GetSampledEventCount() << " events sampled";
+    auto dropped = GetDroppedNodeCount();
+    if (dropped != 0) {
+        os << ", " << dropped << " calls dropped because the per-event buffer was full";
+    }
+    os << std::endl;
+}
+
@@ -0,0 +1,65 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#pragma once
+
+#include <JANA/Utils/JCallGraphRecorder.h>
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+/// JCallGraphSummary aggregates the call graphs of many events into a single process-wide call graph with timings.
+/// It is the compact alternative to keeping every JCallGraphNode of every event: each JCallGraphRecorder in summary
+/// mode records integer ids and durations into a fixed-size buffer, and merges that buffer in here once per sampled
+/// event. See jana:call_graph_summary.
+class JCallGraphSummary {
+public:
+    struct Edge {
+        std::string caller_name;
+        std::string caller_tag;
+        std::string callee_name;
+        std::string callee_tag;
+        JCallGraphRecorder::JDataSource data_source = JCallGraphRecorder::DATA_NOT_AVAILABLE;
+        uint64_t call_count = 0;
+        uint64_t total_ns = 0;
+        uint64_t max_ns = 0;
+    };
+
+private:
+    struct EdgeStats {
+        uint64_t call_count = 0;
+        uint64_t total_ns = 0;
+        uint64_t max_ns = 0;
+    };
+
+    mutable std::mutex m_mutex;
+    std::map<std::pair<std::string, std::string>, uint32_t> m_ids;
+    std::vector<std::pair<std::string, std::string>> m_names;
+    // Keyed on (caller_id << 32 | callee_id) and then indexed by JDataSource, so that Merge() is cheap
+    std::unordered_map<uint64_t, std::array<EdgeStats, JCallGraphRecorder::DATA_FROM_FACTORY+1>> m_edges;
+    uint64_t m_sampled_event_count = 0;
+    uint64_t m_dropped_node_count = 0;
+
+public:
+    /// Returns the id for a (factory name, tag) pair, assigning a new one the first time the pair is seen.
+    /// Ids are only meaningful to the JCallGraphSummary that issued them.
+    uint32_t Intern(const std::string& name, const std::string& tag);
+
+    /// Adds one sampled event's worth of calls. dropped_node_count is the number of calls that didn't fit in the buffer.
+    void Merge(const std::vector<JCallGraphRecorder::JCompactNode>& nodes, size_t dropped_node_count);
+
+    std::vector<Edge> GetEdges() const;
+    uint64_t GetSampledEventCount() const;
+    uint64_t GetDroppedNodeCount() const;
+
+    /// Prints one row per (caller, callee, data source), ordered by total time spent
+    void Print(std::ostream& os) const;
+};
+
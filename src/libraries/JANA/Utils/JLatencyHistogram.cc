@@ -0,0 +1,105 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#include "JLatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace {
+std::atomic<size_t> g_next_shard {0};
+}
+
+thread_local JLatencyHistogram::SelfTimer* JLatencyHistogram::SelfTimer::s_current = nullptr;
+
+size_t JLatencyHistogram::GetBucket(uint64_t duration_ns) {
+    if (duration_ns < kSubBucketCount) {
+        return duration_ns;
+    }
+    size_t msb = 63 - __builtin_clzll(duration_ns);
+    size_t sub_bucket = (duration_ns >> (msb - kSubBucketBits)) & (kSubBucketCount - 1);
+    return (msb - kSubBucketBits + 1) * kSubBucketCount + sub_bucket;
+}
+
+uint64_t JLatencyHistogram::GetBucketLowerBound(size_t bucket) {
+    if (bucket < kSubBucketCount) {
+        return bucket;
+    }
+    size_t msb = bucket / kSubBucketCount + kSubBucketBits - 1;
+    uint64_t sub_bucket = bucket % kSubBucketCount;
+    return (kSubBucketCount + sub_bucket) << (msb - kSubBucketBits);
+}
+
+uint64_t JLatencyHistogram::GetBucketUpperBound(size_t bucket) {
+    if (bucket < kSubBucketCount) {
+        return bucket;
+    }
+    size_t msb = bucket / kSubBucketCount + kSubBucketBits - 1;
+    return GetBucketLowerBound(bucket) + ((uint64_t(1) << (msb - kSubBucketBits)) - 1);
+}
+
+void JLatencyHistogram::Record(uint64_t duration_ns) {
+    // Each thread sticks to one shard for its whole lifetime
+    thread_local size_t shard_index = g_next_shard.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+    auto& shard = m_shards[shard_index];
+
+    shard.bucket_counts[GetBucket(duration_ns)].fetch_add(1, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    shard.total_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+    auto max_ns = shard.max_ns.load(std::memory_order_relaxed);
+    while (duration_ns > max_ns && !shard.max_ns.compare_exchange_weak(max_ns, duration_ns, std::memory_order_relaxed)) {}
+}
+
+JLatencyHistogram::Snapshot JLatencyHistogram::GetSnapshot() const {
+    // The shards keep changing underneath us, so the totals might be off by the handful of calls that were
+    // being recorded at the time. That's fine for reporting purposes.
+    Snapshot snapshot;
+    for (const auto& shard : m_shards) {
+        snapshot.count += shard.count.load(std::memory_order_relaxed);
+        snapshot.total_ns += shard.total_ns.load(std::memory_order_relaxed);
+        snapshot.max_ns = std::max(snapshot.max_ns, shard.max_ns.load(std::memory_order_relaxed));
+        for (size_t bucket=0; bucket<kBucketCount; ++bucket) {
+            snapshot.bucket_counts[bucket] += shard.bucket_counts[bucket].load(std::memory_order_relaxed);
+        }
+    }
+    return snapshot;
+}
+
+double JLatencyHistogram::Snapshot::GetMeanNs() const {
+    return (count == 0) ? 0.0 : static_cast<double>(total_ns) / count;
+}
+
+double JLatencyHistogram::Snapshot::GetQuantileNs(double quantile) const {
+    uint64_t total_count = 0;
+    for (auto bucket_count : bucket_counts) {
+        total_count += bucket_count;
+    }
+    if (total_count == 0) {
+        return 0.0;
+    }
+    auto rank = static_cast<uint64_t>(std::ceil(quantile * total_count));
+    rank = std::min(std::max(rank, uint64_t(1)), total_count);
+
+    uint64_t cumulative_count = 0;
+    for (size_t bucket=0; bucket<kBucketCount; ++bucket) {
+        cumulative_count += bucket_counts[bucket];
+        if (cumulative_count >= rank) {
+            auto lower = GetBucketLowerBound(bucket);
+            auto upper = GetBucketUpperBound(bucket);
+            double midpoint = lower + (upper - lower) / 2.0;
+            return std::min(midpoint, static_cast<double>(max_ns));
+        }
+    }
+    return static_cast<double>(max_ns);
+}
+
+void JLatencyHistogram::Snapshot::Merge(const Snapshot& other) {
+    count += other.count;
+    total_ns += other.total_ns;
+    max_ns = std::max(max_ns, other.max_ns);
+    for (size_t bucket=0; bucket<kBucketCount; ++bucket) {
+        bucket_counts[bucket] += other.bucket_counts[bucket];
+    }
+}
+
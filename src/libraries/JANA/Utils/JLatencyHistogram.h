@@ -0,0 +1,108 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+
+/// JLatencyHistogram records durations into log-spaced buckets: four per power of two, so any quantile it reports is
+/// within about 20% of the true value, no matter whether the durations are nanoseconds or minutes. Record() is
+/// lock-free. Each thread writes to one of several cache-line-aligned shards so that pooled copies
+/// of the same factory running on different workers don't contend, and GetSnapshot() merges the shards on read.
+/// See jana:latency_histograms.
+class JLatencyHistogram {
+public:
+    static constexpr size_t kSubBucketBits = 2;
+    static constexpr size_t kSubBucketCount = 1 << kSubBucketBits;
+    static constexpr size_t kBucketCount = 64 * kSubBucketCount;
+    static constexpr size_t kShardCount = 8;
+
+    struct Snapshot {
+        uint64_t count = 0;
+        uint64_t total_ns = 0;
+        uint64_t max_ns = 0;
+        std::array<uint64_t, kBucketCount> bucket_counts {};
+
+        double GetMeanNs() const;
+
+        /// Returns the midpoint of the bucket containing the given quantile, e.g. 0.99 for the p99, capped at max_ns
+        double GetQuantileNs(double quantile) const;
+
+        void Merge(const Snapshot& other);
+    };
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, kBucketCount> bucket_counts {};
+        std::atomic<uint64_t> count {0};
+        std::atomic<uint64_t> total_ns {0};
+        std::atomic<uint64_t> max_ns {0};
+    };
+
+    std::array<Shard, kShardCount> m_shards;
+
+public:
+    void Record(uint64_t duration_ns);
+    Snapshot GetSnapshot() const;
+
+    static size_t GetBucket(uint64_t duration_ns);
+    static uint64_t GetBucketLowerBound(size_t bucket);
+    static uint64_t GetBucketUpperBound(size_t bucket);
+
+    /// Records the time until it goes out of scope. Does nothing if the histogram is null, i.e. disabled.
+    class Timer {
+        JLatencyHistogram* m_histogram;
+        std::chrono::steady_clock::time_point m_start_time;
+    public:
+        explicit Timer(JLatencyHistogram* histogram) : m_histogram(histogram) {
+            if (m_histogram != nullptr) m_start_time = std::chrono::steady_clock::now();
+        }
+        ~Timer() {
+            if (m_histogram != nullptr) {
+                auto duration = std::chrono::steady_clock::now() - m_start_time;
+                m_histogram->Record(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+            }
+        }
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+    };
+
+    /// Like Timer, but leaves out the time spent inside any SelfTimers nested within it on the same thread, e.g. the
+    /// upstream factories that a factory's Process() triggers. A SelfTimer with a null histogram records nothing itself,
+    /// but still hides its duration from the enclosing SelfTimer.
+    class SelfTimer {
+        static thread_local SelfTimer* s_current;
+        JLatencyHistogram* m_histogram;
+        SelfTimer* m_parent;
+        std::chrono::steady_clock::time_point m_start_time;
+        uint64_t m_nested_ns = 0;
+    public:
+        explicit SelfTimer(JLatencyHistogram* histogram) : m_histogram(histogram), m_parent(s_current) {
+            if (m_histogram != nullptr || m_parent != nullptr) {
+                m_start_time = std::chrono::steady_clock::now();
+                s_current = this;
+            }
+        }
+        ~SelfTimer() {
+            if (m_histogram != nullptr || m_parent != nullptr) {
+                auto duration = std::chrono::steady_clock::now() - m_start_time;
+                uint64_t duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+                if (m_histogram != nullptr) {
+                    m_histogram->Record((duration_ns > m_nested_ns) ? duration_ns - m_nested_ns : 0);
+                }
+                if (m_parent != nullptr) {
+                    m_parent->m_nested_ns += duration_ns;
+                }
+                s_current = m_parent;
+            }
+        }
+        SelfTimer(const SelfTimer&) = delete;
+        SelfTimer& operator=(const SelfTimer&) = delete;
+    };
+};
+
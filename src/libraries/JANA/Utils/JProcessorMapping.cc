@@ -62,18 +62,7 @@ void JProcessorMapping::initialize(AffinityStrategy affinity, LocalityStrategy l
         Row row;
         int count = sscanf(buffer, "%zu,%zu,%zu,%zu", &row.cpu_id, &row.core_id, &row.numa_domain_id, &row.socket_id);
         if (count == 4) {
-            switch (m_locality_strategy) {
-                case LocalityStrategy::CpuLocal:        row.location_id = row.cpu_id; break;
-                case LocalityStrategy::CoreLocal:       row.location_id = row.core_id; break;
-                case LocalityStrategy::NumaDomainLocal: row.location_id = row.numa_domain_id; break;
-                case LocalityStrategy::SocketLocal:     row.location_id = row.socket_id; break;
-                case LocalityStrategy::Global:
-                default:                                row.location_id = 0; break;
-            }
-            if (row.location_id >= m_loc_count) {
-                // Assume all of these ids are zero-indexed and contiguous
-                m_loc_count = row.location_id + 1;
-            }
+            assign_location(row);
             m_mapping.push_back(row);
         }
         else {
@@ -81,18 +70,7 @@ void JProcessorMapping::initialize(AffinityStrategy affinity, LocalityStrategy l
             int count = sscanf(buffer, "%zu,%zu,,%zu", &row.cpu_id, &row.core_id, &row.socket_id);
             row.numa_domain_id = row.socket_id;
             if (count == 3) {
-                switch (m_locality_strategy) {
-                    case LocalityStrategy::CpuLocal:        row.location_id = row.cpu_id; break;
-                    case LocalityStrategy::CoreLocal:       row.location_id = row.core_id; break;
-                    case LocalityStrategy::NumaDomainLocal: row.location_id = row.numa_domain_id; break;
-                    case LocalityStrategy::SocketLocal:     row.location_id = row.socket_id; break;
-                    case LocalityStrategy::Global:
-                    default:                                row.location_id = 0; break;
-                }
-                if (row.location_id >= m_loc_count) {
-                    // Assume all of these ids are zero-indexed and contiguous
-                    m_loc_count = row.location_id + 1;
-                }
+                assign_location(row);
                 m_mapping.push_back(row);
             }
 
@@ -141,6 +119,79 @@ void JProcessorMapping::initialize(AffinityStrategy affinity, LocalityStrategy l
     m_initialized = true;
 }
 
+void JProcessorMapping::assign_location(Row& row) {
+    switch (m_locality_strategy) {
+        case LocalityStrategy::CpuLocal:        row.location_id = row.cpu_id; break;
+        case LocalityStrategy::CoreLocal:       row.location_id = row.core_id; break;
+        case LocalityStrategy::NumaDomainLocal: row.location_id = row.numa_domain_id; break;
+        case LocalityStrategy::SocketLocal:     row.location_id = row.socket_id; break;
+        case LocalityStrategy::Global:
+        default:                                row.location_id = 0; break;
+    }
+    if (row.location_id >= m_loc_count) {
+        // Assume all of these ids are zero-indexed and contiguous
+        m_loc_count = row.location_id + 1;
+    }
+}
+
+void JProcessorMapping::initialize_simulated(size_t socket_count, size_t numa_domains_per_socket, size_t cpus_per_numa_domain,
+                                             LocalityStrategy locality) {
+
+    m_affinity_strategy = AffinityStrategy::None;
+    m_locality_strategy = locality;
+    m_loc_count = 1;
+    m_mapping.clear();
+
+    size_t cpu_id = 0;
+    for (size_t socket_id=0; socket_id<socket_count; ++socket_id) {
+        for (size_t numa_offset=0; numa_offset<numa_domains_per_socket; ++numa_offset) {
+            for (size_t cpu_offset=0; cpu_offset<cpus_per_numa_domain; ++cpu_offset) {
+                Row row;
+                row.cpu_id = cpu_id;
+                row.core_id = cpu_id;
+                row.numa_domain_id = socket_id * numa_domains_per_socket + numa_offset;
+                row.socket_id = socket_id;
+                assign_location(row);
+                m_mapping.push_back(row);
+                cpu_id += 1;
+            }
+        }
+    }
+    // Interleave the locations so that scaling up a few threads at a time uses every location,
+    // the same way the real cpu ids do on most multi-socket machines
+    std::stable_sort(m_mapping.begin(), m_mapping.end(), [cpus_per_numa_domain](const Row& lhs, const Row& rhs) {
+        return (lhs.cpu_id % cpus_per_numa_domain) < (rhs.cpu_id % cpus_per_numa_domain);
+    });
+    m_error_msg = "";
+    m_initialized = !m_mapping.empty();
+}
+
+size_t JProcessorMapping::get_loc_distance(size_t loc_a, size_t loc_b) const {
+    if (loc_a == loc_b) return 0;
+    size_t distance = 4;
+    for (const Row& a : m_mapping) {
+        if (a.location_id != loc_a) continue;
+        for (const Row& b : m_mapping) {
+            if (b.location_id != loc_b) continue;
+            if (a.core_id == b.core_id) distance = std::min<size_t>(distance, 1);
+            else if (a.numa_domain_id == b.numa_domain_id) distance = std::min<size_t>(distance, 2);
+            else if (a.socket_id == b.socket_id) distance = std::min<size_t>(distance, 3);
+        }
+    }
+    return distance;
+}
+
+std::vector<size_t> JProcessorMapping::get_neighbor_locs(size_t loc) const {
+    std::vector<size_t> neighbors;
+    for (size_t offset=1; offset<m_loc_count; ++offset) {
+        neighbors.push_back((loc + offset) % m_loc_count);
+    }
+    std::stable_sort(neighbors.begin(), neighbors.end(), [&](size_t lhs, size_t rhs) {
+        return get_loc_distance(loc, lhs) < get_loc_distance(loc, rhs);
+    });
+    return neighbors;
+}
+
 std::ostream& operator<<(std::ostream& os, const JProcessorMapping::AffinityStrategy& s) {
     switch (s) {
         case JProcessorMapping::AffinityStrategy::ComputeBound: os << "compute-bound (favor fewer hyperthreads)"; break;
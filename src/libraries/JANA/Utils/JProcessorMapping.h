@@ -5,6 +5,7 @@
 #pragma once
 #include <cstddef>
 #include <ostream>
+#include <string>
 #include <vector>
 
 class JProcessorMapping {
@@ -16,6 +17,12 @@ public:
 
     void initialize(AffinityStrategy affinity, LocalityStrategy locality);
 
+    /// Pretends that the machine has a regular layout of sockets, NUMA domains, and cpus, instead of querying lscpu.
+    /// This is for exercising locality-aware code paths on machines which don't have the real thing. Threads
+    /// are not pinned, since the simulated cpus needn't exist.
+    void initialize_simulated(size_t socket_count, size_t numa_domains_per_socket, size_t cpus_per_numa_domain,
+                              LocalityStrategy locality);
+
     inline size_t get_loc_count() const {
         return m_loc_count;
     }
@@ -36,6 +43,14 @@ public:
         return m_locality_strategy;
     }
 
+    /// Distance between two locations: 0 if they are the same, then increasing as the closest pair of cpus
+    /// shares a core (1), a NUMA domain (2), a socket (3), or nothing (4).
+    size_t get_loc_distance(size_t loc_a, size_t loc_b) const;
+
+    /// All locations other than `loc`, nearest first. Ties are broken by rotating away from `loc`,
+    /// so that equidistant locations don't all steal from the same victim first.
+    std::vector<size_t> get_neighbor_locs(size_t loc) const;
+
     friend std::ostream& operator<<(std::ostream& os, const JProcessorMapping& m);
     friend std::ostream& operator<<(std::ostream& os, const AffinityStrategy& s);
     friend std::ostream& operator<<(std::ostream& os, const LocalityStrategy& s);
@@ -50,6 +65,8 @@ private:
         size_t socket_id;
     };
 
+    void assign_location(Row& row);
+
     AffinityStrategy m_affinity_strategy = AffinityStrategy::None;
     LocalityStrategy m_locality_strategy = LocalityStrategy::Global;
     std::vector<Row> m_mapping;
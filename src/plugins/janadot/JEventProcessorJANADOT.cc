@@ -12,6 +12,8 @@
 using namespace std;
 
 #include <JANA/JApplication.h>
+#include <JANA/Services/JComponentManager.h>
+#include <JANA/Utils/JCallGraphSummary.h>
 #include "JEventProcessorJANADOT.h"
 
 
@@ -20,7 +22,16 @@ extern "C"{
 void InitPlugin(JApplication *app){
 	InitJANAPlugin(app);
 	app->Add(new JEventProcessorJANADOT());
-    app->GetJParameterManager()->SetParameter("RECORD_CALL_STACK", true);
+
+	// This has to be decided here rather than in Init(), because JComponentManager reads these before Init() is called
+	bool use_summary = false;
+	app->SetDefaultParameter("janadot:use_summary", use_summary, "Build the graph from jana:call_graph_summary instead of record_call_stack. Much cheaper, and can be combined with jana:call_graph_sampling");
+	if (use_summary) {
+		app->GetJParameterManager()->SetParameter("jana:call_graph_summary", true);
+	}
+	else {
+		app->GetJParameterManager()->SetParameter("RECORD_CALL_STACK", true);
+	}
 }
 } // "C"
 
@@ -39,6 +50,7 @@ void JEventProcessorJANADOT::Init() {
     auto app = GetApplication();
 	app->SetDefaultParameter("janadot:output_file", m_output_filename, "Output filename for call graph visualization");
 	app->SetDefaultParameter("janadot:weight_edges", m_weight_edges, "Use edge weight (penwidth) to represent the percent of time spent in call");
+	app->SetDefaultParameter("janadot:use_summary", m_use_summary, "Build the graph from jana:call_graph_summary instead of record_call_stack. Much cheaper, and can be combined with jana:call_graph_sampling");
 
 	// Turn on call stack recording
 	force_all_factories_active = false;
@@ -122,6 +134,9 @@ void JEventProcessorJANADOT::Process(const std::shared_ptr<const JEvent>& event)
 		for(unsigned int i=0; i<factories.size(); i++)factories[i]->Create(event);
 	}
 
+	// In summary mode the framework aggregates the calls for us, and we pick them up in Finish()
+	if(m_use_summary) return;
+
 	// Get the call stack for ths event and add the results to our stats
 	auto stack = event->GetJCallGraphRecorder()->GetCallGraph();
 
@@ -130,48 +145,54 @@ void JEventProcessorJANADOT::Process(const std::shared_ptr<const JEvent>& event)
 
 	// Loop over the call stack elements and add in the values
 	for(unsigned int i=0; i<stack.size(); i++){
-
-		// Keep track of total time each factory spent waiting and being waited on
-		string nametag1 = MakeNametag(stack[i].caller_name, stack[i].caller_tag);
-		string nametag2 = MakeNametag(stack[i].callee_name, stack[i].callee_tag);
-
-		FactoryCallStats &fcallstats1 = factory_stats[nametag1];
-		FactoryCallStats &fcallstats2 = factory_stats[nametag2];
-
         auto delta_t_ms = std::chrono::duration_cast<std::chrono::milliseconds>(stack[i].end_time - stack[i].start_time).count();
-		fcallstats1.time_waiting += delta_t_ms;
-		fcallstats2.time_waited_on += delta_t_ms;
-
-		// Get pointer to CallStats object representing this calling pair
-		CallLink link;
-		link.caller_name = stack[i].caller_name;
-		link.caller_tag  = stack[i].caller_tag;
-		link.callee_name = stack[i].callee_name;
-		link.callee_tag  = stack[i].callee_tag;
-		CallStats &stats = call_links[link]; // get pointer to stats object or create if it doesn't exist
-		
-		switch(stack[i].data_source){
-            case JCallGraphRecorder::DATA_NOT_AVAILABLE:
-				stats.Ndata_not_available++;
-				stats.data_not_available_ms += delta_t_ms;
-				break;
-			case JCallGraphRecorder::DATA_FROM_CACHE:
-				fcallstats2.Nfrom_cache++;
-				stats.Nfrom_cache++;
-				stats.from_cache_ms += delta_t_ms;
-				break;
-			case JCallGraphRecorder::DATA_FROM_SOURCE:
-				fcallstats2.Nfrom_source++;
-				stats.Nfrom_source++;
-				stats.from_source_ms += delta_t_ms;
-				break;
-			case JCallGraphRecorder::DATA_FROM_FACTORY:
-				fcallstats2.Nfrom_factory++;
-				stats.Nfrom_factory++;
-				stats.from_factory_ms += delta_t_ms;
-				break;				
-		}
-		
+		AddCalls(stack[i].caller_name, stack[i].caller_tag, stack[i].callee_name, stack[i].callee_tag, stack[i].data_source, 1, delta_t_ms);
+	}
+}
+
+//------------------------------------------------------------------
+// AddCalls
+//------------------------------------------------------------------
+void JEventProcessorJANADOT::AddCalls(const string &caller_name, const string &caller_tag, const string &callee_name, const string &callee_tag, JCallGraphRecorder::JDataSource data_source, unsigned int ncalls, double delta_t_ms)
+{
+	// Keep track of total time each factory spent waiting and being waited on
+	string nametag1 = MakeNametag(caller_name, caller_tag);
+	string nametag2 = MakeNametag(callee_name, callee_tag);
+
+	FactoryCallStats &fcallstats1 = factory_stats[nametag1];
+	FactoryCallStats &fcallstats2 = factory_stats[nametag2];
+
+	fcallstats1.time_waiting += delta_t_ms;
+	fcallstats2.time_waited_on += delta_t_ms;
+
+	// Get pointer to CallStats object representing this calling pair
+	CallLink link;
+	link.caller_name = caller_name;
+	link.caller_tag  = caller_tag;
+	link.callee_name = callee_name;
+	link.callee_tag  = callee_tag;
+	CallStats &stats = call_links[link]; // get pointer to stats object or create if it doesn't exist
+
+	switch(data_source){
+        case JCallGraphRecorder::DATA_NOT_AVAILABLE:
+			stats.Ndata_not_available += ncalls;
+			stats.data_not_available_ms += delta_t_ms;
+			break;
+		case JCallGraphRecorder::DATA_FROM_CACHE:
+			fcallstats2.Nfrom_cache += ncalls;
+			stats.Nfrom_cache += ncalls;
+			stats.from_cache_ms += delta_t_ms;
+			break;
+		case JCallGraphRecorder::DATA_FROM_SOURCE:
+			fcallstats2.Nfrom_source += ncalls;
+			stats.Nfrom_source += ncalls;
+			stats.from_source_ms += delta_t_ms;
+			break;
+		case JCallGraphRecorder::DATA_FROM_FACTORY:
+			fcallstats2.Nfrom_factory += ncalls;
+			stats.Nfrom_factory += ncalls;
+			stats.from_factory_ms += delta_t_ms;
+			break;
 	}
 }
 
@@ -180,6 +201,14 @@ void JEventProcessorJANADOT::Process(const std::shared_ptr<const JEvent>& event)
 //------------------------------------------------------------------
 void JEventProcessorJANADOT::Finish()
 {
+	if(m_use_summary){
+		auto summary = GetApplication()->GetService<JComponentManager>()->GetCallGraphSummary();
+		if(summary != nullptr){
+			for(auto &edge : summary->GetEdges()){
+				AddCalls(edge.caller_name, edge.caller_tag, edge.callee_name, edge.callee_tag, edge.data_source, edge.call_count, edge.total_ns/1.0E6);
+			}
+		}
+	}
 
 	// In order to get the total time we have to first get a list of 
 	// the event processors (i.e. top-level callers). We can tell
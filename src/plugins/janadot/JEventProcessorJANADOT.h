@@ -22,6 +22,10 @@ class JEventProcessorJANADOT:public JEventProcessor
 	/// to produce the call graph in the end. Configuration parameters specific to [janadot
 	/// are:
 	/// 
+	/// janadot:use_summary  - Turns on jana:call_graph_summary instead of RECORD_CALL_STACK,
+	/// and builds the graph from the aggregated summary in Finish(). This is much cheaper
+	/// on large jobs, and can be combined with jana:call_graph_sampling.
+	/// 
 	/// JANADOT:GROUP:GroupName  - This is used to tell janadot to issue commands that will
 	/// cause dot to draw the graph using colors and/or a bounding box to identify members
 	/// of a group. 
@@ -154,7 +158,9 @@ class JEventProcessorJANADOT:public JEventProcessor
 		string focus_factory;
 		std::string m_output_filename = "jana.dot"; 
 		bool m_weight_edges = true;
+		bool m_use_summary = false;
 		
+		void AddCalls(const string &caller_name, const string &caller_tag, const string &callee_name, const string &callee_tag, JCallGraphRecorder::JDataSource data_source, unsigned int ncalls, double delta_t_ms);
 		void FindDecendents(string caller, set<string> &decendents);
 		void FindAncestors(string callee, set<string> &ancestors);
 		string MakeTimeString(double time_in_ms);
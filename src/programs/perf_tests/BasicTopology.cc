@@ -8,6 +8,7 @@
 #include <JANA/JApplication.h>
 #include <JANA/JFactoryGenerator.h>
 #include <JANA/CLI/JBenchmarker.h>
+#include <JANA/Engine/JExecutionEngine.h>
 #include <JANA/JEventUnfolder.h>
 #include <JANA/JEventProcessor.h>
 #include <JANA/JEventSource.h>
@@ -39,6 +40,7 @@ struct PEFac : public JFactory {
     Input<Data> data_in {this};
     Output<Data> data_out {this};
     Parameter<int> latency_us {this, "latency_us", 0};
+    Parameter<int> sleep_us {this, "sleep_us", 0}; // Simulates waiting on e.g. I/O or an accelerator
     PEFac() {
         SetPrefix("fac");
         SetLevel(JEventLevel::PhysicsEvent);
@@ -49,6 +51,9 @@ struct PEFac : public JFactory {
         auto x = data_in().at(0)->x * 10;
         data_out().push_back(new Data {x});
         JBenchUtils::consume_cpu_us(*latency_us);
+        if (*sleep_us > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(*sleep_us));
+        }
     };
 };
 
@@ -112,6 +117,158 @@ TEST_CASE("BasicTopology_Small") {
     benchmarker.RunUntilFinished();
 }
 
+TEST_CASE("BasicTopology_Mini_WorkStealing") {
+
+    LOG << "Running BasicTopology_Mini_WorkStealing";
+
+    // Same as BasicTopology_Mini, so the two rate curves can be compared directly.
+    // With zero latency everywhere, this measures pure scheduler overhead.
+    JApplication app;
+    app.SetParameterValue("jana:enable_work_stealing", true);
+    app.SetParameterValue("src:latency_us", 0);
+    app.SetParameterValue("fac:latency_us", 0);
+    app.SetParameterValue("proc:latency_us", 0);
+    app.SetParameterValue("benchmark:resultsdir", "docs/perf_tests");
+    app.SetParameterValue("benchmark:rates_filename", "basic_mini_stealing.dat");
+    app.SetParameterValue("benchmark:use_log_scale", true);
+    app.SetParameterValue("benchmark:minthreads", "1");
+    app.SetParameterValue("benchmark:maxthreads", "32");
+
+    app.Add(new PESrc);
+    app.Add(new PEProc);
+    app.Add(new JFactoryGeneratorT<PEFac>);
+
+    JBenchmarker benchmarker(&app);
+    benchmarker.RunUntilFinished();
+}
+
+TEST_CASE("BasicTopology_Small_WorkStealing") {
+
+    LOG << "Running BasicTopology_Small_WorkStealing";
+
+    // Same as BasicTopology_Small, so the two rate curves can be compared directly.
+    JApplication app;
+    app.SetParameterValue("jana:enable_work_stealing", true);
+    app.SetParameterValue("src:latency_us", 0);
+    app.SetParameterValue("fac:latency_us", 1000000/5000);   // 5 kHz
+    app.SetParameterValue("proc:latency_us", 0);
+    app.SetParameterValue("benchmark:resultsdir", "docs/perf_tests");
+    app.SetParameterValue("benchmark:rates_filename", "basic_small_stealing.dat");
+    app.SetParameterValue("benchmark:use_log_scale", true);
+    app.SetParameterValue("benchmark:minthreads", "1");
+    app.SetParameterValue("benchmark:maxthreads", "32");
+
+    app.Add(new PESrc);
+    app.Add(new PEProc);
+    app.Add(new JFactoryGeneratorT<PEFac>);
+
+    JBenchmarker benchmarker(&app);
+    benchmarker.RunUntilFinished();
+}
+
+void RunBatching(size_t max_batch_size) {
+    JApplication app;
+    app.SetParameterValue("nthreads", 4);
+    app.SetParameterValue("jana:nevents", 200000);
+    app.SetParameterValue("jana:max_inflight_events", 64);
+    app.SetParameterValue("jana:max_batch_size", max_batch_size);
+    app.SetParameterValue("jana:loglevel", "warn");
+    app.SetParameterValue("src:latency_us", 0);
+    app.SetParameterValue("fac:latency_us", 2);
+    app.SetParameterValue("proc:latency_us", 0);
+
+    app.Add(new PESrc);
+    app.Add(new PEProc);
+    app.Add(new JFactoryGeneratorT<PEFac>);
+    app.Run();
+
+    auto perf = app.GetService<JExecutionEngine>()->GetPerf();
+    LOG << "BasicTopology_Mini_Batching: jana:max_batch_size=" << max_batch_size << "\n"
+        << "  Throughput [Hz]:          " << perf.throughput_hz << "\n"
+        << "  Total scheduler time [s]: " << perf.scheduler_time_ms / 1000.0 << "\n"
+        << "  Total idle time [s]:      " << perf.idle_time_ms / 1000.0;
+}
+
+TEST_CASE("BasicTopology_Mini_Batching") {
+
+    LOG << "Running BasicTopology_Mini_Batching";
+
+    // A very light map arrow (2 us/event), where the trip through the scheduler costs about as much as the
+    // work itself. With batching, the scheduler time should drop by roughly the average batch size.
+    RunBatching(1);
+    RunBatching(32);
+}
+
+void RunSchedulerPolicy(std::string policy) {
+    JApplication app;
+    app.SetParameterValue("nthreads", 4);
+    app.SetParameterValue("jana:nevents", 5000);
+    app.SetParameterValue("jana:max_inflight_events", 32);
+    app.SetParameterValue("jana:scheduler_policy", policy);
+    app.SetParameterValue("jana:loglevel", "warn");
+    app.SetParameterValue("src:latency_us", 20);
+    app.SetParameterValue("fac:latency_us", 200);
+    app.SetParameterValue("proc:latency_us", 20);
+
+    app.Add(new PESrc);
+    app.Add(new PEProc);
+    app.Add(new JFactoryGeneratorT<PEFac>);
+    app.Run();
+
+    auto perf = app.GetService<JExecutionEngine>()->GetPerf();
+    LOG << "BasicTopology_Mini_SchedulerPolicy: jana:scheduler_policy=" << policy << "\n"
+        << "  Throughput [Hz]:          " << perf.throughput_hz << "\n"
+        << "  Event latency p50 [ms]:   " << perf.event_latency_p50_ms << "\n"
+        << "  Event latency p99 [ms]:   " << perf.event_latency_p99_ms;
+}
+
+TEST_CASE("BasicTopology_Mini_SchedulerPolicy") {
+
+    LOG << "Running BasicTopology_Mini_SchedulerPolicy";
+
+    // With far more events in flight than threads, round-robin keeps pulling fresh events from the source
+    // while older ones wait in the queues. Drain-first should show a much lower latency at the same throughput.
+    RunSchedulerPolicy("round_robin");
+    RunSchedulerPolicy("drain_first");
+    RunSchedulerPolicy("occupancy_weighted");
+}
+
+void RunNumaStealing(bool enable_stealing) {
+    JApplication app;
+    app.SetParameterValue("nthreads", 3);
+    app.SetParameterValue("jana:nevents", 10000);
+    app.SetParameterValue("jana:max_inflight_events", 16);
+    app.SetParameterValue("jana:locality", 1); // Socket-local
+    app.SetParameterValue("jana:simulated_numa_layout", "2x1x2");
+    app.SetParameterValue("jana:enable_stealing", enable_stealing);
+    app.SetParameterValue("jana:loglevel", "warn");
+    app.SetParameterValue("src:latency_us", 20);
+    app.SetParameterValue("fac:latency_us", 20);
+    app.SetParameterValue("fac:sleep_us", 1000); // Sleep rather than spin, so the result doesn't depend on the core count
+    app.SetParameterValue("proc:latency_us", 20);
+
+    app.Add(new PESrc);
+    app.Add(new PEProc);
+    app.Add(new JFactoryGeneratorT<PEFac>);
+    app.Run();
+
+    auto perf = app.GetService<JExecutionEngine>()->GetPerf();
+    LOG << "BasicTopology_Mini_NumaStealing: jana:enable_stealing=" << enable_stealing << "\n"
+        << "  Throughput [Hz]:          " << perf.throughput_hz << "\n"
+        << "  Total idle time [s]:      " << perf.idle_time_ms / 1000.0 << "\n"
+        << "  Events stolen [count]:    " << perf.stolen_event_count;
+}
+
+TEST_CASE("BasicTopology_Mini_NumaStealing") {
+
+    LOG << "Running BasicTopology_Mini_NumaStealing";
+
+    // Two simulated sockets with two workers each. The source pushes each event to the location of whichever
+    // worker ran it, so without stealing the other socket's workers sit idle while events pile up.
+    RunNumaStealing(false);
+    RunNumaStealing(true);
+}
+
 TEST_CASE("BasicTopology_Small_Saturation") {
 
     LOG << "Running BasicTopology_Small_Saturation";
@@ -0,0 +1,100 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#include <catch.hpp>
+
+#include <JANA/JLogger.h>
+#include <JANA/Topology/JEventQueue.h>
+#include <JANA/Topology/JLockFreeEventQueue.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+
+namespace jana::perftest::queues {
+
+// Each trip takes an event out of a free list, passes it through a queue, and returns it to the free list,
+// the same way events circulate between a JEventPool and an arrow's input queue. Every thread hammers
+// the same two queues, so this measures the queues under maximum contention.
+
+constexpr size_t kEventCount = 256;
+constexpr size_t kTotalTrips = 1000000;
+
+struct MutexGuarded {
+    JEventQueue free_list {kEventCount, 1};
+    JEventQueue queue {kEventCount, 1};
+    std::mutex mutex; // Stands in for the JExecutionEngine mutex
+
+    void Push(JEventQueue& q, JEvent* event) {
+        std::lock_guard<std::mutex> lock(mutex);
+        q.Push(event, 0);
+    }
+    JEvent* Pop(JEventQueue& q) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return q.Pop(0);
+    }
+};
+
+struct LockFree {
+    JLockFreeEventQueue free_list {kEventCount, 1};
+    JLockFreeEventQueue queue {kEventCount, 1};
+
+    void Push(JLockFreeEventQueue& q, JEvent* event) {
+        q.Push(event, 0);
+    }
+    JEvent* Pop(JLockFreeEventQueue& q) {
+        return q.Pop(0);
+    }
+};
+
+template <typename QueuesT>
+double MeasureTripsPerSecond(size_t thread_count) {
+    QueuesT queues;
+    std::vector<JEvent> events(kEventCount);
+    for (auto& event : events) {
+        queues.Push(queues.free_list, &event);
+    }
+
+    size_t trips_per_thread = kTotalTrips / thread_count;
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (size_t t=0; t<thread_count; ++t) {
+        threads.emplace_back([&]() {
+            size_t trips = 0;
+            while (trips < trips_per_thread) {
+                JEvent* event = queues.Pop(queues.free_list);
+                if (event != nullptr) {
+                    queues.Push(queues.queue, event);
+                }
+                event = queues.Pop(queues.queue);
+                if (event != nullptr) {
+                    queues.Push(queues.free_list, event);
+                    trips += 1;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto duration_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return (trips_per_thread * thread_count) / duration_s;
+}
+
+TEST_CASE("QueueContention") {
+
+    LOG << "Running QueueContention";
+    LOG << "threads  mutex_guarded[Mtrips/s]  lock_free[Mtrips/s]  speedup";
+
+    for (size_t thread_count=1; thread_count<=256; thread_count*=2) {
+        double mutex_guarded = MeasureTripsPerSecond<MutexGuarded>(thread_count);
+        double lock_free = MeasureTripsPerSecond<LockFree>(thread_count);
+        LOG << thread_count << "  " << mutex_guarded / 1e6 << "  " << lock_free / 1e6 << "  " << lock_free / mutex_guarded;
+    }
+}
+
+} // namespace jana::perftest::queues
+
+
@@ -9,6 +9,13 @@
 #include <JANA/JEventSource.h>
 #include <JANA/Utils/JBenchUtils.h>
 
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 
 namespace jana::perftest::source {
 
@@ -31,6 +38,178 @@ struct Src : public JEventSource {
     };
 };
 
+// StreamingSrc simulates a DAQ: A producer thread which JANA doesn't own delivers events at a fixed rate,
+// and Emit() returns FailureTryAgain whenever nothing has arrived yet.
+using Clock = std::chrono::steady_clock;
+struct StreamData { Clock::time_point arrival_time; };
+
+struct StreamingSrc : public JEventSource {
+
+    Parameter<int> rate_hz {this, "rate_hz", 2000};
+    Parameter<int> event_count {this, "event_count", 2000};
+    Parameter<bool> notify {this, "notify", false};
+    Output<StreamData> data_out {this};
+
+    std::mutex mutex;
+    std::deque<Clock::time_point> arrivals;
+    int produced_count = 0;
+    std::thread producer;
+
+    StreamingSrc() {
+        SetPrefix("stream");
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        data_out.SetShortName("1");
+    }
+    ~StreamingSrc() {
+        if (producer.joinable()) producer.join();
+    }
+    void Open() override {
+        producer = std::thread([this](){
+            auto start_time = Clock::now();
+            auto period = std::chrono::nanoseconds(1'000'000'000 / *rate_hz);
+            for (int i=0; i<*event_count; ++i) {
+                std::this_thread::sleep_until(start_time + i*period);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    arrivals.push_back(Clock::now());
+                    produced_count += 1;
+                }
+                if (*notify) NotifyDataAvailable();
+            }
+        });
+    }
+    void Close() override {
+        if (producer.joinable()) producer.join();
+    }
+    JEventSource::Result Emit(JEvent&) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (arrivals.empty()) {
+            return (produced_count == *event_count) ? Result::FailureFinished : Result::FailureTryAgain;
+        }
+        data_out().push_back(new StreamData {arrivals.front()});
+        arrivals.pop_front();
+        return Result::Success;
+    };
+};
+
+struct LatencyProc : public JEventProcessor {
+
+    Input<StreamData> data_in {this};
+    std::vector<double> latencies_us;
+
+    LatencyProc() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        data_in.SetDatabundleName("1");
+    }
+    void ProcessSequential(const JEvent&) override {
+        auto latency = Clock::now() - data_in().at(0)->arrival_time;
+        latencies_us.push_back(std::chrono::duration<double, std::micro>(latency).count());
+    };
+};
+
+void RunStreaming(std::string name, int backoff_ms, bool notify) {
+    JApplication app;
+    app.SetParameterValue("nthreads", 8);
+    app.SetParameterValue("jana:backoff_interval", backoff_ms);
+    app.SetParameterValue("stream:notify", notify);
+    app.SetParameterValue("jana:loglevel", "warn");
+    auto proc = new LatencyProc;
+    app.Add(new StreamingSrc);
+    app.Add(proc);
+
+    auto start_cpu = std::clock();
+    auto start_time = Clock::now();
+    app.Run();
+    double cpu_s = double(std::clock() - start_cpu) / CLOCKS_PER_SEC;
+    double wall_s = std::chrono::duration<double>(Clock::now() - start_time).count();
+
+    auto& latencies = proc->latencies_us;
+    std::sort(latencies.begin(), latencies.end());
+    double mean_us = 0;
+    for (double l : latencies) mean_us += l;
+    mean_us /= latencies.size();
+    double p50_us = latencies[latencies.size() / 2];
+    double p99_us = latencies[(latencies.size() * 99) / 100];
+
+    LOG << "SourceTopology_Streaming: " << name << ": " << latencies.size() << " events in " << wall_s << " s\n"
+        << "  CPU used [cores]:         " << cpu_s / wall_s << "\n"
+        << "  Latency mean [us]:        " << mean_us << "\n"
+        << "  Latency p50 [us]:         " << p50_us << "\n"
+        << "  Latency p99 [us]:         " << p99_us;
+}
+
+TEST_CASE("SourceTopology_Streaming") {
+    // Compares how much CPU the thread team burns while waiting on a slow external data stream,
+    // and how long each event waits before being processed, for each way of polling the source.
+    LOG << "Running SourceTopology_Streaming";
+    RunStreaming("Polling (jana:backoff_interval=0)", 0, false);
+    RunStreaming("Exponential backoff (jana:backoff_interval=10)", 10, false);
+    RunStreaming("Backoff with NotifyDataAvailable()", 10, true);
+}
+
+// BarrierSrc emits a barrier event every so often, the way slow-controls updates or run boundaries would
+struct BarrierSrc : public JEventSource {
+
+    Parameter<int> barrier_interval {this, "barrier_interval", 100};
+    Parameter<int> event_count {this, "event_count", 5000};
+
+    BarrierSrc() {
+        SetPrefix("barrier");
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+    }
+    JEventSource::Result Emit(JEvent& event) override {
+        if (GetEmittedEventCount() == (size_t) *event_count) {
+            return Result::FailureFinished;
+        }
+        event.SetSequential(event.GetEventNumber() % *barrier_interval == 0);
+        return Result::Success;
+    };
+};
+
+struct BarrierProc : public JEventProcessor {
+
+    Parameter<int> latency_us {this, "latency_us", 500};
+    size_t event_count = 0;
+    size_t barrier_count = 0;
+
+    BarrierProc() {
+        SetPrefix("barrier_proc");
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+    }
+    void ProcessParallel(const JEvent&) override {
+        JBenchUtils::consume_cpu_us(*latency_us);
+    };
+    void ProcessSequential(const JEvent& event) override {
+        event_count += 1;
+        if (event.GetSequential()) barrier_count += 1;
+    };
+};
+
+void RunBarriers(std::string name, bool pipeline_barriers) {
+    JApplication app;
+    app.SetParameterValue("nthreads", 8);
+    app.SetParameterValue("jana:pipeline_barriers", pipeline_barriers);
+    app.SetParameterValue("jana:loglevel", "warn");
+    auto proc = new BarrierProc;
+    app.Add(new BarrierSrc);
+    app.Add(proc);
+
+    auto start_time = Clock::now();
+    app.Run();
+    double wall_s = std::chrono::duration<double>(Clock::now() - start_time).count();
+
+    LOG << "SourceTopology_Barriers: " << name << ": " << proc->event_count << " events, "
+        << proc->barrier_count << " barriers in " << wall_s << " s\n"
+        << "  Throughput [Hz]:          " << proc->event_count / wall_s;
+}
+
+TEST_CASE("SourceTopology_Barriers") {
+    // Compares throughput when each barrier event drains the topology against when events keep flowing around it
+    LOG << "Running SourceTopology_Barriers";
+    RunBarriers("Draining", false);
+    RunBarriers("Pipelined (jana:pipeline_barriers=1)", true);
+}
+
 TEST_CASE("SourceTopology_Mini") {
     LOG << "Running SourceTopology_Mini";
     JApplication app;
@@ -6,6 +6,7 @@
 #include <JANA/JFactoryGenerator.h>
 #include <JANA/CLI/JBenchmarker.h>
 #include <JANA/JEventUnfolder.h>
+#include <JANA/JEventFolder.h>
 #include <JANA/JEventProcessor.h>
 #include <JANA/JEventSource.h>
 #include <JANA/Utils/JBenchUtils.h>
@@ -76,10 +77,34 @@ struct Unf : public JEventUnfolder {
     };
 };
 
+struct ParUnf : public JEventUnfolder {
+    Parameter<int> latency_us {this, "latency_us", 0};
+
+    ParUnf() {
+        SetPrefix("unf");
+        SetParentLevel(JEventLevel::Block);
+        SetChildLevel(JEventLevel::PhysicsEvent);
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        EnableParallelUnfold();
+    }
+    JEventUnfolder::Result Unfold(const JEvent& parent, JEvent& child, int child_nr) override {
+        // Same as Unf, but without Input/Output members, which parallel unfolding doesn't support
+        auto x = parent.Get<Data>("2").at(0)->x * 10 + child_nr;
+        child.Insert(new Data{x}, "3");
+        JBenchUtils::consume_cpu_us(*latency_us);
+
+        if (child_nr == 9) {
+            return Result::NextChildNextParent;
+        }
+        return Result::NextChildKeepParent;
+    };
+};
+
 struct PEFac : public JFactory {
     Input<Data> data_in {this};
     Output<Data> data_out {this};
     Parameter<int> latency_us {this, "latency_us", 0};
+    Parameter<int> straggler_latency_us {this, "straggler_latency_us", 0};
     PEFac() {
         SetPrefix("pefac");
         SetLevel(JEventLevel::PhysicsEvent);
@@ -90,6 +115,28 @@ struct PEFac : public JFactory {
         auto x = data_in().at(0)->x * 10;
         data_out().push_back(new Data {x});
         JBenchUtils::consume_cpu_us(*latency_us);
+        if (data_in().at(0)->x % 10 == 0) {
+            // The first child of each block is a straggler
+            JBenchUtils::consume_cpu_us(*straggler_latency_us);
+        }
+    };
+};
+
+struct Fld : public JEventFolder {
+    Input<Data> child_data_in {this};
+    Parameter<int> latency_us {this, "latency_us", 0};
+    size_t sum = 0;
+
+    Fld(bool commutative) {
+        SetPrefix("fld");
+        SetParentLevel(JEventLevel::Block);
+        SetChildLevel(JEventLevel::PhysicsEvent);
+        child_data_in.SetDatabundleName("4");
+        EnableCommutativeFold(commutative);
+    }
+    void Fold(const JEvent&, JEvent&, int) override {
+        sum += child_data_in().at(0)->x;
+        JBenchUtils::consume_cpu_us(*latency_us);
     };
 };
 
@@ -287,7 +334,150 @@ TEST_CASE("UnfoldTopology_Large_Saturation") {
 }
 
 
+
+TEST_CASE("UnfoldTopology_UnfoldBound") {
+    LOG << "Running UnfoldTopology_UnfoldBound";
+
+    JApplication app;
+    app.SetParameterValue("bsrc:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("bfac:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("unf:latency_us", 1'000'000 / 5'000); // 5 kHz
+    app.SetParameterValue("pefac:latency_us", 1'000'000 / 20'000); // 20 kHz
+    app.SetParameterValue("peproc:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("benchmark:resultsdir", JANA_PERF_TESTS_RESULTS_DIR); // Not checked in, unlike docs/perf_tests
+    app.SetParameterValue("benchmark:rates_filename", "unfold_unfoldbound.dat");
+    app.SetParameterValue("benchmark:use_log_scale", false);
+    app.SetParameterValue("benchmark:minthreads", "1");
+    app.SetParameterValue("benchmark:maxthreads", "16");
+
+    app.Add(new BSrc);
+    app.Add(new Unf);
+    app.Add(new PEProc);
+    app.Add(new JFactoryGeneratorT<BFac>);
+    app.Add(new JFactoryGeneratorT<PEFac>);
+
+    JBenchmarker benchmarker(&app);
+    benchmarker.RunUntilFinished();
+}
+
+TEST_CASE("UnfoldTopology_UnfoldBound_Parallel") {
+    LOG << "Running UnfoldTopology_UnfoldBound_Parallel";
+
+    JApplication app;
+    app.SetParameterValue("bsrc:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("bfac:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("unf:latency_us", 1'000'000 / 5'000); // 5 kHz, but now several blocks can be unfolded at once
+    app.SetParameterValue("pefac:latency_us", 1'000'000 / 20'000); // 20 kHz
+    app.SetParameterValue("peproc:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("benchmark:resultsdir", JANA_PERF_TESTS_RESULTS_DIR); // Not checked in, unlike docs/perf_tests
+    app.SetParameterValue("benchmark:rates_filename", "unfold_unfoldbound_parallel.dat");
+    app.SetParameterValue("benchmark:use_log_scale", false);
+    app.SetParameterValue("benchmark:minthreads", "1");
+    app.SetParameterValue("benchmark:maxthreads", "16");
+
+    app.Add(new BSrc);
+    app.Add(new ParUnf);
+    app.Add(new PEProc);
+    app.Add(new JFactoryGeneratorT<BFac>);
+    app.Add(new JFactoryGeneratorT<PEFac>);
+
+    JBenchmarker benchmarker(&app);
+    benchmarker.RunUntilFinished();
+}
+
+void RunParallelUnfold(std::string rates_filename, bool enable_event_fusion) {
+    JApplication app;
+    app.SetParameterValue("jana:enable_event_fusion", enable_event_fusion);
+    app.SetParameterValue("bsrc:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("bfac:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("unf:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("pefac:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("peproc:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("benchmark:resultsdir", JANA_PERF_TESTS_RESULTS_DIR); // Not checked in, unlike docs/perf_tests
+    app.SetParameterValue("benchmark:rates_filename", rates_filename);
+    app.SetParameterValue("benchmark:use_log_scale", true);
+    app.SetParameterValue("benchmark:minthreads", "1");
+    app.SetParameterValue("benchmark:maxthreads", "32");
+
+    app.Add(new BSrc);
+    app.Add(new ParUnf);
+    app.Add(new PEProc);
+    app.Add(new JFactoryGeneratorT<BFac>);
+    app.Add(new JFactoryGeneratorT<PEFac>);
+
+    JBenchmarker benchmarker(&app);
+    benchmarker.RunUntilFinished();
+}
+
+TEST_CASE("UnfoldTopology_Mini_Parallel") {
+    LOG << "Running UnfoldTopology_Mini_Parallel";
+    RunParallelUnfold("unfold_mini_parallel.dat", false);
+}
+
+TEST_CASE("UnfoldTopology_Mini_Parallel_EventFusion") {
+    LOG << "Running UnfoldTopology_Mini_Parallel_EventFusion";
+
+    // Same as UnfoldTopology_Mini_Parallel, but with event fusion. With a parallel unfolder, the Block map, the unfolder,
+    // and the PhysicsEvent map are all parallel, so a worker can follow each event from the source to the sequential
+    // tap without sending it through a queue in between.
+    RunParallelUnfold("unfold_mini_parallel_fusion.dat", true);
+}
+
+TEST_CASE("UnfoldTopology_SkewedFold") {
+    LOG << "Running UnfoldTopology_SkewedFold";
+
+    JApplication app;
+    app.SetParameterValue("bsrc:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("bfac:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("unf:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("pefac:latency_us", 1'000'000 / 20'000); // 20 kHz
+    app.SetParameterValue("pefac:straggler_latency_us", 1'000'000 / 500); // 500 Hz, for one child in ten
+    app.SetParameterValue("fld:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("peproc:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("benchmark:resultsdir", "docs/perf_tests");
+    app.SetParameterValue("benchmark:rates_filename", "unfold_skewedfold.dat");
+    app.SetParameterValue("benchmark:use_log_scale", false);
+    app.SetParameterValue("benchmark:minthreads", "1");
+    app.SetParameterValue("benchmark:maxthreads", "16");
+
+    app.Add(new BSrc);
+    app.Add(new Unf);
+    app.Add(new Fld(false));
+    app.Add(new PEProc);
+    app.Add(new JFactoryGeneratorT<BFac>);
+    app.Add(new JFactoryGeneratorT<PEFac>);
+
+    JBenchmarker benchmarker(&app);
+    benchmarker.RunUntilFinished();
 }
 
+TEST_CASE("UnfoldTopology_SkewedFold_Commutative") {
+    LOG << "Running UnfoldTopology_SkewedFold_Commutative";
+
+    JApplication app;
+    app.SetParameterValue("bsrc:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("bfac:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("unf:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("pefac:latency_us", 1'000'000 / 20'000); // 20 kHz
+    app.SetParameterValue("pefac:straggler_latency_us", 1'000'000 / 500); // 500 Hz, but the other children no longer wait for it
+    app.SetParameterValue("fld:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("peproc:latency_us", 0); // Infinity Hz
+    app.SetParameterValue("benchmark:resultsdir", "docs/perf_tests");
+    app.SetParameterValue("benchmark:rates_filename", "unfold_skewedfold_commutative.dat");
+    app.SetParameterValue("benchmark:use_log_scale", false);
+    app.SetParameterValue("benchmark:minthreads", "1");
+    app.SetParameterValue("benchmark:maxthreads", "16");
+
+    app.Add(new BSrc);
+    app.Add(new Unf);
+    app.Add(new Fld(true));
+    app.Add(new PEProc);
+    app.Add(new JFactoryGeneratorT<BFac>);
+    app.Add(new JFactoryGeneratorT<PEFac>);
+
+    JBenchmarker benchmarker(&app);
+    benchmarker.RunUntilFinished();
+}
 
 
+}
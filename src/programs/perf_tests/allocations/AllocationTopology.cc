@@ -0,0 +1,181 @@
+// Copyright 2022-2026, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <JANA/JApplication.h>
+#include <JANA/JFactoryGenerator.h>
+#include <JANA/Engine/JExecutionEngine.h>
+#include <JANA/JEventProcessor.h>
+#include <JANA/JEventSource.h>
+#include <JANA/Utils/JBenchUtils.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+
+// Count every heap allocation made by this binary, so that the benchmarks below can report allocations per event.
+// This lives in its own executable because the extra atomic on every allocation would skew jana-perf-tests.
+std::atomic_size_t g_allocation_count {0};
+
+void* operator new(std::size_t size) {
+    g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+
+namespace jana::perftest::allocations {
+
+struct Data { size_t x; };
+
+struct PESrc : public JEventSource {
+
+    Output<Data> data_out {this};
+    Parameter<int> latency_us {this, "latency_us", 0};
+
+    PESrc() {
+        SetPrefix("src");
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        data_out.SetShortName("1");
+    }
+    JEventSource::Result Emit(JEvent& event) override {
+        data_out().push_back(new Data {event.GetEventNumber()*3 });
+        JBenchUtils::consume_cpu_us(*latency_us);
+        return Result::Success;
+    };
+};
+
+struct PEFac : public JFactory {
+    Input<Data> data_in {this};
+    Output<Data> data_out {this};
+    Parameter<int> latency_us {this, "latency_us", 0};
+    Parameter<int> nobjects {this, "nobjects", 1};
+    Parameter<bool> use_pooling {this, "use_pooling", false};
+    Parameter<bool> use_arena {this, "use_arena", false};
+    PEFac() {
+        SetPrefix("fac");
+        SetLevel(JEventLevel::PhysicsEvent);
+        data_in.SetDatabundleName("1");
+        data_out.SetShortName("2");
+    }
+    void Init() override {
+        data_out.EnablePooling(*use_pooling);
+        data_out.EnableArena(*use_arena);
+    }
+    void Process(const JEvent&) override {
+        auto x = data_in().at(0)->x * 10;
+        for (int i=0; i<*nobjects; ++i) {
+            data_out.emplace_back(x);
+        }
+        JBenchUtils::consume_cpu_us(*latency_us);
+    };
+};
+
+struct PEProc : public JEventProcessor {
+    Input<Data> data_in {this};
+    Parameter<int> latency_us {this, "latency_us", 0};
+    PEProc() {
+        SetPrefix("proc");
+        SetLevel(JEventLevel::PhysicsEvent);
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        data_in.SetDatabundleName("2");
+    }
+    void ProcessSequential(const JEvent&) override {
+        (void) (data_in().at(0)->x);
+        JBenchUtils::consume_cpu_us(*latency_us);
+    };
+};
+
+
+void RunPooling(bool use_pooling, bool use_arena=false) {
+    JApplication app;
+    app.SetParameterValue("nthreads", 2);
+    app.SetParameterValue("jana:nevents", 50000);
+    app.SetParameterValue("jana:max_inflight_events", 16);
+    app.SetParameterValue("jana:loglevel", "warn");
+    app.SetParameterValue("src:latency_us", 0);
+    app.SetParameterValue("fac:latency_us", 0);
+    app.SetParameterValue("fac:nobjects", 100);
+    app.SetParameterValue("fac:use_pooling", use_pooling);
+    app.SetParameterValue("fac:use_arena", use_arena);
+    app.SetParameterValue("proc:latency_us", 0);
+
+    app.Add(new PESrc);
+    app.Add(new PEProc);
+    app.Add(new JFactoryGeneratorT<PEFac>);
+    app.Initialize();
+
+    size_t allocations_before = g_allocation_count;
+    app.Run();
+    size_t allocations = g_allocation_count - allocations_before;
+
+    auto perf = app.GetService<JExecutionEngine>()->GetPerf();
+    LOG << "BasicTopology_Mini_Pooling: fac:use_pooling=" << use_pooling << ", fac:use_arena=" << use_arena << "\n"
+        << "  Throughput [Hz]:          " << perf.throughput_hz << "\n"
+        << "  Heap allocations [count]: " << allocations << "\n"
+        << "  Allocations per event:    " << static_cast<double>(allocations) / perf.event_count;
+}
+
+TEST_CASE("BasicTopology_Mini_Pooling") {
+
+    LOG << "Running BasicTopology_Mini_Pooling";
+
+    // Each event's factory creates 100 small objects. Without pooling they all get deleted when the event is
+    // recycled and allocated again for the next one. With pooling they get reset and reused instead.
+    // With the arena they get bump-allocated from the event's JArena, which is freed in one step.
+    RunPooling(false);
+    RunPooling(true);
+    RunPooling(false, true);
+}
+
+void RunCallGraph(bool record_call_stack, bool summary, size_t sampling=1) {
+    JApplication app;
+    app.SetParameterValue("nthreads", 2);
+    app.SetParameterValue("jana:nevents", 100000);
+    app.SetParameterValue("jana:max_inflight_events", 16);
+    app.SetParameterValue("jana:loglevel", "warn");
+    app.SetParameterValue("record_call_stack", record_call_stack);
+    app.SetParameterValue("jana:call_graph_summary", summary);
+    app.SetParameterValue("jana:call_graph_sampling", sampling);
+    app.SetParameterValue("src:latency_us", 0);
+    app.SetParameterValue("fac:latency_us", 0);
+    app.SetParameterValue("proc:latency_us", 0);
+
+    app.Add(new PESrc);
+    app.Add(new PEProc);
+    app.Add(new JFactoryGeneratorT<PEFac>);
+    app.Initialize();
+
+    size_t allocations_before = g_allocation_count;
+    app.Run();
+    size_t allocations = g_allocation_count - allocations_before;
+
+    auto perf = app.GetService<JExecutionEngine>()->GetPerf();
+    LOG << "BasicTopology_Mini_CallGraph: record_call_stack=" << record_call_stack
+        << ", jana:call_graph_summary=" << summary << ", jana:call_graph_sampling=" << sampling << "\n"
+        << "  Throughput [Hz]:          " << perf.throughput_hz << "\n"
+        << "  Allocations per event:    " << static_cast<double>(allocations) / perf.event_count;
+}
+
+TEST_CASE("BasicTopology_Mini_CallGraph") {
+
+    LOG << "Running BasicTopology_Mini_CallGraph";
+
+    // The factories do no work, so this isolates the cost of recording the call graph itself. The full recorder
+    // allocates named nodes for every call, while summary mode only pushes integer ids into a preallocated buffer.
+    RunCallGraph(false, false);
+    RunCallGraph(true, false);
+    RunCallGraph(false, true);
+    RunCallGraph(false, true, 16);
+}
+
+} // namespace
+
@@ -8,6 +8,9 @@
 #include "JANA/Utils/JBenchUtils.h"
 #include "catch.hpp"
 
+#include <atomic>
+#include <thread>
+
 size_t global_resource = 0;
 
 
@@ -82,17 +85,53 @@ struct BarrierProcessor : public JEventProcessor {
         if (event.GetSequential()) {
             LOG_INFO(GetLogger()) << "Processing barrier event = " << event.GetEventNumber() << ", writing global var = " << global_resource+1 << LOG_END;
             REQUIRE(global_resource == ((event.GetEventNumber() - 1) / 10));
+            REQUIRE(event.GetEpoch() == global_resource + 1);
             global_resource += 1;
         }
         else {
             LOG_INFO(GetLogger()) << "Processing non-barrier event = " << event.GetEventNumber() << ", reading global var = " << global_resource << LOG_END;
             REQUIRE(global_resource == (event.GetEventNumber() / 10));
+            REQUIRE(event.GetEpoch() == global_resource);
         }
         bench.consume_cpu_ms(100, 0);
     }
 };
 
 
+std::atomic_uint64_t g_latest_event_started {0};
+std::atomic_bool g_barrier_overlapped {false};
+
+struct PipelinedBarrierProcessor : public JEventProcessor {
+
+    PipelinedBarrierProcessor() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+    }
+    void ProcessParallel(const JEvent& event) override {
+        auto event_nr = event.GetEventNumber();
+        auto latest = g_latest_event_started.load();
+        while (event_nr > latest && !g_latest_event_started.compare_exchange_weak(latest, event_nr)) {}
+        // Barrier events are slow, e.g. because they reload calibrations, which is when pipelining pays off
+        std::this_thread::sleep_for(std::chrono::milliseconds(event.GetSequential() ? 200 : 20));
+    }
+
+    void ProcessSequential(const JEvent& event) override {
+
+        if (event.GetSequential()) {
+            REQUIRE(global_resource == event.GetEpoch() - 1);
+            global_resource += 1;
+            // Did any event from after this barrier get started before we got here?
+            if (g_latest_event_started > event.GetEventNumber()) {
+                g_barrier_overlapped = true;
+            }
+        }
+        else {
+            REQUIRE(global_resource == event.GetEpoch());
+            REQUIRE(global_resource == (event.GetEventNumber() / 10));
+        }
+    }
+};
+
+
 TEST_CASE("BarrierEventTests_SingleThread") {
     global_resource = 0;
     JApplication app;
@@ -145,3 +184,41 @@ TEST_CASE("BarrierEventTests_Legacy") {
 };
 
 
+TEST_CASE("BarrierEventTests_Pipelined") {
+    global_resource = 0;
+    g_latest_event_started = 0;
+    g_barrier_overlapped = false;
+    JApplication app;
+    app.Add(new PipelinedBarrierProcessor);
+    app.Add(new BarrierSource);
+    app.SetParameterValue("nthreads", 4);
+    app.SetParameterValue("jana:nevents", 40);
+    app.SetParameterValue("jana:loglevel", "warn");
+
+    SECTION("Draining") {
+        app.Run(true);
+        REQUIRE(global_resource == 4);
+        REQUIRE(g_barrier_overlapped == false);
+    }
+
+    SECTION("Pipelined") {
+        app.SetParameterValue("jana:pipeline_barriers", true);
+        app.Run(true);
+        REQUIRE(global_resource == 4);
+        REQUIRE(g_barrier_overlapped == true);
+    }
+}
+
+
+TEST_CASE("BarrierEventTests_Pipelined_LegacyFallback") {
+    global_resource = 0;
+    JApplication app;
+    app.Add(new LegacyBarrierProcessor);
+    app.Add(new BarrierSource);
+    app.SetParameterValue("nthreads", 4);
+    app.SetParameterValue("jana:nevents", 40);
+    app.SetParameterValue("jana:pipeline_barriers", true);
+    app.SetParameterValue("jana:loglevel", "error");
+    app.Run(true);
+    REQUIRE(global_resource == 4);
+};
@@ -0,0 +1,379 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#include <catch.hpp>
+#include <JANA/JApplication.h>
+#include <JANA/JEventSource.h>
+#include <JANA/JEventProcessor.h>
+#include <JANA/JFactory.h>
+#include <JANA/JFactoryGenerator.h>
+#include <JANA/Topology/JMapArrow.h>
+#include <JANA/Topology/JTopologyBuilder.h>
+#include <JANA/Services/JComponentManager.h>
+
+#include <atomic>
+#include <thread>
+
+namespace jana::factoryparallelismtests {
+
+struct Hit { double energy; };
+struct Cluster { double energy; };
+struct Track { double energy; };
+struct Particle { double energy; };
+
+// Tracks how many factories are inside Process() at once
+std::atomic_int g_active_count {0};
+std::atomic_int g_max_active_count {0};
+std::atomic_int g_process_count {0};
+
+struct Tracker {
+    Tracker() {
+        g_process_count += 1;
+        int active = (g_active_count += 1);
+        int max_active = g_max_active_count;
+        while (active > max_active && !g_max_active_count.compare_exchange_weak(max_active, active)) {}
+        // Sleep rather than spin, so that overlap is visible even with a single core
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    ~Tracker() {
+        g_active_count -= 1;
+    }
+};
+
+struct HitSource : public JEventSource {
+    HitSource() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+    }
+    Result Emit(JEvent& event) override {
+        event.Insert(new Hit {1.0}, "hits");
+        return Result::Success;
+    }
+};
+
+struct ClusterFac : public JFactory {
+    Input<Hit> m_hits_in {this};
+    Output<Cluster> m_clusters_out {this, "clusters"};
+
+    ClusterFac() {
+        m_hits_in.SetTag("hits");
+    }
+    void Process(const JEvent&) override {
+        Tracker tracker;
+        m_clusters_out().push_back(new Cluster {m_hits_in->at(0)->energy * 2});
+    }
+};
+
+struct TrackFac : public JFactory {
+    Input<Hit> m_hits_in {this};
+    Output<Track> m_tracks_out {this, "tracks"};
+
+    TrackFac() {
+        m_hits_in.SetTag("hits");
+    }
+    void Process(const JEvent& event) override {
+        Tracker tracker;
+        if (event.GetEventNumber() == 3 && GetApplication()->GetParameterValue<bool>("test:throw")) {
+            throw JException("Track fitting failed");
+        }
+        m_tracks_out().push_back(new Track {m_hits_in->at(0)->energy * 3});
+    }
+};
+
+struct ParticleFac : public JFactory {
+    Input<Cluster> m_clusters_in {this};
+    Input<Track> m_tracks_in {this};
+    Output<Particle> m_particles_out {this, "particles"};
+
+    ParticleFac() {
+        m_clusters_in.SetTag("clusters");
+        m_tracks_in.SetTag("tracks");
+    }
+    void Process(const JEvent&) override {
+        m_particles_out().push_back(new Particle {m_clusters_in->at(0)->energy + m_tracks_in->at(0)->energy});
+    }
+};
+
+struct ParticleProc : public JEventProcessor {
+    Input<Particle> m_particles_in {this};
+    int m_event_count = 0;
+
+    ParticleProc() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        m_particles_in.SetTag("particles");
+    }
+    void ProcessSequential(const JEvent&) override {
+        REQUIRE(m_particles_in->size() == 1);
+        REQUIRE(m_particles_in->at(0)->energy == 5.0);
+        m_event_count += 1;
+    }
+};
+
+void Configure(JApplication& app, ParticleProc* proc, bool enable_parallelism) {
+    g_active_count = 0;
+    g_max_active_count = 0;
+    g_process_count = 0;
+    app.Add(new HitSource);
+    app.Add(new JFactoryGeneratorT<ClusterFac>);
+    app.Add(new JFactoryGeneratorT<TrackFac>);
+    app.Add(new JFactoryGeneratorT<ParticleFac>);
+    app.Add(proc);
+    app.SetParameterValue("nthreads", 4);
+    app.SetParameterValue("jana:nevents", 10);
+    app.SetParameterValue("jana:max_inflight_events", 1);
+    app.SetParameterValue("jana:enable_factory_parallelism", enable_parallelism);
+    app.SetParameterValue("test:throw", false);
+    app.SetParameterValue("jana:loglevel", "error");
+}
+
+TEST_CASE("FactoryParallelism_IndependentBranchesOverlap") {
+
+    JApplication app;
+    auto proc = new ParticleProc;
+
+    SECTION("Disabled") {
+        Configure(app, proc, false);
+        app.Run();
+        REQUIRE(proc->m_event_count == 10);
+        REQUIRE(g_process_count == 20);
+        REQUIRE(g_max_active_count == 1);
+    }
+
+    SECTION("Enabled") {
+        Configure(app, proc, true);
+        app.Run();
+        REQUIRE(proc->m_event_count == 10);
+        REQUIRE(g_process_count == 20); // Each factory still runs exactly once per event
+        REQUIRE(g_max_active_count == 2); // Clusters and tracks overlap, even though only one event is in flight
+    }
+}
+
+TEST_CASE("FactoryParallelism_ExceptionPropagates") {
+    JApplication app;
+    Configure(app, new ParticleProc, true);
+    app.SetParameterValue("test:throw", true);
+    REQUIRE_THROWS_WITH(app.Run(), Catch::Contains("Track fitting failed"));
+}
+
+
+struct ClusterProc : public JEventProcessor {
+    Input<Cluster> m_clusters_in {this};
+    ClusterProc() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        m_clusters_in.SetTag("clusters");
+    }
+    void ProcessSequential(const JEvent&) override {
+        REQUIRE(m_clusters_in->size() == 1);
+    }
+};
+
+struct TrackProc : public JEventProcessor {
+    Input<Track> m_tracks_in {this};
+    TrackProc() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        m_tracks_in.SetTag("tracks");
+    }
+    void ProcessSequential(const JEvent&) override {
+        REQUIRE(m_tracks_in->size() == 1);
+    }
+};
+
+std::atomic_int g_dead_count {0};
+
+struct DeadFac : public JFactory {
+    Input<Hit> m_hits_in {this};
+    Output<Cluster> m_clusters_out {this, "dead_clusters"};
+    DeadFac() {
+        m_hits_in.SetTag("hits");
+    }
+    void Process(const JEvent&) override {
+        g_dead_count += 1;
+    }
+};
+
+TEST_CASE("FactoryParallelism_EagerPrefetch") {
+
+    g_active_count = 0;
+    g_max_active_count = 0;
+    g_process_count = 0;
+    g_dead_count = 0;
+
+    JApplication app;
+    app.Add(new HitSource);
+    app.Add(new JFactoryGeneratorT<ClusterFac>);
+    app.Add(new JFactoryGeneratorT<TrackFac>);
+    app.Add(new JFactoryGeneratorT<DeadFac>);
+    app.Add(new ClusterProc);
+    app.Add(new TrackProc);
+    app.SetParameterValue("nthreads", 4);
+    app.SetParameterValue("jana:nevents", 10);
+    app.SetParameterValue("jana:max_inflight_events", 1);
+    app.SetParameterValue("jana:enable_factory_parallelism", true);
+    app.SetParameterValue("test:throw", false);
+    app.SetParameterValue("jana:loglevel", "error");
+
+    SECTION("Disabled") {
+        // Each processor triggers its own input, one processor after the other
+        app.Run();
+        REQUIRE(g_process_count == 20);
+        REQUIRE(g_max_active_count == 1);
+    }
+
+    SECTION("Enabled") {
+        app.SetParameterValue("jana:enable_eager_prefetch", true);
+        app.Initialize();
+
+        JMapArrow* map_arrow = nullptr;
+        for (auto* arrow : app.GetService<JTopologyBuilder>()->GetArrows()) {
+            if (dynamic_cast<JMapArrow*>(arrow) != nullptr) {
+                map_arrow = dynamic_cast<JMapArrow*>(arrow);
+            }
+        }
+        REQUIRE(map_arrow != nullptr);
+
+        app.Run();
+        REQUIRE(g_process_count == 20);
+        REQUIRE(g_dead_count == 0); // Nothing consumes dead_clusters
+        REQUIRE(g_max_active_count == 2); // Both processors' inputs get created in the same wave
+
+        // JEvent::Insert() gives the hits a factory of their own, which the other two depend on
+        auto& plan = map_arrow->GetPrefetchPlan();
+        REQUIRE(plan.size() == 2);
+        REQUIRE(plan[0].size() == 1);
+        REQUIRE(plan[1].size() == 2);
+    }
+}
+
+TEST_CASE("FactoryParallelism_Reachability") {
+    JApplication app;
+    app.Add(new JFactoryGeneratorT<ClusterFac>);
+    app.Add(new JFactoryGeneratorT<TrackFac>);
+    app.Add(new JFactoryGeneratorT<ParticleFac>);
+    app.Add(new JFactoryGeneratorT<DeadFac>);
+    app.Add(new ParticleProc);
+    app.Initialize();
+    auto report = app.GetService<JTopologyBuilder>()->PrintFactoryReachability();
+    REQUIRE(report.find("3 of 4 factories are reachable") != std::string::npos);
+    REQUIRE(report.find("Unreachable") != std::string::npos);
+}
+
+
+struct CycleFacA : public JFactory {
+    Input<Track> m_tracks_in {this};
+    Output<Cluster> m_clusters_out {this, "clusters"};
+    CycleFacA() {
+        m_tracks_in.SetTag("tracks");
+    }
+};
+
+struct CycleFacB : public JFactory {
+    Input<Cluster> m_clusters_in {this};
+    Output<Track> m_tracks_out {this, "tracks"};
+    CycleFacB() {
+        m_clusters_in.SetTag("clusters");
+    }
+};
+
+TEST_CASE("FactoryParallelism_CycleDetection") {
+    JApplication app;
+    app.Add(new JFactoryGeneratorT<CycleFacA>);
+    app.Add(new JFactoryGeneratorT<CycleFacB>);
+    app.SetParameterValue("jana:enable_factory_parallelism", true);
+    REQUIRE_THROWS_WITH([&](){
+        app.Initialize();
+        auto event = std::make_shared<JEvent>(&app);
+    }(), Catch::Contains("Encountered a cycle in the factory dependency graph"));
+}
+
+struct ChunkedTrackFac : public JFactory {
+    Input<Hit> m_hits_in {this};
+    Output<Track> m_tracks_out {this, "chunked_tracks"};
+
+    ChunkedTrackFac() {
+        m_hits_in.SetTag("hits");
+    }
+    void Process(const JEvent& event) override {
+        // Fit 100 tracks in chunks of 25. Each chunk writes only to its own slots
+        std::vector<double> energies(100);
+        ParallelFor(0, energies.size(), 25, [&](size_t begin, size_t end) {
+            Tracker tracker;
+            for (size_t i=begin; i<end; ++i) {
+                if (i == 60 && event.GetEventNumber() == 3 && GetApplication()->GetParameterValue<bool>("test:throw")) {
+                    throw JException("Track fitting failed");
+                }
+                energies[i] = m_hits_in->at(0)->energy * i;
+            }
+        });
+        double total = 0;
+        for (double energy : energies) total += energy;
+        m_tracks_out().push_back(new Track {total});
+    }
+};
+
+struct ChunkedTrackProc : public JEventProcessor {
+    Input<Track> m_tracks_in {this};
+    int m_event_count = 0;
+
+    ChunkedTrackProc() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        m_tracks_in.SetTag("chunked_tracks");
+    }
+    void ProcessSequential(const JEvent&) override {
+        REQUIRE(m_tracks_in->size() == 1);
+        REQUIRE(m_tracks_in->at(0)->energy == 4950.0);
+        m_event_count += 1;
+    }
+};
+
+TEST_CASE("FactoryParallelism_ParallelFor") {
+    g_active_count = 0;
+    g_max_active_count = 0;
+    g_process_count = 0;
+
+    JApplication app;
+    auto proc = new ChunkedTrackProc;
+    app.Add(new HitSource);
+    app.Add(new JFactoryGeneratorT<ChunkedTrackFac>);
+    app.Add(proc);
+    app.SetParameterValue("nthreads", 4);
+    app.SetParameterValue("jana:nevents", 5);
+    app.SetParameterValue("jana:max_inflight_events", 1);
+    app.SetParameterValue("jana:latency_histograms", true);
+    app.SetParameterValue("test:throw", false);
+    app.SetParameterValue("jana:loglevel", "error");
+
+    SECTION("Chunks overlap") {
+        app.Run();
+        REQUIRE(proc->m_event_count == 5);
+        REQUIRE(g_process_count == 20); // Four chunks per event
+        REQUIRE(g_max_active_count > 1); // Even though only one event is in flight
+
+        bool chunks_found = false;
+        for (auto& summary : app.GetService<JComponentManager>()->GetLatencySummaries()) {
+            if (summary.kind == "ParallelFor") {
+                chunks_found = true;
+                REQUIRE(summary.snapshot.count == 20);
+            }
+        }
+        REQUIRE(chunks_found);
+    }
+
+    SECTION("Exception propagates") {
+        app.SetParameterValue("test:throw", true);
+        REQUIRE_THROWS_WITH(app.Run(), Catch::Contains("Track fitting failed"));
+    }
+}
+
+TEST_CASE("FactoryParallelism_ParallelForWithoutEngine") {
+    // Without a JApplication, the chunks just run one after another
+    ChunkedTrackFac fac;
+    std::vector<std::pair<size_t, size_t>> chunks;
+    fac.ParallelFor(3, 10, 3, [&](size_t begin, size_t end) { chunks.push_back({begin, end}); });
+    REQUIRE(chunks == std::vector<std::pair<size_t, size_t>>{{3, 6}, {6, 9}, {9, 10}});
+
+    chunks.clear();
+    fac.ParallelFor(5, 5, 3, [&](size_t begin, size_t end) { chunks.push_back({begin, end}); });
+    REQUIRE(chunks.empty());
+    REQUIRE_THROWS(fac.ParallelFor(0, 10, 0, [](size_t, size_t) {}));
+}
+
+} // namespace jana::factoryparallelismtests
@@ -5,6 +5,9 @@
 #include <JANA/JFactoryT.h>
 #include <JANA/JFactoryGenerator.h>
 #include <JANA/JEvent.h>
+#include <JANA/JEventProcessor.h>
+#include <JANA/JEventSource.h>
+#include <thread>
 
 #if JANA2_HAVE_PODIO
 #include <PodioDatamodel/ExampleHitCollection.h>
@@ -54,6 +57,29 @@ TEST_CASE("JDatabundle_JFactoryT") {
     }
 }
 
+TEST_CASE("JDatabundle_InsertIntoFactoryDatabundle") {
+    // This is what JEvent::InsertCollection() does with the podio::Frame databundle on every event after the first
+    JApplication app;
+    auto event = std::make_shared<JEvent>(&app);
+    event->Insert(new Hit{0.0}, "inserted");
+    auto* databundle = event->GetLightweightDatabundle<Hit>("inserted", true, false);
+    auto* factory = databundle->GetFactory();
+    REQUIRE(factory != nullptr);
+
+    for (int i=0; i<3; ++i) {
+        event->Clear();
+        REQUIRE(factory->GetStatus() == JFactory::Status::Empty);
+        REQUIRE(databundle->GetSize() == 0);
+
+        databundle->GetData().push_back(new Hit{double(i)});
+        databundle->SetStatus(JDatabundle::Status::Inserted);
+        REQUIRE(factory->GetStatus() == JFactory::Status::Inserted);
+        REQUIRE(event->GetFactorySet()->GetDirtyFactoryCount() == 1);
+    }
+    event->Clear();
+    REQUIRE(databundle->GetSize() == 0);
+}
+
 #if JANA2_HAVE_PODIO
 
 class MyFac : public JFactory {
@@ -139,6 +165,59 @@ TEST_CASE("JDatabundle_InsertCollection") {
 
 #endif
 
+TEST_CASE("JDatabundle_DirtyListClear") {
+
+    JFactorySet facset;
+    std::vector<JFactoryT<Hit>*> facs;
+    for (int i=0; i<1000; ++i) {
+        auto fac = new JFactoryT<Hit>;
+        fac->SetTag("hits_" + std::to_string(i));
+        facset.Add(fac);
+        facs.push_back(fac);
+    }
+    auto bundle = new JLightweightDatabundleT<Hit>;
+    bundle->SetShortName("loose_hits");
+    facset.Add(bundle);
+    REQUIRE(facset.GetDirtyFactoryCount() == 0);
+    REQUIRE(facset.GetDirtyDatabundleCount() == 0);
+
+    // Only touch a few of the factories
+    facs[3]->Insert(new Hit{1.0});
+    facs[700]->Insert(new Hit{2.0});
+    facs[700]->Insert(new Hit{3.0});
+    bundle->GetData().push_back(new Hit{4.0});
+    bundle->SetStatus(JDatabundle::Status::Inserted);
+    facs[999]->SetPersistentFlag(true);
+    facs[999]->Insert(new Hit{5.0});
+    REQUIRE(facset.GetDirtyFactoryCount() == 3);
+    REQUIRE(facset.GetDirtyDatabundleCount() == 1);
+
+    facset.Clear();
+    REQUIRE(facs[3]->GetStatus() == JFactory::Status::Empty);
+    REQUIRE(facs[3]->GetNumObjects() == 0);
+    REQUIRE(facs[700]->GetStatus() == JFactory::Status::Empty);
+    REQUIRE(facs[700]->GetNumObjects() == 0);
+    REQUIRE(bundle->GetStatus() == JDatabundle::Status::Empty);
+    REQUIRE(bundle->GetSize() == 0);
+
+    // The persistent factory keeps its data, and stays on the dirty list
+    REQUIRE(facs[999]->GetStatus() == JFactory::Status::Inserted);
+    REQUIRE(facs[999]->GetNumObjects() == 1);
+    REQUIRE(facset.GetDirtyFactoryCount() == 1);
+    REQUIRE(facset.GetDirtyDatabundleCount() == 0);
+
+    facs[999]->SetPersistentFlag(false);
+    facset.Clear();
+    REQUIRE(facs[999]->GetStatus() == JFactory::Status::Empty);
+    REQUIRE(facset.GetDirtyFactoryCount() == 0);
+
+    // Factories get marked again on the next event
+    facs[3]->Insert(new Hit{6.0});
+    REQUIRE(facset.GetDirtyFactoryCount() == 1);
+    facset.Clear();
+    REQUIRE(facs[3]->GetNumObjects() == 0);
+}
+
 } // namespace jana::databundletests::jfactoryt
 
 struct InterestingHit {};
@@ -179,3 +258,399 @@ TEST_CASE("JDatabundle_SetUniqueName"){
 }
 
 
+
+
+namespace jana::databundletests::pooling {
+
+struct Hit {
+    double E;
+    std::vector<int> cells {}; // Acquire(E) aggregate-initializes Hit, so give the trailing member a default
+};
+
+struct Track : public JObject {
+    double p = 0;
+    Track() = default;
+    Track(double p) : p(p) {}
+};
+struct SpecialTrack : public Track {
+    using Track::Track;
+};
+
+TEST_CASE("JDatabundle_PoolingBasics") {
+
+    JLightweightDatabundleT<Track> sut;
+    sut.SetPoolingFlag(true);
+
+    auto* t1 = sut.Acquire(1.0);
+    auto* t2 = new SpecialTrack(2.0);
+    sut.GetData().push_back(t1);
+    sut.GetData().push_back(t2);
+    REQUIRE(sut.GetPoolAllocationCount() == 1);
+
+    sut.ClearData();
+    REQUIRE(sut.GetSize() == 0);
+    REQUIRE(sut.GetFreeListSize() == 1); // Subclasses get deleted rather than recycled
+
+    auto* t3 = sut.Acquire(3.0);
+    REQUIRE(t3 == t1);
+    REQUIRE(t3->p == 3.0);
+    REQUIRE(sut.GetPoolReuseCount() == 1);
+    sut.GetData().push_back(t3);
+
+    // Objects we don't own never enter the free list
+    sut.SetNotOwnerFlag(true);
+    sut.ClearData();
+    REQUIRE(sut.GetFreeListSize() == 0);
+    delete t3;
+}
+
+int g_process_count = 0;
+
+struct EmptySource : public JEventSource {
+    EmptySource() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+    }
+    Result Emit(JEvent&) override {
+        return Result::Success;
+    }
+};
+
+struct PooledHitFac : public JFactory {
+    Output<Hit> m_hits_out {this, "hits"};
+    Parameter<bool> m_use_pooling {this, "use_pooling", true};
+
+    static JLightweightDatabundleT<Hit>* s_databundle;
+
+    PooledHitFac() {
+        SetPrefix("hitfac");
+    }
+    void Init() override {
+        m_hits_out.EnablePooling(*m_use_pooling);
+        s_databundle = &m_hits_out.GetDatabundle();
+    }
+    void Process(const JEvent& event) override {
+        g_process_count += 1;
+        for (size_t i=0; i<5; ++i) {
+            auto* hit = m_hits_out.emplace_back(double(event.GetEventNumber()));
+            REQUIRE(hit->cells.empty()); // Recycled objects must be reset
+            hit->cells.push_back(i);
+        }
+    }
+};
+JLightweightDatabundleT<Hit>* PooledHitFac::s_databundle = nullptr;
+
+struct HitProc : public JEventProcessor {
+    Input<Hit> m_hits_in {this};
+    HitProc() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        m_hits_in.SetTag("hits");
+    }
+    void ProcessSequential(const JEvent& event) override {
+        REQUIRE(m_hits_in->size() == 5);
+        REQUIRE(m_hits_in->at(4)->E == double(event.GetEventNumber()));
+        REQUIRE(m_hits_in->at(4)->cells.size() == 1);
+    }
+};
+
+TEST_CASE("JDatabundle_PoolingFactory") {
+    g_process_count = 0;
+    JApplication app;
+    app.Add(new EmptySource);
+    app.Add(new JFactoryGeneratorT<PooledHitFac>);
+    app.Add(new HitProc);
+    app.SetParameterValue("jana:nevents", 10);
+    app.SetParameterValue("jana:max_inflight_events", 1);
+    app.SetParameterValue("nthreads", 1);
+    app.SetParameterValue("jana:loglevel", "error");
+
+    SECTION("Enabled") {
+        app.Run();
+        REQUIRE(g_process_count == 10);
+        REQUIRE(PooledHitFac::s_databundle->GetPoolAllocationCount() == 5); // Only the first event allocates
+        REQUIRE(PooledHitFac::s_databundle->GetPoolReuseCount() == 45);
+    }
+    SECTION("Disabled") {
+        app.SetParameterValue("hitfac:use_pooling", false);
+        app.Run();
+        REQUIRE(g_process_count == 10);
+        REQUIRE(PooledHitFac::s_databundle->GetPoolAllocationCount() == 50);
+        REQUIRE(PooledHitFac::s_databundle->GetPoolReuseCount() == 0);
+    }
+}
+
+struct Counted {
+    static inline int s_live_count = 0;
+    double x;
+    Counted(double x) : x(x) { s_live_count += 1; }
+    ~Counted() { s_live_count -= 1; }
+};
+
+struct Point { double x, y; };
+
+struct ArenaFac : public JFactory {
+    Output<Counted> m_counted_out {this, "counted"};
+    Output<Point> m_points_out {this, "points"};
+
+    static JFactorySet* s_facset;
+
+    ArenaFac() {
+        SetPrefix("arenafac");
+        m_counted_out.EnableArena();
+        m_points_out.EnableArena();
+    }
+    void Process(const JEvent& event) override {
+        s_facset = event.GetFactorySet();
+        for (size_t i=0; i<5; ++i) {
+            auto* counted = m_counted_out.emplace_back(double(i));
+            auto* point = m_points_out.emplace_back(double(i), 2.0*i);
+            REQUIRE(s_facset->GetArena().Contains(counted));
+            REQUIRE(s_facset->GetArena().Contains(point));
+        }
+        m_counted_out().push_back(new Counted(99)); // Heap objects may be mixed in
+        REQUIRE(Counted::s_live_count == 6);
+    }
+};
+JFactorySet* ArenaFac::s_facset = nullptr;
+
+struct ArenaProc : public JEventProcessor {
+    Input<Counted> m_counted_in {this};
+    Input<Point> m_points_in {this};
+    ArenaProc() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        m_counted_in.SetTag("counted");
+        m_points_in.SetTag("points");
+    }
+    void ProcessSequential(const JEvent&) override {
+        REQUIRE(m_counted_in->size() == 6);
+        REQUIRE(m_counted_in->at(5)->x == 99);
+        REQUIRE(m_points_in->at(4)->y == 8.0);
+    }
+};
+
+TEST_CASE("JDatabundle_ArenaFactory") {
+    Counted::s_live_count = 0;
+    JApplication app;
+    app.Add(new EmptySource);
+    app.Add(new JFactoryGeneratorT<ArenaFac>);
+    app.Add(new ArenaProc);
+    app.SetParameterValue("jana:nevents", 10);
+    app.SetParameterValue("jana:max_inflight_events", 1);
+    app.SetParameterValue("nthreads", 1);
+    app.SetParameterValue("jana:event_arena_block_size", 128); // Small enough that the first event has to regrow
+    app.Run();
+
+    // Every event got cleared, so destructors ran for the arena objects and the heap object alike
+    REQUIRE(Counted::s_live_count == 0);
+    auto& arena = ArenaFac::s_facset->GetArena();
+    REQUIRE(arena.GetBytesInUse() == 0);
+    REQUIRE(arena.GetHighWaterMark() >= 5*sizeof(Counted) + 5*sizeof(Point));
+    REQUIRE(arena.GetBlockCount() == 1);
+}
+
+TEST_CASE("JDatabundle_ArenaNotOwner") {
+    Counted::s_live_count = 0;
+    JArena arena;
+
+    JLightweightDatabundleT<Counted> owner;
+    owner.SetArena(&arena);
+    owner.SetArenaFlag(true);
+
+    JLightweightDatabundleT<Counted> borrower;
+    borrower.SetArena(&arena);
+    borrower.SetArenaFlag(true);
+    borrower.SetNotOwnerFlag(true);
+
+    for (size_t i=0; i<3; ++i) {
+        auto* counted = owner.Acquire(double(i));
+        owner.GetData().push_back(counted);
+        borrower.GetData().push_back(counted);
+    }
+    // The borrower may also construct objects on the owner's behalf
+    auto* counted = borrower.Acquire(3.0);
+    owner.GetData().push_back(counted);
+    borrower.GetData().push_back(counted);
+    REQUIRE(Counted::s_live_count == 4);
+
+    owner.ClearData();
+    REQUIRE(Counted::s_live_count == 0);
+    borrower.ClearData(); // Must not run the destructors a second time
+    REQUIRE(Counted::s_live_count == 0);
+    REQUIRE(borrower.GetArenaObjectCount() == 0);
+}
+
+TEST_CASE("JDatabundle_PoolingOverridesArena") {
+    Counted::s_live_count = 0;
+    JArena arena;
+
+    JLightweightDatabundleT<Counted> sut;
+    sut.SetArena(&arena);
+    sut.SetArenaFlag(true);
+    sut.SetPoolingFlag(true);
+
+    for (size_t i=0; i<3; ++i) {
+        auto* counted = sut.Acquire(double(i));
+        REQUIRE(!arena.Contains(counted));
+        sut.GetData().push_back(counted);
+    }
+    REQUIRE(sut.GetArenaObjectCount() == 0);
+    REQUIRE(sut.GetPoolAllocationCount() == 3);
+
+    sut.ClearData();
+    REQUIRE(sut.GetFreeListSize() == 3);
+    REQUIRE(Counted::s_live_count == 3); // Recycled rather than destroyed
+
+    for (size_t i=0; i<3; ++i) {
+        sut.GetData().push_back(sut.Acquire(double(i)));
+    }
+    REQUIRE(sut.GetPoolReuseCount() == 3);
+    REQUIRE(sut.GetPoolAllocationCount() == 3);
+    REQUIRE(arena.GetBytesInUse() == 0);
+}
+
+} // namespace jana::databundletests::pooling
+
+namespace jana::databundletests::columnar {
+
+struct Hit : public JObject {
+    int cell = 0;
+    double E = 0;
+    double t = 0;
+    double unstored = 0; // Doesn't get a column
+};
+
+TEST_CASE("JDatabundle_ColumnarBasics") {
+
+    JColumnarDatabundleT<Hit> sut;
+    sut.AddColumn(&Hit::cell, "cell");
+    sut.AddColumn(&Hit::E, "E");
+    sut.AddColumn(&Hit::t, "t");
+    REQUIRE(sut.GetColumnCount() == 3);
+    REQUIRE(sut.HasColumn(&Hit::E));
+    REQUIRE(!sut.HasColumn(&Hit::unstored));
+    REQUIRE_THROWS(sut.AddColumn(&Hit::E));
+
+    for (int i=0; i<100; ++i) {
+        Hit hit;
+        hit.cell = i;
+        hit.E = 2.0*i;
+        hit.t = 3.0*i;
+        hit.unstored = 22;
+        sut.PushBack(hit);
+    }
+    REQUIRE(sut.GetSize() == 100);
+
+    auto energies = sut.GetColumn(&Hit::E);
+    REQUIRE(energies.size() == 100);
+    REQUIRE(energies[99] == 198.0);
+    REQUIRE(reinterpret_cast<uintptr_t>(energies.data()) % JColumnarDatabundleT<Hit>::kColumnAlignment == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(sut.GetColumn(&Hit::cell).data()) % JColumnarDatabundleT<Hit>::kColumnAlignment == 0);
+    REQUIRE_THROWS(sut.GetColumn(&Hit::unstored));
+    REQUIRE_THROWS(energies.at(100));
+
+    auto row = sut.GetRow(7);
+    REQUIRE(row.cell == 7);
+    REQUIRE(row.t == 21.0);
+    REQUIRE(row.unstored == 0);
+
+    SECTION("GetAs materializes rows") {
+        auto objs = sut.GetAs<JObject>();
+        REQUIRE(objs.size() == 100);
+        REQUIRE(static_cast<Hit*>(objs[5])->E == 10.0);
+        auto hits = sut.GetAs<Hit>();
+        REQUIRE(hits.at(99)->cell == 99);
+    }
+    SECTION("Concurrent GetAs materializes rows once") {
+        std::vector<std::vector<Hit*>> results(4);
+        std::vector<std::thread> threads;
+        for (auto& result : results) {
+            threads.emplace_back([&sut, &result](){ result = sut.GetAs<Hit>(); });
+        }
+        for (auto& thread : threads) thread.join();
+        for (auto& result : results) {
+            REQUIRE(result == results[0]);
+        }
+        REQUIRE(results[0].at(42)->E == 84.0);
+    }
+    SECTION("ClearData keeps the storage") {
+        auto capacity = sut.GetCapacity();
+        auto* data = energies.data();
+        sut.ClearData();
+        REQUIRE(sut.GetSize() == 0);
+        REQUIRE(sut.GetAs<JObject>().empty());
+        sut.Resize(50);
+        REQUIRE(sut.GetCapacity() == capacity);
+        REQUIRE(sut.GetColumn(&Hit::E).data() == data);
+        REQUIRE(sut.GetColumn(&Hit::E)[49] == 0.0); // Resize zero-initializes
+    }
+}
+
+struct HitSource : public JEventSource {
+    ColumnarOutput<Hit> m_hits_out {this, "hits", &Hit::cell, &Hit::E};
+    HitSource() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+    }
+    Result Emit(JEvent& event) override {
+        for (int i=0; i<10; ++i) {
+            Hit hit;
+            hit.cell = i;
+            hit.E = event.GetEventNumber() + i;
+            m_hits_out.push_back(hit);
+        }
+        return Result::Success;
+    }
+};
+
+struct CalibratedHitFac : public JFactory {
+    ColumnarInput<Hit> m_hits_in {this};
+    ColumnarOutput<Hit> m_calibrated_hits_out {this, "calibrated_hits", &Hit::cell, &Hit::E};
+
+    CalibratedHitFac() {
+        m_hits_in.SetTag("hits");
+    }
+    void Process(const JEvent&) override {
+        auto cells_in = m_hits_in.Column(&Hit::cell);
+        auto energies_in = m_hits_in.Column(&Hit::E);
+        m_calibrated_hits_out.Resize(m_hits_in.size());
+        auto cells_out = m_calibrated_hits_out.Column(&Hit::cell);
+        auto energies_out = m_calibrated_hits_out.Column(&Hit::E);
+        for (size_t i=0; i<m_hits_in.size(); ++i) {
+            cells_out[i] = cells_in[i];
+            energies_out[i] = energies_in[i] * 2.0;
+        }
+    }
+};
+
+int g_process_count = 0;
+
+struct CalibratedHitProc : public JEventProcessor {
+    ColumnarInput<Hit> m_hits_in {this};
+    CalibratedHitProc() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        m_hits_in.SetTag("calibrated_hits");
+    }
+    void ProcessSequential(const JEvent& event) override {
+        g_process_count += 1;
+        REQUIRE(m_hits_in.size() == 10);
+        REQUIRE(m_hits_in.Column(&Hit::cell)[9] == 9);
+        REQUIRE(m_hits_in.Column(&Hit::E)[9] == 2.0 * (event.GetEventNumber() + 9));
+        REQUIRE_THROWS(m_hits_in.Column(&Hit::t));
+
+        // The inspector and DST writers see materialized rows
+        auto objs = event.GetFactorySet()->GetDatabundle(std::type_index(typeid(Hit)), "calibrated_hits")->GetAs<JObject>();
+        REQUIRE(objs.size() == 10);
+    }
+};
+
+TEST_CASE("JDatabundle_ColumnarFactory") {
+    g_process_count = 0;
+    JApplication app;
+    app.Add(new HitSource);
+    app.Add(new JFactoryGeneratorT<CalibratedHitFac>);
+    app.Add(new CalibratedHitProc);
+    app.SetParameterValue("jana:nevents", 10);
+    app.SetParameterValue("jana:loglevel", "error");
+    app.Run();
+    REQUIRE(g_process_count == 10);
+}
+
+} // namespace jana::databundletests::columnar
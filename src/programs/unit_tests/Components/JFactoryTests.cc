@@ -11,6 +11,10 @@
 
 #include <JANA/JEvent.h>
 #include <JANA/JFactoryT.h>
+#include <JANA/Services/JRunCache.h>
+
+#include <atomic>
+#include <functional>
 
 TEST_CASE("JFactoryTests") {
 
@@ -663,3 +667,67 @@ TEST_CASE("PersistentFactory_Test") {
 }
 
 
+
+
+std::atomic_int g_calib_build_count {0};
+
+struct CalibTable {
+    int32_t run_nr;
+    std::vector<double> gains;
+};
+
+struct CalibratedFactory : public JFactoryT<JFactoryTestDummyObject> {
+    SharedResource<JParameterManager, CalibTable, std::function<CalibTable(std::shared_ptr<JParameterManager>, int32_t)>> m_calib {this, "calib",
+        [](std::shared_ptr<JParameterManager>, int32_t run_nr) {
+            g_calib_build_count += 1;
+            return CalibTable {run_nr, std::vector<double>(1000, 1.0)};
+        }};
+
+    void Process(const std::shared_ptr<const JEvent>&) override {
+        Insert(new JFactoryTestDummyObject(m_calib().run_nr));
+    }
+};
+
+TEST_CASE("JFactory_SharedResource") {
+    g_calib_build_count = 0;
+    JApplication app;
+    app.Add(new JFactoryGeneratorT<CalibratedFactory>());
+
+    // Simulate a pool of in-flight events
+    std::vector<std::shared_ptr<JEvent>> events;
+    for (int i=0; i<8; ++i) {
+        events.push_back(std::make_shared<JEvent>(&app));
+    }
+    auto cache = app.GetService<JRunCache>();
+
+    auto process = [](JEvent& event, int32_t run_nr) {
+        event.Clear();
+        event.SetRunNumber(run_nr);
+        auto data = event.Get<JFactoryTestDummyObject>();
+        REQUIRE(data.size() == 1);
+        REQUIRE(data.at(0)->data == run_nr);
+        return dynamic_cast<CalibratedFactory*>(event.GetFactory<JFactoryTestDummyObject>())->m_calib.GetShared().get();
+    };
+
+    const CalibTable* run1_table = nullptr;
+    for (auto& event : events) {
+        auto table = process(*event, 1);
+        if (run1_table == nullptr) run1_table = table;
+        REQUIRE(table == run1_table); // Every event sees the same table
+    }
+    REQUIRE(g_calib_build_count == 1);
+    REQUIRE(cache->GetLiveEntryCount() == 1);
+
+    // Run 2 arrives, but the last event is still working on run 1
+    for (size_t i=0; i<7; ++i) {
+        process(*events[i], 2);
+    }
+    REQUIRE(g_calib_build_count == 2);
+    REQUIRE(cache->GetLiveEntryCount() == 2);
+
+    // Once the last event moves on, run 1's table is freed
+    process(*events[7], 2);
+    REQUIRE(g_calib_build_count == 2);
+    REQUIRE(cache->GetLiveEntryCount() == 1);
+}
+
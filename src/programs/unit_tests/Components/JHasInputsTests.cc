@@ -61,8 +61,8 @@ struct TestEventSource : public JEventSource {
 struct TestProc : public JEventProcessor {
 
     Input<TestHit> m_det_a_hits_in {this};
-
-    //VariadicInput<TestHit> m_det_a_hits_in {this};
+    VariadicInput<TestHit> m_det_ab_hits_in {this};
+    Input<TestHit> m_det_z_hits_in {this, {.name="detector_z_hits", .is_optional=true}};
 
 #if JANA2_HAVE_PODIO
     PodioInput<ExampleHit> m_det_c_hits_in {this};
@@ -76,6 +76,7 @@ struct TestProc : public JEventProcessor {
     TestProc() {
         SetCallbackStyle(CallbackStyle::ExpertMode);
         m_det_a_hits_in.SetTag("detector_a_hits");
+        m_det_ab_hits_in.SetTags({"detector_a_hits", "detector_b_hits"});
 
 #if JANA2_HAVE_PODIO
         m_det_c_hits_in.SetCollectionName("detector_c_hits");
@@ -89,9 +90,29 @@ struct TestProc : public JEventProcessor {
 #endif
     }
 
-    void ProcessSequential(const JEvent&) override {
+    void ProcessSequential(const JEvent& event) override {
         REQUIRE(m_det_a_hits_in->size() == 3);
         REQUIRE(m_det_a_hits_in->at(2)->cell_col == 4);
+        REQUIRE_THROWS(m_det_a_hits_in->at(3));
+
+        // Inputs view the producer's storage directly instead of copying it
+        auto& det_a_storage = event.GetLightweightDatabundle<TestHit>("detector_a_hits", true, false)->GetData();
+        REQUIRE((const void*) m_det_a_hits_in->data() == (const void*) det_a_storage.data());
+        REQUIRE((const void*) m_det_ab_hits_in(0).data() == (const void*) det_a_storage.data());
+        REQUIRE(m_det_ab_hits_in(1).size() == 3);
+        REQUIRE(m_det_ab_hits_in(1)[0]->energy == 50.5);
+        REQUIRE(m_det_z_hits_in->empty());
+
+        double total_energy = 0;
+        for (const TestHit* hit : *m_det_a_hits_in) {
+            total_energy += hit->energy;
+        }
+        REQUIRE(total_energy == 100.5 + 99.8 + 70.1);
+
+        // Copying is explicit
+        std::vector<const TestHit*> copy = m_det_a_hits_in->Copy();
+        REQUIRE(copy.size() == 3);
+        REQUIRE(copy.data() != (const TestHit* const*) m_det_a_hits_in->data());
 
 #if JANA2_HAVE_PODIO
         REQUIRE(m_det_c_hits_in->size() == 1);
@@ -120,5 +141,49 @@ TEST_CASE("JHasInputs_BasicTests") {
     app.Run();
 };
 
+TEST_CASE("JHasInputs_DatabundleSlots") {
+
+    // Databundles get inserted in a different order on each event, so their positions
+    // in each JFactorySet differ, but their slots must not
+    JEvent event1;
+    event1.Insert(new TestHit(1, 1, 1.0), "detector_a_hits");
+    event1.Insert(new TestHit(2, 2, 2.0), "detector_b_hits");
+    JEvent event2;
+    event2.Insert(new TestHit(2, 2, 2.0), "detector_b_hits");
+    event2.Insert(new TestHit(1, 1, 1.0), "detector_a_hits");
+
+    jana::components::JHasInputs owner;
+    jana::components::JHasInputs::Input<TestHit> input {&owner};
+    jana::components::JHasInputs::VariadicInput<TestHit> variadic_input {&owner};
+
+    input.SetTag("detector_a_hits");
+    variadic_input.SetTags({"detector_b_hits", "detector_a_hits", "detector_z_hits"});
+    REQUIRE(variadic_input.GetRequestedDatabundleSlots().size() == 3);
+    REQUIRE(variadic_input.GetRequestedDatabundleSlots().at(1) == input.GetDatabundleSlot());
+
+    for (auto* event : {&event1, &event2}) {
+        auto* facset = event->GetFactorySet();
+        auto* databundle = facset->GetDatabundle(input.GetDatabundleSlot());
+        REQUIRE(databundle != nullptr);
+        REQUIRE(databundle == facset->GetDatabundle(std::type_index(typeid(TestHit)), "detector_a_hits"));
+
+        auto& slots = variadic_input.GetRequestedDatabundleSlots();
+        REQUIRE(facset->GetDatabundle(slots.at(0)) == facset->GetDatabundle(std::type_index(typeid(TestHit)), "detector_b_hits"));
+        REQUIRE(facset->GetDatabundle(slots.at(2)) == nullptr);
+    }
+
+    // Rewiring re-resolves the slot
+    auto old_slot = input.GetDatabundleSlot();
+    input.SetDatabundleName("detector_b_hits");
+    REQUIRE(input.GetDatabundleSlot() != old_slot);
+    REQUIRE(input.GetDatabundleSlot() == variadic_input.GetRequestedDatabundleSlots().at(0));
+
+    // Same name, different type
+    jana::components::JHasInputs::Input<JObject> other_input {&owner};
+    other_input.SetTag("detector_b_hits");
+    REQUIRE(other_input.GetDatabundleSlot() != input.GetDatabundleSlot());
+    REQUIRE(event1.GetFactorySet()->GetDatabundle(other_input.GetDatabundleSlot()) == nullptr);
+}
+
 }
 
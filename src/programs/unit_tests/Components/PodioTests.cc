@@ -497,6 +497,26 @@ TEST_CASE("PodioTests_ExceptionInFactoryInit") {
     }
 }
 
+TEST_CASE("PodioTests_InsertCollectionManyEvents") {
+    // From the second event on, InsertCollection() reuses the podio::Frame databundle, which has to get cleared
+    // along with its dummy factory. Otherwise the third event tries to put "hits" into the same frame again.
+    JApplication app;
+    auto event = std::make_shared<JEvent>(&app);
+
+    for (size_t i=0; i<5; ++i) {
+        ExampleHitCollection hits;
+        auto hit = hits.create();
+        hit.cellID(i);
+        event->InsertCollection<ExampleHit>(std::move(hits), "hits");
+
+        auto coll = event->GetCollection<ExampleHit>("hits");
+        REQUIRE(coll->size() == 1);
+        REQUIRE(coll->at(0).cellID() == i);
+        REQUIRE(event->Get<podio::Frame>().size() == 1);
+        event->Clear(true);
+    }
+}
+
 TEST_CASE("PodioTests_InterleavedInsertAndProcess") {
     JApplication app;
     app.Add(new JFactoryGeneratorT<ExceptingPodioFactory>);
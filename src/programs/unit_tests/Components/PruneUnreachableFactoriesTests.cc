@@ -0,0 +1,266 @@
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#include <catch.hpp>
+#include <JANA/JApplication.h>
+#include <JANA/JEventSource.h>
+#include <JANA/JEventProcessor.h>
+#include <JANA/JEventUnfolder.h>
+#include <JANA/JFactory.h>
+#include <JANA/JFactoryGenerator.h>
+#include <JANA/Topology/JTopologyBuilder.h>
+
+#include <atomic>
+
+namespace jana::pruneunreachablefactoriestests {
+
+struct Hit { double energy; };
+struct Cluster { double energy; };
+struct Track { double energy; };
+struct Particle { double energy; };
+
+struct HitSource : public JEventSource {
+    HitSource() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+    }
+    Result Emit(JEvent& event) override {
+        event.Insert(new Hit {1.0}, "hits");
+        return Result::Success;
+    }
+};
+
+struct ClusterFac : public JFactory {
+    Input<Hit> m_hits_in {this};
+    Output<Cluster> m_clusters_out {this, "clusters"};
+
+    ClusterFac() {
+        m_hits_in.SetTag("hits");
+    }
+    void Process(const JEvent&) override {
+        m_clusters_out().push_back(new Cluster {m_hits_in->at(0)->energy * 2});
+    }
+};
+
+struct TrackFac : public JFactory {
+    Input<Hit> m_hits_in {this};
+    Output<Track> m_tracks_out {this, "tracks"};
+
+    TrackFac() {
+        m_hits_in.SetTag("hits");
+    }
+    void Process(const JEvent&) override {
+        m_tracks_out().push_back(new Track {m_hits_in->at(0)->energy * 3});
+    }
+};
+
+struct ParticleFac : public JFactory {
+    Input<Cluster> m_clusters_in {this};
+    Input<Track> m_tracks_in {this};
+    Output<Particle> m_particles_out {this, "particles"};
+
+    ParticleFac() {
+        m_clusters_in.SetTag("clusters");
+        m_tracks_in.SetTag("tracks");
+    }
+    void Process(const JEvent&) override {
+        m_particles_out().push_back(new Particle {m_clusters_in->at(0)->energy + m_tracks_in->at(0)->energy});
+    }
+};
+
+struct ParticleProc : public JEventProcessor {
+    Input<Particle> m_particles_in {this};
+    int m_event_count = 0;
+
+    ParticleProc() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        m_particles_in.SetTag("particles");
+    }
+    void ProcessSequential(const JEvent&) override {
+        REQUIRE(m_particles_in->size() == 1);
+        REQUIRE(m_particles_in->at(0)->energy == 5.0);
+        m_event_count += 1;
+    }
+};
+
+std::atomic_int g_dead_count {0};
+
+struct DeadFac : public JFactory {
+    Input<Hit> m_hits_in {this};
+    Output<Cluster> m_clusters_out {this, "dead_clusters"};
+    DeadFac() {
+        m_hits_in.SetTag("hits");
+    }
+    void Process(const JEvent&) override {
+        g_dead_count += 1;
+    }
+};
+
+TEST_CASE("PruneUnreachableFactories_Basics") {
+    g_dead_count = 0;
+    JApplication app;
+    auto proc = new ParticleProc;
+    app.Add(new HitSource);
+    app.Add(new JFactoryGeneratorT<ClusterFac>);
+    app.Add(new JFactoryGeneratorT<TrackFac>);
+    app.Add(new JFactoryGeneratorT<ParticleFac>);
+    app.Add(new JFactoryGeneratorT<DeadFac>);
+    app.Add(proc);
+    app.SetParameterValue("jana:nevents", 10);
+    app.SetParameterValue("jana:loglevel", "error");
+    app.SetParameterValue("jana:prune_unreachable_factories", true);
+
+    SECTION("Unreachable factory is pruned") {
+        app.Initialize();
+        auto report = app.GetService<JTopologyBuilder>()->PrintFactoryReachability();
+        REQUIRE(report.find("3 of 3 factories are reachable") != std::string::npos);
+        app.Run();
+        REQUIRE(proc->m_event_count == 10);
+    }
+
+    SECTION("Autoactivated factory is kept") {
+        app.SetParameterValue("autoactivate", "jana::pruneunreachablefactoriestests::Cluster:dead_clusters");
+        app.Initialize();
+        auto report = app.GetService<JTopologyBuilder>()->PrintFactoryReachability();
+        REQUIRE(report.find("of 4 factories") != std::string::npos);
+        app.Run();
+        REQUIRE(proc->m_event_count == 10);
+        REQUIRE(g_dead_count == 10);
+    }
+}
+
+struct TimesliceSource : public JEventSource {
+    TimesliceSource() {
+        SetLevel(JEventLevel::Timeslice);
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+    }
+    Result Emit(JEvent& event) override {
+        event.Insert(new Hit {1.0}, "ts_hits");
+        return Result::Success;
+    }
+};
+
+struct TimesliceClusterFac : public JFactory {
+    Input<Hit> m_hits_in {this};
+    Output<Cluster> m_clusters_out {this, "ts_clusters"};
+    TimesliceClusterFac() {
+        SetLevel(JEventLevel::Timeslice);
+        m_hits_in.SetTag("ts_hits");
+        m_hits_in.SetLevel(JEventLevel::Timeslice); // Consumers at the PhysicsEvent level trigger us with their own event
+    }
+    void Process(const JEvent&) override {
+        m_clusters_out().push_back(new Cluster {m_hits_in->at(0)->energy * 2});
+    }
+};
+
+struct TimesliceTrackFac : public JFactory {
+    Input<Hit> m_hits_in {this};
+    Output<Track> m_tracks_out {this, "ts_tracks"};
+    TimesliceTrackFac() {
+        SetLevel(JEventLevel::Timeslice);
+        m_hits_in.SetTag("ts_hits");
+        m_hits_in.SetLevel(JEventLevel::Timeslice); // Consumers at the PhysicsEvent level trigger us with their own event
+    }
+    void Process(const JEvent&) override {
+        m_tracks_out().push_back(new Track {m_hits_in->at(0)->energy * 3});
+    }
+};
+
+struct TimesliceDeadFac : public JFactory {
+    Output<Track> m_tracks_out {this, "ts_dead_tracks"};
+    TimesliceDeadFac() {
+        SetLevel(JEventLevel::Timeslice);
+    }
+    void Process(const JEvent&) override {}
+};
+
+// Reads a Timeslice-level collection from a PhysicsEvent-level factory
+struct EventParticleFac : public JFactory {
+    Input<Track> m_tracks_in {this};
+    Output<Particle> m_particles_out {this, "particles"};
+    EventParticleFac() {
+        m_tracks_in.SetTag("ts_tracks");
+        m_tracks_in.SetLevel(JEventLevel::Timeslice);
+    }
+    void Process(const JEvent&) override {
+        m_particles_out().push_back(new Particle {m_tracks_in->at(0)->energy});
+    }
+};
+
+struct OneToOneUnfolder : public JEventUnfolder {
+    Input<Hit> m_hits_in {this}; // Components which don't declare any inputs turn pruning off
+    OneToOneUnfolder() {
+        SetParentLevel(JEventLevel::Timeslice);
+        SetChildLevel(JEventLevel::PhysicsEvent);
+        m_hits_in.SetTag("ts_hits");
+    }
+    Result Unfold(const JEvent&, JEvent&, int) override {
+        return Result::NextChildNextParent;
+    }
+};
+
+// Reads a Timeslice-level collection directly, as well as one that depends on another
+struct MultilevelProc : public JEventProcessor {
+    Input<Cluster> m_clusters_in {this};
+    Input<Particle> m_particles_in {this};
+    int m_event_count = 0;
+
+    MultilevelProc() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        m_clusters_in.SetTag("ts_clusters");
+        m_clusters_in.SetLevel(JEventLevel::Timeslice);
+        m_particles_in.SetTag("particles");
+    }
+    void ProcessSequential(const JEvent& event) override {
+        REQUIRE(m_clusters_in->at(0)->energy == 2.0);
+        REQUIRE(m_particles_in->at(0)->energy == 3.0);
+        REQUIRE(event.GetParent(JEventLevel::Timeslice).GetFactorySet()->GetPrunedFactoryCount() == 1);
+        REQUIRE(event.GetFactorySet()->GetPrunedFactoryCount() == 0);
+        m_event_count += 1;
+    }
+};
+
+TEST_CASE("PruneUnreachableFactories_Multilevel") {
+    JApplication app;
+    auto proc = new MultilevelProc;
+    app.Add(new TimesliceSource);
+    app.Add(new JFactoryGeneratorT<TimesliceDeadFac>);
+    app.Add(new JFactoryGeneratorT<EventParticleFac>);
+    app.Add(new JFactoryGeneratorT<TimesliceTrackFac>);
+    app.Add(new JFactoryGeneratorT<TimesliceClusterFac>);
+    app.Add(new OneToOneUnfolder);
+    app.Add(proc);
+    app.SetParameterValue("jana:nevents", 10);
+    app.SetParameterValue("jana:loglevel", "error");
+    app.SetParameterValue("jana:prune_unreachable_factories", true);
+    app.Run();
+    REQUIRE(proc->m_event_count == 10);
+}
+
+// Only asks for its input from inside Process(), so pruning can't tell that it needs ParticleFac
+struct LegacyParticleProc : public JEventProcessor {
+    std::atomic_int m_event_count {0};
+    void Process(const std::shared_ptr<const JEvent>& event) override {
+        auto particles = event->Get<Particle>("particles");
+        REQUIRE(particles.size() == 1);
+        REQUIRE(event->GetFactorySet()->GetPrunedFactoryCount() == 0);
+        m_event_count += 1;
+    }
+};
+
+TEST_CASE("PruneUnreachableFactories_LegacyFallback") {
+    JApplication app;
+    auto proc = new LegacyParticleProc;
+    app.Add(new HitSource);
+    app.Add(new JFactoryGeneratorT<ClusterFac>);
+    app.Add(new JFactoryGeneratorT<TrackFac>);
+    app.Add(new JFactoryGeneratorT<ParticleFac>);
+    app.Add(new JFactoryGeneratorT<DeadFac>);
+    app.Add(proc);
+    app.SetParameterValue("jana:nevents", 10);
+    app.SetParameterValue("jana:loglevel", "error");
+    app.SetParameterValue("jana:prune_unreachable_factories", true);
+    app.Run();
+    REQUIRE(proc->m_event_count == 10);
+}
+
+} // namespace jana::pruneunreachablefactoriestests
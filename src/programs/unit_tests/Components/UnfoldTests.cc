@@ -5,7 +5,12 @@
 #include <JANA/JEventProcessor.h>
 #include <JANA/Topology/JUnfoldArrow.h>
 #include <JANA/Topology/JFoldArrow.h>
+#include <JANA/JEventFolder.h>
 #include <cstdint>
+#include <thread>
+#include <map>
+#include <mutex>
+#include <set>
 
 #if JANA2_HAVE_PODIO
 #include <PodioDatamodel/ExampleHitCollection.h>
@@ -262,6 +267,315 @@ TEST_CASE("NoOpUnfolder_Tests") {
 }
 
 
+struct ParallelUnfolder : public JEventUnfolder {
+    std::atomic_int active_count {0};
+    std::atomic_int max_active_count {0};
+
+    ParallelUnfolder() {
+        SetParentLevel(JEventLevel::Timeslice);
+        SetChildLevel(JEventLevel::PhysicsEvent);
+        EnableParallelUnfold();
+    }
+
+    Result Unfold(const JEvent& parent, JEvent& child, int item) override {
+        int active = ++active_count;
+        int max_active = max_active_count;
+        while (active > max_active && !max_active_count.compare_exchange_weak(max_active, active)) {}
+
+        // Every third timeslice is slow, so that later timeslices finish unfolding first
+        auto parent_nr = parent.GetEventNumber();
+        if (parent_nr % 3 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        child.SetEventNumber(parent_nr * 100 + item);
+        active_count--;
+
+        // Timeslice n contains (n % 4) physics events
+        int child_count = parent_nr % 4;
+        if (child_count == 0) {
+            return Result::KeepChildNextParent;
+        }
+        return (item == child_count - 1) ? Result::NextChildNextParent : Result::NextChildKeepParent;
+    }
+};
+
+class OrderedPhysEvtProc : public JEventProcessor {
+public:
+    std::vector<uint64_t> event_nrs;
+
+    OrderedPhysEvtProc() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        EnableOrdering();
+    }
+    void ProcessSequential(const JEvent& event) override {
+        event_nrs.push_back(event.GetEventNumber());
+    }
+};
+
+TEST_CASE("ParallelUnfoldTests") {
+    JApplication app;
+    auto source = new JEventSource();
+    source->SetLevel(JEventLevel::Timeslice);
+    auto unfolder = new ParallelUnfolder;
+    auto proc = new OrderedPhysEvtProc;
+    app.Add(source);
+    app.Add(unfolder);
+    app.Add(proc);
+    app.SetParameterValue("nthreads", 4);
+    app.SetParameterValue("jana:nevents", 40);
+    app.SetParameterValue("jana:max_inflight_timeslices", 8);
+    app.SetParameterValue("jana:max_inflight_events", 8);
+    app.SetParameterValue("jana:loglevel", "warn");
+    app.Run();
+
+    REQUIRE(unfolder->max_active_count > 1);
+
+    // Timeslices may reach the unfolder in any order, but each timeslice's children
+    // have to stay together and in order, just like with sequential unfolding
+    size_t expected_child_count = 0;
+    for (uint64_t parent_nr=1; parent_nr<=40; ++parent_nr) {
+        expected_child_count += parent_nr % 4;
+    }
+    REQUIRE(proc->event_nrs.size() == expected_child_count);
+
+    for (size_t i=0; i<proc->event_nrs.size(); ++i) {
+        auto parent_nr = proc->event_nrs[i] / 100;
+        auto item = proc->event_nrs[i] % 100;
+        if (item == 0) {
+            // First child of its parent, so the previous parent has to be done
+            if (i > 0) {
+                auto prev_parent_nr = proc->event_nrs[i-1] / 100;
+                REQUIRE(proc->event_nrs[i-1] % 100 == prev_parent_nr % 4 - 1);
+            }
+        }
+        else {
+            REQUIRE(proc->event_nrs[i-1] == parent_nr * 100 + item - 1);
+        }
+    }
+}
+
+struct ParallelHit { int id; };
+
+struct ParallelUnfolderWithOutput : public ParallelUnfolder {
+    Output<ParallelHit> hits_out {this, "hits"};
+};
+
+TEST_CASE("ParallelUnfoldTests_RejectsOutputs") {
+    JApplication app;
+    auto source = new JEventSource();
+    source->SetLevel(JEventLevel::Timeslice);
+    app.Add(source);
+    app.Add(new ParallelUnfolderWithOutput);
+    app.Add(new OrderedPhysEvtProc);
+    app.SetParameterValue("jana:loglevel", "warn");
+    // Rejected while building the topology, before any event reaches Unfold()
+    REQUIRE_THROWS_WITH(app.Initialize(), Catch::Contains("Parallel unfolding doesn't support Input or Output members"));
+}
+
+
+struct SplittingUnfolder : public JEventUnfolder {
+    SplittingUnfolder() {
+        SetParentLevel(JEventLevel::Timeslice);
+        SetChildLevel(JEventLevel::PhysicsEvent);
+    }
+
+    Result Unfold(const JEvent& parent, JEvent& child, int item) override {
+        auto parent_nr = parent.GetEventNumber();
+        child.SetEventNumber(parent_nr * 100 + item);
+
+        // Timeslice n contains (n % 4) physics events
+        int child_count = parent_nr % 4;
+        if (child_count == 0) {
+            return Result::KeepChildNextParent;
+        }
+        return (item == child_count - 1) ? Result::NextChildNextParent : Result::NextChildKeepParent;
+    }
+};
+
+class SlowFirstChildProc : public JEventProcessor {
+public:
+    SlowFirstChildProc() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+    }
+    void ProcessParallel(const JEvent& event) override {
+        // The first child of each timeslice lags behind its siblings
+        if (event.GetEventNumber() % 100 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+};
+
+struct CountingFolder : public JEventFolder {
+    std::mutex mutex;
+    std::map<uint64_t, int> folded_counts;
+
+    CountingFolder(bool commutative) {
+        SetParentLevel(JEventLevel::Timeslice);
+        SetChildLevel(JEventLevel::PhysicsEvent);
+        EnableCommutativeFold(commutative);
+    }
+
+    void Fold(const JEvent& child, JEvent& parent, int) override {
+        REQUIRE(child.GetEventNumber() / 100 == parent.GetEventNumber());
+        std::lock_guard<std::mutex> lock(mutex);
+        folded_counts[parent.GetEventNumber()] += 1;
+    }
+
+    int GetFoldedCount(uint64_t parent_nr) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return folded_counts[parent_nr];
+    }
+};
+
+class FoldedTimesliceProc : public JEventProcessor {
+public:
+    CountingFolder* folder;
+    std::vector<uint64_t> event_nrs;
+
+    FoldedTimesliceProc(CountingFolder* folder) : folder(folder) {
+        SetLevel(JEventLevel::Timeslice);
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+    }
+    void ProcessSequential(const JEvent& event) override {
+        // Each timeslice only comes out the other side once all of its children have been folded back in
+        REQUIRE(folder->GetFoldedCount(event.GetEventNumber()) == int(event.GetEventNumber() % 4));
+        event_nrs.push_back(event.GetEventNumber());
+    }
+};
+
+TEST_CASE("UnfoldFoldTests") {
+    bool commutative = false;
+    SECTION("Ordered") {
+        commutative = false;
+    }
+    SECTION("Commutative") {
+        commutative = true;
+    }
+
+    JApplication app;
+    auto source = new JEventSource();
+    source->SetLevel(JEventLevel::Timeslice);
+    auto folder = new CountingFolder(commutative);
+    auto proc = new FoldedTimesliceProc(folder);
+    app.Add(source);
+    app.Add(new SplittingUnfolder);
+    app.Add(new SlowFirstChildProc);
+    app.Add(folder);
+    app.Add(proc);
+    app.SetParameterValue("nthreads", 4);
+    app.SetParameterValue("jana:nevents", 40);
+    app.SetParameterValue("jana:max_inflight_timeslices", 8);
+    app.SetParameterValue("jana:max_inflight_events", 8);
+    app.SetParameterValue("jana:loglevel", "warn");
+    app.Run();
+
+    // Every timeslice, including the ones with no children, is returned exactly once
+    std::sort(proc->event_nrs.begin(), proc->event_nrs.end());
+    REQUIRE(proc->event_nrs.size() == 40);
+    for (uint64_t parent_nr=0; parent_nr<40; ++parent_nr) {
+        REQUIRE(proc->event_nrs[parent_nr] == parent_nr);
+    }
+}
+
+
+struct ViewHit {
+    // Keeps track of which hits are still alive, so that we notice if a child outlives its parent's data
+    static std::mutex live_mutex;
+    static std::set<const ViewHit*> live_hits;
+
+    uint64_t id;
+    ViewHit(uint64_t id) : id(id) {
+        std::lock_guard<std::mutex> lock(live_mutex);
+        live_hits.insert(this);
+    }
+    ~ViewHit() {
+        std::lock_guard<std::mutex> lock(live_mutex);
+        live_hits.erase(this);
+    }
+    static bool IsAlive(const ViewHit* hit) {
+        std::lock_guard<std::mutex> lock(live_mutex);
+        return live_hits.count(hit) == 1;
+    }
+};
+std::mutex ViewHit::live_mutex;
+std::set<const ViewHit*> ViewHit::live_hits;
+
+struct ViewHitSource : public JEventSource {
+    Output<ViewHit> hits_out {this, "hits"};
+
+    ViewHitSource() {
+        SetLevel(JEventLevel::Timeslice);
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+    }
+    Result Emit(JEvent& event) override {
+        for (uint64_t i=0; i<6; ++i) {
+            hits_out().push_back(new ViewHit(event.GetEventNumber() * 100 + i));
+        }
+        return Result::Success;
+    }
+};
+
+struct ViewUnfolder : public JEventUnfolder {
+    Input<ViewHit> hits_in {this};
+    Output<ViewHit> hits_out {this, "hits"};
+
+    ViewUnfolder() {
+        SetParentLevel(JEventLevel::Timeslice);
+        SetChildLevel(JEventLevel::PhysicsEvent);
+        hits_in.SetDatabundleName("hits");
+        hits_out.EnableParentView();
+    }
+
+    Result Unfold(const JEvent& parent, JEvent& child, int item) override {
+        // Two hits per physics event
+        size_t begin = 2 * item;
+        size_t end = std::min(begin + 2, hits_in->size());
+        hits_out.AppendParentRange(*hits_in, begin, end);
+        child.SetEventNumber(parent.GetEventNumber() * 100 + item);
+        return (end == hits_in->size()) ? Result::NextChildNextParent : Result::NextChildKeepParent;
+    }
+};
+
+struct ViewHitProc : public JEventProcessor {
+    Input<ViewHit> hits_in {this};
+    std::atomic_int checked_count {0};
+
+    ViewHitProc() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        hits_in.SetDatabundleName("hits");
+    }
+    void ProcessParallel(const JEvent&) override {
+        // By now the parent has usually been sent back to its pool
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    void ProcessSequential(const JEvent& event) override {
+        const auto& parent_hits = event.GetParent(JEventLevel::Timeslice).Get<ViewHit>("hits");
+        auto item = event.GetEventNumber() % 100;
+        REQUIRE(hits_in->size() == 2);
+        for (size_t i=0; i<2; ++i) {
+            REQUIRE(ViewHit::IsAlive(hits_in->at(i)));
+            REQUIRE(hits_in->at(i) == parent_hits.at(2*item + i)); // Same object, not a copy
+            REQUIRE(hits_in->at(i)->id == (event.GetEventNumber() / 100) * 100 + 2*item + i);
+        }
+        checked_count += 1;
+    }
+};
+
+TEST_CASE("UnfoldTests_ParentView") {
+    JApplication app;
+    auto proc = new ViewHitProc;
+    app.Add(new ViewHitSource);
+    app.Add(new ViewUnfolder);
+    app.Add(proc);
+    app.SetParameterValue("nthreads", 4);
+    app.SetParameterValue("jana:nevents", 20);
+    app.SetParameterValue("jana:loglevel", "warn");
+    app.Run();
+
+    REQUIRE(proc->checked_count == 60);
+}
+
+
 #if JANA2_HAVE_PODIO
 
 /*
@@ -0,0 +1,189 @@
+#define JANA2_TESTCASE
+
+#include <JANA/Engine/JAutoscaler.h>
+#include <catch.hpp>
+
+#include <JANA/JApplication.h>
+#include <JANA/JEventSource.h>
+#include <JANA/JEventProcessor.h>
+
+namespace jana::engine::autoscaler_tests {
+
+JAutoscaler::Measurement Measure(size_t threads, size_t inflight, double throughput_hz, double idle_fraction, double empty_pool_fraction=0) {
+    JAutoscaler::Measurement m;
+    m.thread_count = threads;
+    m.max_inflight_events = inflight;
+    m.throughput_hz = throughput_hz;
+    m.idle_fraction = idle_fraction;
+    m.scheduler_fraction = 0.01;
+    m.empty_pool_fraction = empty_pool_fraction;
+    return m;
+}
+
+TEST_CASE("JAutoscaler_Decide") {
+
+    JAutoscaler sut;
+    sut.m_min_threads = 1;
+    sut.m_max_threads = 16;
+    sut.m_max_inflight_events = 64;
+    sut.m_threshold = 0.05;
+    sut.m_cooldown_windows = 2;
+
+    SECTION("Saturated workers get more threads until throughput stops improving") {
+        auto d = sut.Decide(Measure(4, 8, 100, 0.01));
+        REQUIRE(d.thread_count == 5);
+        REQUIRE(d.max_inflight_events == 8);
+
+        // 20% better: keep the step, and keep climbing
+        d = sut.Decide(Measure(5, 8, 120, 0.01));
+        REQUIRE(d.thread_count == 6);
+
+        // 1% better isn't worth an extra core: undo
+        d = sut.Decide(Measure(6, 8, 121, 0.01));
+        REQUIRE(d.thread_count == 5);
+
+        // Hysteresis: hold still during cooldown even though workers still look saturated
+        d = sut.Decide(Measure(5, 8, 120, 0.01));
+        REQUIRE(d.thread_count == 5);
+        d = sut.Decide(Measure(5, 8, 120, 0.01));
+        REQUIRE(d.thread_count == 5);
+
+        // Cooldown is over, so try again
+        d = sut.Decide(Measure(5, 8, 120, 0.01));
+        REQUIRE(d.thread_count == 6);
+
+        // Failing the same experiment again doubles the cooldown
+        d = sut.Decide(Measure(6, 8, 120, 0.01));
+        REQUIRE(d.thread_count == 5);
+        REQUIRE(sut.m_cooldown_remaining == 4);
+    }
+
+    SECTION("Adding threads also grows the pool if there aren't enough events to go around") {
+        auto d = sut.Decide(Measure(4, 4, 100, 0.01));
+        REQUIRE(d.thread_count == 5);
+        REQUIRE(d.max_inflight_events == 5);
+    }
+
+    SECTION("Adding threads never shrinks the pool, and never grows it past the configured max") {
+        // More events than threads is fine and stays that way
+        auto d = sut.Decide(Measure(4, 32, 100, 0.01));
+        REQUIRE(d.thread_count == 5);
+        REQUIRE(d.max_inflight_events == 32);
+
+        sut.m_max_inflight_events = 5;
+        d = sut.Decide(Measure(5, 5, 120, 0.01));
+        REQUIRE(d.thread_count == 6);
+        REQUIRE(d.max_inflight_events == 5);
+    }
+
+    SECTION("Idle workers starved by an empty pool get more in-flight events") {
+        auto d = sut.Decide(Measure(4, 4, 100, 0.5, 0.9));
+        REQUIRE(d.thread_count == 4);
+        REQUIRE(d.max_inflight_events == 6);
+
+        d = sut.Decide(Measure(4, 6, 150, 0.3, 0.9));
+        REQUIRE(d.thread_count == 4);
+        REQUIRE(d.max_inflight_events == 9);
+
+        // Never exceeds the configured max
+        sut.m_max_inflight_events = 10;
+        d = sut.Decide(Measure(4, 9, 160, 0.3, 0.9));
+        REQUIRE(d.max_inflight_events == 10);
+        d = sut.Decide(Measure(4, 10, 160, 0.3, 0.9));
+        REQUIRE(d.max_inflight_events == 10);
+    }
+
+    SECTION("Idle workers with a full pool get removed, unless throughput drops") {
+        auto d = sut.Decide(Measure(16, 32, 100, 0.5));
+        REQUIRE(d.thread_count == 14);
+
+        // Throughput held steady, so keep going
+        d = sut.Decide(Measure(14, 32, 99, 0.5));
+        REQUIRE(d.thread_count == 13);
+
+        // Throughput dropped by 20%, so undo
+        d = sut.Decide(Measure(13, 32, 80, 0.5));
+        REQUIRE(d.thread_count == 14);
+        REQUIRE(sut.m_cooldown_remaining == 2);
+    }
+
+    SECTION("Thread count stays within bounds") {
+        sut.m_max_threads = 4;
+        auto d = sut.Decide(Measure(4, 8, 100, 0.01));
+        REQUIRE(d.thread_count == 4);
+
+        d = sut.Decide(Measure(1, 8, 100, 0.9));
+        REQUIRE(d.thread_count == 1);
+    }
+}
+
+
+struct InfiniteSource : public JEventSource {
+    InfiniteSource() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+    }
+    Result Emit(JEvent&) override {
+        return Result::Success;
+    }
+};
+
+struct SlowProcessor : public JEventProcessor {
+    SlowProcessor() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+    }
+    void ProcessSequential(const JEvent&) override {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+};
+
+TEST_CASE("JAutoscaler_OnlyProvidedWhenEnabled") {
+    JApplication app;
+    app.SetParameterValue("jana:loglevel", "warn");
+
+    SECTION("Disabled") {
+        app.Initialize();
+        REQUIRE_THROWS(app.GetService<JAutoscaler>());
+        REQUIRE(!app.GetJParameterManager()->Exists("jana:autoscale_min_threads"));
+    }
+
+    SECTION("Enabled") {
+        app.SetParameterValue("jana:autoscale", true);
+        app.Initialize();
+        REQUIRE(app.GetService<JAutoscaler>() != nullptr);
+        REQUIRE(app.GetJParameterManager()->Exists("jana:autoscale_min_threads"));
+    }
+}
+
+TEST_CASE("JExecutionEngine_ScaleInflightEvents") {
+    JApplication app;
+    app.SetParameterValue("jana:max_inflight_events", 2);
+    app.SetParameterValue("jana:loglevel", "warn");
+    app.Add(new InfiniteSource);
+    app.Add(new SlowProcessor);
+    app.Initialize();
+
+    auto sut = app.GetService<JExecutionEngine>();
+    sut->ScaleWorkers(2);
+    sut->RunTopology();
+    REQUIRE(sut->GetPerf().max_inflight_events == 2);
+
+    // Grow while events are in flight
+    sut->ScaleInflightEvents(6);
+    REQUIRE(sut->GetPerf().max_inflight_events == 6);
+
+    // Shrinking is a no-op
+    sut->ScaleInflightEvents(3);
+    REQUIRE(sut->GetPerf().max_inflight_events == 6);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    sut->PauseTopology();
+    sut->RunSupervisor();
+    auto perf = sut->GetPerf();
+    REQUIRE(perf.runstatus == JExecutionEngine::RunStatus::Paused);
+    REQUIRE(perf.event_count > 0);
+    // Pausing leaves events in the queues, but every event created by the pool is accounted for
+    REQUIRE(perf.free_event_count + perf.queued_event_count == 6);
+    sut->ScaleWorkers(0);
+}
+
+} // namespace jana::engine::autoscaler_tests
@@ -290,6 +290,585 @@ TEST_CASE("JExecutionEngine_ExternalPause") {
     }
 }
 
+TEST_CASE("JExecutionEngine_WorkStealing") {
+    JApplication app;
+    app.SetParameterValue("jana:enable_work_stealing", true);
+    app.SetParameterValue("jana:loglevel", "info");
+    app.Add(new TestSource());
+    app.Add(new TestProc());
+
+    SECTION("ExternalWorkerFollowsEvent") {
+        app.SetParameterValue("jana:nevents", 1);
+        app.SetParameterValue("jana:max_inflight_events", 2);
+        app.Initialize();
+        auto sut = app.GetService<JExecutionEngine>();
+
+        auto worker = sut->RegisterWorker();
+        sut->RunTopology();
+
+        JExecutionEngine::Task task;
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow != nullptr);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventSource");
+        REQUIRE(task.worker_state != nullptr);
+
+        task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+        auto* event = task.outputs[0].first;
+
+        // The source's output is handed directly to the map arrow without going through its queue
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow != nullptr);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventMap1");
+        REQUIRE(task.input_event == event);
+        REQUIRE(task.worker_state->tasks_handed_off == 1);
+        REQUIRE(task.worker_state->task_deque->GetSize() == 0);
+
+        task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+
+        // Likewise for map -> tap
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow != nullptr);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventTap");
+        REQUIRE(task.input_event == event);
+        REQUIRE(task.worker_state->tasks_handed_off == 2);
+        REQUIRE(sut->GetPerf().event_count == 0);
+
+        task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+
+        // The tap returns the event to the pool, so we go through the regular scheduler again
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow != nullptr);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventSource");
+        REQUIRE(sut->GetPerf().event_count == 1);
+
+        task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+        REQUIRE(task.status == JArrow::FireResult::Finished);
+
+        sut->ExchangeTask(task, worker.worker_id, true);
+        REQUIRE(task.arrow == nullptr);
+        REQUIRE(sut->GetRunStatus() == JExecutionEngine::RunStatus::Paused);
+        REQUIRE(sut->m_active_task_count == 0);
+
+        sut->FinishTopology();
+        REQUIRE(sut->GetRunStatus() == JExecutionEngine::RunStatus::Finished);
+    }
+
+    SECTION("SequentialArrowStaysExclusive") {
+        app.SetParameterValue("jana:max_inflight_events", 2);
+        app.Initialize();
+        auto sut = app.GetService<JExecutionEngine>();
+
+        auto worker0 = sut->RegisterWorker();
+        auto worker1 = sut->RegisterWorker();
+        sut->RunTopology();
+
+        // Get two events through the source and the map
+        JExecutionEngine::Task task0, task1;
+        sut->ExchangeTask(task0, worker0.worker_id);
+        REQUIRE(task0.arrow->GetName() == "PhysicsEventSource");
+        task0.arrow->Fire(task0.input_event, task0.outputs, task0.output_count, task0.status);
+        sut->ExchangeTask(task0, worker0.worker_id);
+        REQUIRE(task0.arrow->GetName() == "PhysicsEventMap1");
+
+        sut->ExchangeTask(task1, worker1.worker_id);
+        REQUIRE(task1.arrow->GetName() == "PhysicsEventSource");
+        task1.arrow->Fire(task1.input_event, task1.outputs, task1.output_count, task1.status);
+        sut->ExchangeTask(task1, worker1.worker_id);
+        REQUIRE(task1.arrow->GetName() == "PhysicsEventMap1");
+
+        task0.arrow->Fire(task0.input_event, task0.outputs, task0.output_count, task0.status);
+        task1.arrow->Fire(task1.input_event, task1.outputs, task1.output_count, task1.status);
+
+        // Worker 0 claims the tap
+        sut->ExchangeTask(task0, worker0.worker_id);
+        REQUIRE(task0.arrow->GetName() == "PhysicsEventTap");
+
+        // Worker 1 can't, so its event gets spilled into the tap's queue instead
+        sut->ExchangeTask(task1, worker1.worker_id, true);
+        REQUIRE(task1.arrow == nullptr);
+        REQUIRE(sut->m_total_spill_count == 1);
+        REQUIRE(task0.arrow->GetPort(0).GetQueue()->GetSize(0) == 1);
+
+        task0.arrow->Fire(task0.input_event, task0.outputs, task0.output_count, task0.status);
+        sut->PauseTopology();
+        sut->ExchangeTask(task0, worker0.worker_id, true);
+        REQUIRE(task0.arrow == nullptr);
+        REQUIRE(sut->GetRunStatus() == JExecutionEngine::RunStatus::Paused);
+        REQUIRE(sut->m_active_task_count == 0);
+    }
+
+    SECTION("MultipleWorkers") {
+        app.SetParameterValue("jana:nevents", 20);
+        app.SetParameterValue("jana:max_inflight_events", 8);
+        app.Initialize();
+        auto sut = app.GetService<JExecutionEngine>();
+
+        sut->ScaleWorkers(4);
+        sut->RunTopology();
+        sut->RunSupervisor();
+
+        auto perf = sut->GetPerf();
+        REQUIRE(perf.runstatus == JExecutionEngine::RunStatus::Paused);
+        REQUIRE(perf.event_count == 20);
+        REQUIRE(sut->m_active_task_count == 0);
+        sut->FinishTopology();
+        sut->ScaleWorkers(0);
+    }
+}
+
+TEST_CASE("JExecutionEngine_EventFusion") {
+    JApplication app;
+    app.SetParameterValue("jana:enable_event_fusion", true);
+    app.SetParameterValue("jana:loglevel", "info");
+    app.SetParameterValue("jana:max_inflight_events", 2);
+    app.Add(new TestSource());
+    app.Add(new TestProc());
+
+    SECTION("WorkerFollowsEventDownstream") {
+        app.SetParameterValue("jana:nevents", 1);
+        app.Initialize();
+        auto sut = app.GetService<JExecutionEngine>();
+
+        auto worker = sut->RegisterWorker();
+        sut->RunTopology();
+
+        JExecutionEngine::Task task;
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventSource");
+        task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+        auto* event = task.outputs[0].first;
+
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventMap1");
+        REQUIRE(task.input_event == event);
+        REQUIRE(task.worker_state->task_deque == nullptr);
+        REQUIRE(task.worker_state->tasks_fused == 1);
+        task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+
+        // The tap is sequential, so the event goes through its queue even though the tap is idle
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventTap");
+        REQUIRE(task.input_event == event);
+        REQUIRE(task.worker_state->tasks_fused == 1);
+        task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+
+        // Tap returns the event to the pool, which always goes through the regular scheduler
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventSource");
+        REQUIRE(task.worker_state->tasks_fused == 1);
+        REQUIRE(sut->GetPerf().event_count == 1);
+    }
+
+    SECTION("SequentialTapGoesThroughQueue") {
+        app.Initialize();
+        auto sut = app.GetService<JExecutionEngine>();
+
+        auto worker0 = sut->RegisterWorker();
+        auto worker1 = sut->RegisterWorker();
+        sut->RunTopology();
+
+        JExecutionEngine::Task task0, task1;
+        sut->ExchangeTask(task0, worker0.worker_id);
+        REQUIRE(task0.arrow->GetName() == "PhysicsEventSource");
+        task0.arrow->Fire(task0.input_event, task0.outputs, task0.output_count, task0.status);
+        sut->ExchangeTask(task0, worker0.worker_id);
+        REQUIRE(task0.arrow->GetName() == "PhysicsEventMap1");
+
+        sut->ExchangeTask(task1, worker1.worker_id);
+        REQUIRE(task1.arrow->GetName() == "PhysicsEventSource");
+        task1.arrow->Fire(task1.input_event, task1.outputs, task1.output_count, task1.status);
+        sut->ExchangeTask(task1, worker1.worker_id);
+        REQUIRE(task1.arrow->GetName() == "PhysicsEventMap1");
+
+        task0.arrow->Fire(task0.input_event, task0.outputs, task0.output_count, task0.status);
+        task1.arrow->Fire(task1.input_event, task1.outputs, task1.output_count, task1.status);
+
+        // Worker 0 still ends up running the tap, but only after its event went through the tap's queue
+        sut->ExchangeTask(task0, worker0.worker_id);
+        REQUIRE(task0.arrow->GetName() == "PhysicsEventTap");
+        REQUIRE(task0.worker_state->tasks_fused == 1);
+        auto* tap_queue = task0.arrow->GetPort(0).GetQueue();
+
+        // The tap is busy, so worker 1's event waits in the tap's queue
+        sut->ExchangeTask(task1, worker1.worker_id, true);
+        REQUIRE(task1.arrow == nullptr);
+        REQUIRE(task1.worker_state->tasks_fused == 1);
+        REQUIRE(tap_queue->GetSize(0) == 1);
+
+        task0.arrow->Fire(task0.input_event, task0.outputs, task0.output_count, task0.status);
+        sut->PauseTopology();
+        sut->ExchangeTask(task0, worker0.worker_id, true);
+        REQUIRE(sut->GetRunStatus() == JExecutionEngine::RunStatus::Paused);
+        REQUIRE(sut->m_active_task_count == 0);
+    }
+}
+
+
+struct StreamingSource : public JEventSource {
+    std::atomic_int available_count {0};
+    int max_event_count = 0;
+    StreamingSource() {
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+    }
+    Result Emit(JEvent& event) override {
+        if (max_event_count != 0 && (int) GetEmittedEventCount() == max_event_count) {
+            return Result::FailureFinished;
+        }
+        if (available_count == 0) {
+            return Result::FailureTryAgain;
+        }
+        available_count -= 1;
+        event.Insert<TestData>(new TestData {.x=(int) GetEmittedEventCount() * 2}, "src");
+        return Result::Success;
+    }
+};
+
+TEST_CASE("JExecutionEngine_Backoff") {
+    JApplication app;
+    app.SetParameterValue("jana:loglevel", "info");
+    app.SetParameterValue("jana:max_inflight_events", 2);
+    auto source = new StreamingSource;
+    app.Add(source);
+    app.Add(new TestProc());
+
+    SECTION("BackoffGrowsExponentially") {
+        app.SetParameterValue("jana:backoff_initial_us", 1000);
+        app.SetParameterValue("jana:backoff_interval", 3);
+        app.Initialize();
+        auto sut = app.GetService<JExecutionEngine>();
+        auto worker = sut->RegisterWorker();
+        sut->RunTopology();
+
+        JExecutionEngine::Task task;
+        auto& source_state = sut->m_arrow_states[0];
+        std::vector<int> expected_backoff_ms {1, 2, 3, 3};
+        for (int backoff_ms : expected_backoff_ms) {
+            sut->ExchangeTask(task, worker.worker_id);
+            REQUIRE(task.arrow->GetName() == "PhysicsEventSource");
+            task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+            REQUIRE(task.status == JArrow::FireResult::ComeBackLater);
+
+            sut->ExchangeTask(task, worker.worker_id, true);
+            REQUIRE(task.arrow == nullptr); // Source is backing off, and nobody else has anything to do
+            REQUIRE(source_state.backoff_duration == std::chrono::milliseconds(backoff_ms));
+            REQUIRE(sut->m_next_visit_time != JExecutionEngine::clock_t::time_point::max());
+            std::this_thread::sleep_until(sut->m_next_visit_time);
+        }
+
+        // Once the source emits something, the backoff resets
+        source->available_count = 1;
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventSource");
+        task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+        REQUIRE(task.status == JArrow::FireResult::KeepGoing);
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(source_state.backoff_duration == JExecutionEngine::clock_t::duration::zero());
+        REQUIRE(source_state.backoff_count == 4);
+    }
+
+    SECTION("DeadlineSurvivesEarlyReturn") {
+        app.SetParameterValue("jana:backoff_initial_us", 60'000'000);
+        app.SetParameterValue("jana:backoff_interval", 60'000);
+        app.Initialize();
+        auto sut = app.GetService<JExecutionEngine>();
+        auto worker = sut->RegisterWorker();
+        sut->RunTopology();
+
+        JExecutionEngine::Task task;
+        auto& source_state = sut->m_arrow_states[0];
+        source->available_count = 1;
+        bool found_task_while_backing_off = false;
+        for (int i=0; i<10; ++i) {
+            sut->ExchangeTask(task, worker.worker_id, true);
+            if (task.arrow == nullptr) break;
+            if (task.arrow->GetName() != "PhysicsEventSource" && source_state.backoff_duration != JExecutionEngine::clock_t::duration::zero()) {
+                // The scheduler found a task without needing to look at the source, but it still has to remember when to revisit it
+                found_task_while_backing_off = true;
+                REQUIRE(sut->m_next_visit_time != JExecutionEngine::clock_t::time_point::max());
+            }
+            task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+        }
+        REQUIRE(found_task_while_backing_off);
+    }
+
+    SECTION("NotifyDataAvailableCancelsBackoff") {
+        app.SetParameterValue("jana:backoff_initial_us", 60'000'000);
+        app.SetParameterValue("jana:backoff_interval", 60'000);
+        app.Initialize();
+        auto sut = app.GetService<JExecutionEngine>();
+        auto worker = sut->RegisterWorker();
+        sut->RunTopology();
+
+        JExecutionEngine::Task task;
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventSource");
+        task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+        REQUIRE(task.status == JArrow::FireResult::ComeBackLater);
+
+        sut->ExchangeTask(task, worker.worker_id, true);
+        REQUIRE(task.arrow == nullptr);
+
+        source->available_count = 1;
+        source->NotifyDataAvailable();
+        REQUIRE(sut->m_total_wakeup_count == 1);
+
+        sut->ExchangeTask(task, worker.worker_id, true);
+        REQUIRE(task.arrow != nullptr);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventSource");
+        task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+        REQUIRE(task.status == JArrow::FireResult::KeepGoing);
+    }
+
+    SECTION("NotifyDataAvailableWhileRunning") {
+        app.SetParameterValue("jana:backoff_initial_us", 60'000'000);
+        app.SetParameterValue("jana:backoff_interval", 60'000);
+        app.Initialize();
+        auto sut = app.GetService<JExecutionEngine>();
+        auto worker = sut->RegisterWorker();
+        sut->RunTopology();
+
+        JExecutionEngine::Task task;
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventSource");
+        task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+        REQUIRE(task.status == JArrow::FireResult::ComeBackLater);
+
+        // Data arrives after the source gave up but before the scheduler heard about it. This must not get lost.
+        source->available_count = 1;
+        source->NotifyDataAvailable();
+
+        sut->ExchangeTask(task, worker.worker_id, true);
+        REQUIRE(task.arrow != nullptr);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventSource");
+        REQUIRE(sut->m_arrow_states[0].backoff_duration == JExecutionEngine::clock_t::duration::zero());
+    }
+
+    SECTION("ExternalThreadWakesWorkers") {
+        // Without NotifyDataAvailable(), this would take several minutes
+        app.SetParameterValue("jana:backoff_initial_us", 60'000'000);
+        app.SetParameterValue("jana:backoff_interval", 60'000);
+        app.SetParameterValue("nthreads", 2);
+        source->max_event_count = 5;
+        app.Initialize();
+
+        std::thread producer([&](){
+            for (int i=0; i<5; ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                source->available_count += 1;
+                source->NotifyDataAvailable();
+            }
+        });
+        auto start_time = std::chrono::steady_clock::now();
+        app.Run();
+        producer.join();
+        REQUIRE(std::chrono::steady_clock::now() - start_time < std::chrono::seconds(30));
+        REQUIRE(source->GetEmittedEventCount() == 5);
+    }
+}
+
+
+TEST_CASE("JExecutionEngine_Batching") {
+    JApplication app;
+    app.SetParameterValue("jana:loglevel", "info");
+    app.SetParameterValue("jana:max_inflight_events", 8);
+    app.SetParameterValue("jana:max_batch_size", 4);
+    auto source = new StreamingSource;
+    source->available_count = 8;
+    app.Add(source);
+    app.Add(new TestProc());
+    app.Initialize();
+    auto sut = app.GetService<JExecutionEngine>();
+
+    size_t map_id = 0;
+    auto& arrows = sut->m_topology->GetArrows();
+    for (size_t arrow_id=0; arrow_id<arrows.size(); ++arrow_id) {
+        if (arrows[arrow_id]->GetName() == "PhysicsEventMap1") map_id = arrow_id;
+    }
+    auto& map_state = sut->m_arrow_states[map_id];
+    REQUIRE(map_state.is_parallel);
+
+    auto worker = sut->RegisterWorker();
+    sut->RunTopology();
+
+    // Hold the map back until the source has filled its queue
+    map_state.status = JExecutionEngine::ArrowState::Status::Paused;
+    JExecutionEngine::Task task;
+    for (int i=0; i<4; ++i) {
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventSource");
+        task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+        REQUIRE(task.status == JArrow::FireResult::KeepGoing);
+    }
+    map_state.status = JExecutionEngine::ArrowState::Status::Running;
+    map_state.batch_size = 4;
+    source->available_count = 0; // Keep the source out of the way from now on
+
+    // Keep exchanging until the scheduler hands out the map
+    while (true) {
+        sut->ExchangeTask(task, worker.worker_id);
+        if (task.arrow->GetName() == "PhysicsEventMap1") break;
+        task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+    }
+    REQUIRE(task.batch.size() == 3);
+    REQUIRE(map_state.batch_count == 1);
+
+    sut->FireTask(task);
+    REQUIRE(task.output_count == 1);
+    REQUIRE(task.batch_outputs.size() == 3);
+    REQUIRE(map_state.events_processed == 0);
+
+    sut->ExchangeTask(task, worker.worker_id);
+    REQUIRE(map_state.events_processed == 4);
+    REQUIRE(task.batch.empty());
+    REQUIRE(task.batch_outputs.empty());
+
+    // TestProc is slow compared to the scheduler, so batching isn't worth it
+    REQUIRE(map_state.batch_size == 1);
+}
+
+
+TEST_CASE("JExecutionEngine_SchedulerPolicy") {
+    JApplication app;
+    app.SetParameterValue("jana:loglevel", "info");
+    app.SetParameterValue("jana:max_inflight_events", 2);
+    auto source = new StreamingSource;
+    source->available_count = 10;
+    app.Add(source);
+    app.Add(new TestProc());
+
+    SECTION("Invalid") {
+        app.SetParameterValue("jana:scheduler_policy", "fastest");
+        REQUIRE_THROWS(app.Initialize());
+    }
+
+    SECTION("SinkDistances") {
+        app.Initialize();
+        auto sut = app.GetService<JExecutionEngine>();
+        REQUIRE(sut->m_scheduler_policy == JExecutionEngine::SchedulerPolicy::RoundRobin);
+
+        auto& arrows = sut->m_topology->GetArrows();
+        std::vector<std::string> drain_first_names;
+        for (size_t arrow_id : sut->m_drain_first_order) {
+            drain_first_names.push_back(arrows[arrow_id]->GetName());
+        }
+        REQUIRE(drain_first_names == std::vector<std::string> {"PhysicsEventTap", "PhysicsEventMap1", "PhysicsEventSource"});
+        REQUIRE(sut->m_arrow_states[sut->m_drain_first_order[0]].sink_distance == 0);
+        REQUIRE(sut->m_arrow_states[sut->m_drain_first_order[2]].sink_distance == 2);
+    }
+
+    SECTION("DrainFirst") {
+        app.SetParameterValue("jana:scheduler_policy", "drain_first");
+        app.Initialize();
+        auto sut = app.GetService<JExecutionEngine>();
+        auto worker = sut->RegisterWorker();
+        sut->RunTopology();
+
+        JExecutionEngine::Task task;
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventSource");
+        task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+
+        // The source could emit a second event, but finishing the first one takes priority
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventMap1");
+        task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventTap");
+        task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventSource");
+        REQUIRE(sut->GetPerf().event_count == 1);
+        REQUIRE(sut->m_event_latency_sample_count == 1);
+        REQUIRE(sut->GetPerf().event_latency_p50_ms > 0);
+    }
+
+    SECTION("OccupancyWeighted") {
+        app.SetParameterValue("jana:scheduler_policy", "occupancy_weighted");
+        app.Initialize();
+        auto sut = app.GetService<JExecutionEngine>();
+        auto worker = sut->RegisterWorker();
+        sut->RunTopology();
+
+        // The pool is full, and everything else is empty
+        JExecutionEngine::Task task;
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventSource");
+        task.arrow->Fire(task.input_event, task.outputs, task.output_count, task.status);
+
+        // Pool and map queue are both half full, so the tie goes to the arrow closer to the sink
+        sut->ExchangeTask(task, worker.worker_id);
+        REQUIRE(task.arrow->GetName() == "PhysicsEventMap1");
+    }
+}
+
+TEST_CASE("JExecutionEngine_EventLatency") {
+    JApplication app;
+    app.SetParameterValue("jana:loglevel", "warn");
+    app.Add(new StreamingSource);
+    app.Add(new TestProc());
+    app.Initialize();
+    auto sut = app.GetService<JExecutionEngine>();
+    REQUIRE(sut->GetPerf().event_latency_p50_ms == 0);
+
+    // Inject the latencies directly so that we don't depend on timing
+    sut->m_event_latency_samples.assign(100, 0);
+    for (int i=0; i<100; ++i) {
+        JEvent event;
+        auto now = JExecutionEngine::clock_t::now();
+        event.SetInflightSince(now - std::chrono::milliseconds(i+1));
+        sut->RecordEventLatency_Unsafe(&event, now);
+        REQUIRE(event.GetInflightSince() == JExecutionEngine::clock_t::time_point());
+    }
+    auto perf = sut->GetPerf();
+    REQUIRE(perf.event_latency_p50_ms == Approx(50));
+    REQUIRE(perf.event_latency_p99_ms == Approx(99));
+
+    // Events that weren't emitted by a source are ignored
+    JEvent child;
+    sut->RecordEventLatency_Unsafe(&child, JExecutionEngine::clock_t::now());
+    REQUIRE(sut->m_event_latency_sample_count == 100);
+}
+
+
+TEST_CASE("JExecutionEngine_LocalityStealing") {
+    JApplication app;
+    app.SetParameterValue("jana:loglevel", "error");
+    app.SetParameterValue("jana:max_inflight_events", 2);
+    app.SetParameterValue("jana:locality", 1); // Socket-local
+    app.SetParameterValue("jana:simulated_numa_layout", "2x1x2");
+    auto source = new StreamingSource;
+    source->available_count = 10;
+    app.Add(source);
+    app.Add(new TestProc());
+
+    SECTION("Disabled") {
+        app.Initialize();
+        auto sut = app.GetService<JExecutionEngine>();
+        REQUIRE(sut->m_topology->GetProcessorMapping().get_loc_count() == 2);
+
+        // Each location's pool starts out with one event. Once location 0 has used its event, it is stuck.
+        REQUIRE(sut->Fire(0, 0) == JArrow::FireResult::KeepGoing);
+        REQUIRE(sut->Fire(0, 0) == JArrow::FireResult::NotRunYet);
+        REQUIRE(sut->GetPerf().stolen_event_count == 0);
+    }
+
+    SECTION("Enabled") {
+        app.SetParameterValue("jana:enable_stealing", true);
+        app.Initialize();
+        auto sut = app.GetService<JExecutionEngine>();
+
+        REQUIRE(sut->Fire(0, 0) == JArrow::FireResult::KeepGoing);
+        REQUIRE(sut->Fire(0, 0) == JArrow::FireResult::KeepGoing); // Takes location 1's event
+        REQUIRE(sut->GetPerf().stolen_event_count == 1);
+
+        // Both events are now queued at location 0, but location 1 can still process them
+        REQUIRE(sut->Fire(1, 1) == JArrow::FireResult::KeepGoing);
+        REQUIRE(sut->GetPerf().stolen_event_count == 2);
+    }
+}
+
 } // jana::engine::tests
 
 
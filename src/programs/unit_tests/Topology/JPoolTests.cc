@@ -3,6 +3,7 @@
 #include "JANA/Services/JComponentManager.h"
 #include <catch.hpp>
 #include <JANA/Topology/JEventPool.h>
+#include <JANA/Topology/JLockFreeEventPool.h>
 
 namespace jana {
 namespace jpooltests {
@@ -38,6 +39,31 @@ TEST_CASE("JPoolTests_SingleLocationLimitEvents") {
     REQUIRE(h->GetEventNumber() == 5);
 }
 
+TEST_CASE("JPoolTests_LockFreeMultipleLocations") {
+    JApplication app;
+    app.Initialize();
+    auto jcm = app.GetService<JComponentManager>();
+
+    JLockFreeEventPool pool(jcm, 3, 2);
+    REQUIRE(pool.GetSize(0) == 2);
+    REQUIRE(pool.GetSize(1) == 1);
+
+    auto* e = pool.Pop(1);
+    REQUIRE(e != nullptr);
+    REQUIRE(pool.Pop(1) == nullptr);
+
+    pool.Scale(5);
+    REQUIRE(pool.GetSize(0) == 3);
+    REQUIRE(pool.GetSize(1) == 1);
+
+    pool.Ingest(e, 1);
+    REQUIRE(pool.GetSize(1) == 2);
+
+    JEvent timeslice;
+    timeslice.SetLevel(JEventLevel::Timeslice);
+    REQUIRE_THROWS(pool.Ingest(&timeslice, 0));
+    pool.Finalize();
+}
 
 
 } // namespace jana
@@ -3,6 +3,10 @@
 // Subject to the terms in the LICENSE file found in the top-level directory.
 
 #include <JANA/Topology/JEventQueue.h>
+#include <JANA/Topology/JLockFreeEventQueue.h>
+
+#include <atomic>
+#include <thread>
 
 #include "catch.hpp"
 
@@ -47,3 +51,227 @@ TEST_CASE("JEventQueueTests_Basic") {
 
 
 
+TEST_CASE("JEventQueueTests_GrowPreservesContents") {
+
+    JEvent events[6];
+    for (int i=0; i<6; ++i) {
+        events[i].SetEventNumber(i);
+    }
+
+    SECTION("Unordered") {
+        JEventQueue sut(4,1);
+        sut.Push(&events[0], 0);
+        sut.Push(&events[1], 0);
+        sut.Push(&events[2], 0);
+        sut.Pop(0);
+        sut.Push(&events[3], 0);
+        sut.Push(&events[4], 0); // Ringbuffer has now wrapped around
+
+        sut.Scale(8);
+        REQUIRE(sut.GetCapacity() == 8);
+        REQUIRE(sut.GetSize(0) == 4);
+        sut.Push(&events[5], 0);
+
+        for (int i=1; i<6; ++i) {
+            REQUIRE(sut.Pop(0)->GetEventNumber() == (uint64_t) i);
+        }
+        REQUIRE(sut.Pop(0) == nullptr);
+    }
+
+    SECTION("Ordered") {
+        JEventQueue sut(3,1);
+        sut.SetEnforcesOrdering();
+        for (int i=0; i<6; ++i) {
+            events[i].SetEventIndex(i);
+        }
+        sut.Push(&events[0], 0);
+        REQUIRE(sut.Pop(0) == &events[0]);
+        sut.Push(&events[3], 0);
+        sut.Push(&events[2], 0);
+        REQUIRE(sut.GetSize(0) == 2);
+        REQUIRE_THROWS(sut.Scale(2));
+
+        sut.Scale(5);
+        REQUIRE(sut.Pop(0) == nullptr); // Still waiting on event 1
+        sut.Push(&events[5], 0);
+        sut.Push(&events[1], 0);
+        REQUIRE(sut.Pop(0) == &events[1]);
+        REQUIRE(sut.Pop(0) == &events[2]);
+        REQUIRE(sut.Pop(0) == &events[3]);
+        REQUIRE(sut.Pop(0) == nullptr);
+        sut.Push(&events[4], 0);
+        REQUIRE(sut.Pop(0) == &events[4]);
+        REQUIRE(sut.Pop(0) == &events[5]);
+    }
+}
+
+TEST_CASE("JEventQueueTests_Stealing") {
+
+    JEvent events[4];
+    for (int i=0; i<4; ++i) {
+        events[i].SetEventNumber(i);
+    }
+    JEventQueue sut(4,3);
+    sut.Push(&events[0], 1);
+    sut.Push(&events[1], 2);
+    sut.Push(&events[2], 2);
+
+    // Without a steal order, locations are isolated
+    REQUIRE(sut.GetIsStealingEnabled() == false);
+    REQUIRE(sut.Pop(0) == nullptr);
+
+    // Location 0 prefers location 2 over location 1
+    sut.SetStealOrder({{2,1}, {0,2}, {1,0}});
+    REQUIRE(sut.GetIsStealingEnabled() == true);
+    REQUIRE(sut.Pop(0) == &events[1]);
+    REQUIRE(sut.Pop(0) == &events[2]);
+    REQUIRE(sut.Pop(0) == &events[0]);
+    REQUIRE(sut.Pop(0) == nullptr);
+    REQUIRE(sut.GetStolenCount() == 3);
+
+    // Local events always come first
+    sut.Push(&events[3], 1);
+    sut.Push(&events[0], 0);
+    REQUIRE(sut.Pop(0) == &events[0]);
+    REQUIRE(sut.GetStolenCount() == 3);
+    REQUIRE(sut.GetPopCount() == 4);
+}
+
+
+TEST_CASE("JLockFreeEventQueueTests_Basic") {
+
+    JEvent events[6];
+    for (int i=0; i<6; ++i) {
+        events[i].SetEventNumber(i);
+    }
+
+    SECTION("Unordered") {
+        JLockFreeEventQueue sut(4,1);
+        REQUIRE(sut.GetCapacity() == 4);
+        REQUIRE(sut.Pop(0) == nullptr);
+        sut.Push(&events[0], 0);
+        sut.Push(&events[1], 0);
+        sut.Push(&events[2], 0);
+        REQUIRE(sut.GetSize(0) == 3);
+        REQUIRE(sut.Pop(0) == &events[0]);
+        sut.Push(&events[3], 0);
+        sut.Push(&events[4], 0);
+        REQUIRE_THROWS(sut.Push(&events[5], 0));
+
+        sut.Scale(8);
+        REQUIRE(sut.GetSize(0) == 4);
+        sut.Push(&events[5], 0);
+        for (int i=1; i<6; ++i) {
+            REQUIRE(sut.Pop(0) == &events[i]);
+        }
+        REQUIRE(sut.Pop(0) == nullptr);
+        REQUIRE(sut.GetPopCount() == 6);
+    }
+
+    SECTION("Ordered") {
+        JLockFreeEventQueue sut(3,1);
+        sut.SetEnforcesOrdering();
+        for (int i=0; i<6; ++i) {
+            events[i].SetEventIndex(i);
+        }
+        sut.Push(&events[0], 0);
+        REQUIRE(sut.Pop(0) == &events[0]);
+        sut.Push(&events[3], 0);
+        sut.Push(&events[2], 0);
+        REQUIRE(sut.GetSize(0) == 2);
+        REQUIRE_THROWS(sut.Push(&events[4], 0)); // Above max
+        REQUIRE_THROWS(sut.Scale(2));
+
+        sut.Scale(5);
+        REQUIRE(sut.Pop(0) == nullptr); // Still waiting on event 1
+        sut.Push(&events[5], 0);
+        sut.Push(&events[1], 0);
+        REQUIRE(sut.Pop(0) == &events[1]);
+        REQUIRE(sut.Pop(0) == &events[2]);
+        REQUIRE(sut.Pop(0) == &events[3]);
+        REQUIRE(sut.Pop(0) == nullptr);
+        sut.Push(&events[4], 0);
+        REQUIRE(sut.Pop(0) == &events[4]);
+        REQUIRE(sut.Pop(0) == &events[5]);
+    }
+
+    SECTION("Stealing") {
+        JLockFreeEventQueue sut(4,3);
+        sut.Push(&events[0], 1);
+        sut.Push(&events[1], 2);
+        sut.Push(&events[2], 2);
+        REQUIRE(sut.Pop(0) == nullptr);
+
+        sut.SetStealOrder({{2,1}, {0,2}, {1,0}});
+        REQUIRE(sut.Pop(0) == &events[1]);
+        REQUIRE(sut.Pop(0) == &events[2]);
+        REQUIRE(sut.Pop(0) == &events[0]);
+        REQUIRE(sut.Pop(0) == nullptr);
+        REQUIRE(sut.GetStolenCount() == 3);
+    }
+}
+
+TEST_CASE("JLockFreeEventQueueTests_Contention") {
+
+    // Every event circulates between two queues, the way events circulate between an arrow's
+    // input queue and the pool. Each one must come out exactly once per trip.
+    const size_t event_count = 64;
+    const size_t thread_count = 8;
+    const size_t location_count = 2;
+    const size_t trips_per_thread = 20000;
+
+    std::vector<JEvent> events(event_count);
+    std::vector<std::atomic_int> visits(event_count);
+    JLockFreeEventQueue free_list(event_count, location_count);
+    JLockFreeEventQueue queue(event_count, location_count);
+    free_list.SetStealOrder({{1}, {0}});
+    queue.SetStealOrder({{1}, {0}});
+    queue.SetEstablishesOrdering();
+
+    for (size_t i=0; i<event_count; ++i) {
+        events[i].SetEventNumber(i);
+        visits[i] = 0;
+        free_list.Push(&events[i], i % location_count);
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t t=0; t<thread_count; ++t) {
+        threads.emplace_back([&, t]() {
+            size_t location = t % location_count;
+            size_t trips = 0;
+            while (trips < trips_per_thread) {
+                JEvent* event = free_list.Pop(location);
+                if (event != nullptr) {
+                    queue.Push(event, location);
+                }
+                event = queue.Pop(location);
+                if (event != nullptr) {
+                    visits[event->GetEventNumber()] += 1;
+                    free_list.Push(event, location);
+                    trips += 1;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    size_t total_visits = 0;
+    for (auto& v : visits) {
+        total_visits += v;
+    }
+    REQUIRE(total_visits == thread_count * trips_per_thread);
+    REQUIRE(queue.GetPopCount() == thread_count * trips_per_thread);
+    REQUIRE(queue.GetSize(0) + queue.GetSize(1) + free_list.GetSize(0) + free_list.GetSize(1) == event_count);
+
+    // Every event must be accounted for exactly once
+    std::vector<int> seen(event_count, 0);
+    for (size_t location=0; location<location_count; ++location) {
+        while (JEvent* event = free_list.Pop(location)) seen[event->GetEventNumber()] += 1;
+        while (JEvent* event = queue.Pop(location)) seen[event->GetEventNumber()] += 1;
+    }
+    for (size_t i=0; i<event_count; ++i) {
+        REQUIRE(seen[i] == 1);
+    }
+}
@@ -0,0 +1,55 @@
+#include "catch.hpp"
+
+#include <JANA/Utils/JArena.h>
+#include <cstdint>
+
+TEST_CASE("JArenaTests_Basics") {
+
+    JArena sut(64);
+    REQUIRE(sut.GetBlockCount() == 0); // Nothing gets allocated until somebody asks
+
+    auto* a = static_cast<char*>(sut.Allocate(10, 1));
+    auto* b = static_cast<double*>(sut.Allocate(sizeof(double), alignof(double)));
+    REQUIRE(sut.GetBlockCount() == 1);
+    REQUIRE(sut.Contains(a));
+    REQUIRE(sut.Contains(b));
+    REQUIRE(reinterpret_cast<uintptr_t>(b) % alignof(double) == 0);
+    REQUIRE(reinterpret_cast<char*>(b) >= a + 10);
+    REQUIRE(sut.GetBytesInUse() >= 18);
+
+    int on_the_heap = 0;
+    REQUIRE(!sut.Contains(&on_the_heap));
+
+    sut.Reset();
+    REQUIRE(sut.GetBytesInUse() == 0);
+    REQUIRE(sut.GetHighWaterMark() >= 18);
+
+    // The first block gets reused
+    auto* c = static_cast<char*>(sut.Allocate(10, 1));
+    REQUIRE(c == a);
+}
+
+TEST_CASE("JArenaTests_Regrowth") {
+
+    JArena sut(64);
+    for (int i=0; i<10; ++i) {
+        sut.Allocate(40, 8);
+    }
+    REQUIRE(sut.GetBlockCount() > 1);
+    REQUIRE(sut.GetHighWaterMark() >= 400);
+
+    // Overflowing blocks get coalesced into one block which fits the whole event
+    sut.Reset();
+    REQUIRE(sut.GetBlockCount() == 1);
+    REQUIRE(sut.GetCapacity() >= 400);
+    for (int i=0; i<10; ++i) {
+        sut.Allocate(40, 8);
+    }
+    REQUIRE(sut.GetBlockCount() == 1);
+
+    // Allocations larger than the block size get a block of their own
+    auto* big = sut.Allocate(10000, 64);
+    REQUIRE(reinterpret_cast<uintptr_t>(big) % 64 == 0);
+    REQUIRE(sut.Contains(big));
+    REQUIRE(sut.Contains(static_cast<char*>(big) + 9999));
+}
@@ -4,6 +4,8 @@
 
 #include <catch.hpp>
 #include <JANA/Utils/JCallGraphRecorder.h>
+#include <JANA/Utils/JCallGraphSummary.h>
+#include <JANA/Services/JComponentManager.h>
 #include "JANA/JEvent.h"
 #include "JANA/JFactoryGenerator.h"
 
@@ -85,3 +87,54 @@ TEST_CASE("Test topological sort algorithm using actual Factories") {
     REQUIRE(result[3].first == "ObjD");
 }
 
+
+TEST_CASE("JCallGraphRecorder_Summary") {
+    JApplication app;
+    app.SetParameterValue("jana:loglevel", "warn");
+    app.SetParameterValue("jana:call_graph_summary", true);
+    app.SetParameterValue("jana:call_graph_sampling", 2);
+    app.Add(new JFactoryGeneratorT<FacA>());
+    app.Add(new JFactoryGeneratorT<FacB>());
+    app.Add(new JFactoryGeneratorT<FacC>());
+    app.Add(new JFactoryGeneratorT<FacD>());
+    auto event = std::make_shared<JEvent>(&app);
+    auto summary = app.GetService<JComponentManager>()->GetCallGraphSummary();
+    REQUIRE(summary != nullptr);
+
+    SECTION("Only sampled events get merged") {
+        for (int i=0; i<5; ++i) {
+            event->Get<ObjD>();
+            // Summary mode shouldn't turn on the full call graph
+            REQUIRE(event->GetJCallGraphRecorder()->GetCallGraph().empty());
+            event->Clear();
+        }
+        REQUIRE(summary->GetSampledEventCount() == 3);
+        REQUIRE(summary->GetDroppedNodeCount() == 0);
+
+        // Get<ObjD> has no caller, so we expect D->B, B->A, D->C
+        auto edges = summary->GetEdges();
+        REQUIRE(edges.size() == 3);
+        for (auto& edge : edges) {
+            REQUIRE(edge.call_count == 3);
+            REQUIRE(edge.data_source == JCallGraphRecorder::DATA_FROM_FACTORY);
+            if (edge.callee_name == "ObjB") {
+                REQUIRE(edge.caller_name == "ObjD");
+                REQUIRE(edge.callee_tag == "WeirdBTag");
+            }
+            if (edge.callee_name == "ObjA") {
+                REQUIRE(edge.caller_name == "ObjB");
+                REQUIRE(edge.caller_tag == "WeirdBTag");
+            }
+        }
+    }
+
+    SECTION("Calls that don't fit in the buffer get dropped") {
+        event->GetJCallGraphRecorder()->EnableSummary(summary, 1, 1);
+        event->Get<ObjD>();
+        REQUIRE(event->GetJCallGraphRecorder()->GetCompactNodes().size() == 1);
+        event->Clear();
+        REQUIRE(summary->GetSampledEventCount() == 1);
+        REQUIRE(summary->GetDroppedNodeCount() == 2);
+    }
+}
+
@@ -0,0 +1,196 @@
+
+#include "catch.hpp"
+
+#include <JANA/Utils/JLatencyHistogram.h>
+#include <JANA/Services/JComponentManager.h>
+#include <JANA/JApplication.h>
+#include <JANA/JEventSource.h>
+#include <JANA/JEventProcessor.h>
+#include <JANA/JFactoryGenerator.h>
+
+#include <thread>
+#include <map>
+#include <limits>
+
+TEST_CASE("JLatencyHistogramTests_Buckets") {
+
+    // Buckets are contiguous and don't overlap
+    REQUIRE(JLatencyHistogram::GetBucketLowerBound(0) == 0);
+    for (size_t bucket=0; bucket<JLatencyHistogram::GetBucket(std::numeric_limits<uint64_t>::max()); ++bucket) {
+        auto lower = JLatencyHistogram::GetBucketLowerBound(bucket);
+        auto upper = JLatencyHistogram::GetBucketUpperBound(bucket);
+        REQUIRE(lower <= upper);
+        REQUIRE(JLatencyHistogram::GetBucket(lower) == bucket);
+        REQUIRE(JLatencyHistogram::GetBucket(upper) == bucket);
+        REQUIRE(JLatencyHistogram::GetBucketLowerBound(bucket+1) == upper + 1);
+    }
+    REQUIRE(JLatencyHistogram::GetBucket(std::numeric_limits<uint64_t>::max()) < JLatencyHistogram::kBucketCount);
+
+    // Four buckets per power of two
+    REQUIRE(JLatencyHistogram::GetBucket(1000) + 4 == JLatencyHistogram::GetBucket(2000));
+}
+
+TEST_CASE("JLatencyHistogramTests_Quantiles") {
+
+    JLatencyHistogram sut;
+    REQUIRE(sut.GetSnapshot().GetQuantileNs(0.99) == 0.0);
+
+    for (int i=0; i<980; ++i) sut.Record(1000);
+    for (int i=0; i<20; ++i) sut.Record(1000000);
+    auto snapshot = sut.GetSnapshot();
+
+    REQUIRE(snapshot.count == 1000);
+    REQUIRE(snapshot.max_ns == 1000000);
+    REQUIRE(snapshot.GetMeanNs() == Approx(20980.0));
+    REQUIRE(snapshot.GetQuantileNs(0.5) == Approx(1000).epsilon(0.2));
+    REQUIRE(snapshot.GetQuantileNs(0.99) == Approx(1000000).epsilon(0.2));
+    REQUIRE(snapshot.GetQuantileNs(1.0) <= 1000000);
+}
+
+TEST_CASE("JLatencyHistogramTests_Threads") {
+
+    JLatencyHistogram sut;
+    std::vector<std::thread> threads;
+    for (int t=0; t<4; ++t) {
+        threads.emplace_back([&sut, t](){
+            for (int i=0; i<10000; ++i) sut.Record(100 * (t+1));
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    auto snapshot = sut.GetSnapshot();
+    REQUIRE(snapshot.count == 40000);
+    REQUIRE(snapshot.total_ns == 10000 * (100 + 200 + 300 + 400));
+    REQUIRE(snapshot.max_ns == 400);
+}
+
+
+namespace jana::latencyhistogramtests {
+
+struct Hit { size_t event_nr; };
+
+struct Src : public JEventSource {
+    Output<Hit> hits_out {this};
+    Src() {
+        SetTypeName("Src");
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        hits_out.SetShortName("raw");
+    }
+    Result Emit(JEvent& event) override {
+        hits_out().push_back(new Hit {event.GetEventNumber()});
+        return Result::Success;
+    }
+};
+
+struct SlowFac : public JFactory {
+    Input<Hit> hits_in {this};
+    Output<Hit> hits_out {this};
+    SlowFac() {
+        hits_in.SetDatabundleName("raw");
+        hits_out.SetShortName("calibrated");
+    }
+    void Process(const JEvent&) override {
+        // One in fifty events is pathological
+        if (hits_in().at(0)->event_nr % 50 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        hits_out().push_back(new Hit {hits_in().at(0)->event_nr});
+    }
+};
+
+struct Proc : public JEventProcessor {
+    Input<Hit> hits_in {this};
+    Proc() {
+        SetTypeName("Proc");
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        hits_in.SetDatabundleName("calibrated");
+    }
+    void ProcessSequential(const JEvent&) override {
+        REQUIRE(hits_in().size() == 1);
+    }
+};
+
+TEST_CASE("JLatencyHistogramTests_Components") {
+    JApplication app;
+    app.SetParameterValue("jana:loglevel", "warn");
+    app.SetParameterValue("jana:nevents", 200);
+    app.SetParameterValue("jana:latency_histograms", true);
+    app.Add(new Src);
+    app.Add(new Proc);
+    app.Add(new JFactoryGeneratorT<SlowFac>);
+    app.Run();
+
+    auto summaries = app.GetService<JComponentManager>()->GetLatencySummaries();
+    REQUIRE(summaries.size() == 4);
+
+    // Summaries come sorted by total time, slowest first
+    for (size_t i=1; i<summaries.size(); ++i) {
+        REQUIRE(summaries[i-1].snapshot.total_ns >= summaries[i].snapshot.total_ns);
+    }
+
+    bool factory_found = false;
+    for (auto& summary : summaries) {
+        REQUIRE(summary.snapshot.count == 200);
+        if (summary.kind == "Source") {
+            REQUIRE(summary.type_name == "Src");
+        }
+        if (summary.kind == "Processor" || summary.kind == "ProcessParallel") {
+            REQUIRE(summary.type_name == "Proc");
+        }
+        if (summary.kind == "Factory") {
+            // One in fifty events is slow, which shows up in the tail but not in the median
+            factory_found = true;
+            REQUIRE(summary.snapshot.GetQuantileNs(0.5) < 1e6);
+            REQUIRE(summary.snapshot.GetQuantileNs(0.99) > 4e6);
+        }
+    }
+    REQUIRE(factory_found);
+}
+
+struct DownstreamFac : public JFactory {
+    Input<Hit> hits_in {this};
+    Output<Hit> hits_out {this};
+    DownstreamFac() {
+        hits_in.SetDatabundleName("calibrated");
+        hits_out.SetShortName("clustered");
+    }
+    void Process(const JEvent&) override {
+        hits_out().push_back(new Hit {hits_in().at(0)->event_nr});
+    }
+};
+
+struct DownstreamProc : public JEventProcessor {
+    Input<Hit> hits_in {this};
+    DownstreamProc() {
+        SetTypeName("DownstreamProc");
+        SetCallbackStyle(CallbackStyle::ExpertMode);
+        hits_in.SetDatabundleName("clustered");
+    }
+};
+
+TEST_CASE("JLatencyHistogramTests_SelfTime") {
+    JApplication app;
+    app.SetParameterValue("jana:loglevel", "warn");
+    app.SetParameterValue("jana:nevents", 200);
+    app.SetParameterValue("jana:latency_histograms", true);
+    app.Add(new Src);
+    app.Add(new DownstreamProc);
+    app.Add(new JFactoryGeneratorT<SlowFac>);
+    app.Add(new JFactoryGeneratorT<DownstreamFac>);
+    app.Run();
+
+    std::map<std::string, JLatencyHistogram::Snapshot> snapshots;
+    for (auto& summary : app.GetService<JComponentManager>()->GetLatencySummaries()) {
+        snapshots[summary.kind + ":" + summary.type_name] = summary.snapshot;
+    }
+    REQUIRE(snapshots.at("Factory:jana::latencyhistogramtests::SlowFac").GetQuantileNs(0.99) > 4e6);
+
+    // SlowFac runs inside both DownstreamFac::Process() and DownstreamProc's input prefetch, but only counts towards itself
+    REQUIRE(snapshots.at("Factory:jana::latencyhistogramtests::DownstreamFac").count == 200);
+    REQUIRE(snapshots.at("Factory:jana::latencyhistogramtests::DownstreamFac").GetQuantileNs(0.99) < 4e6);
+    REQUIRE(snapshots.at("ProcessParallel:DownstreamProc").count == 200);
+    REQUIRE(snapshots.at("ProcessParallel:DownstreamProc").GetQuantileNs(0.99) < 4e6);
+    REQUIRE(snapshots.at("Processor:DownstreamProc").count == 200);
+}
+
+} // namespace jana::latencyhistogramtests
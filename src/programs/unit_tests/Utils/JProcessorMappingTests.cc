@@ -0,0 +1,52 @@
+
+// Copyright 2025, Jefferson Science Associates, LLC.
+// Subject to the terms in the LICENSE file found in the top-level directory.
+
+#include <JANA/Utils/JProcessorMapping.h>
+
+#include "catch.hpp"
+
+TEST_CASE("JProcessorMappingTests_Simulated") {
+
+    JProcessorMapping sut;
+    using Locality = JProcessorMapping::LocalityStrategy;
+
+    SECTION("Two sockets, socket-local") {
+        sut.initialize_simulated(2, 1, 4, Locality::SocketLocal);
+        REQUIRE(sut.get_loc_count() == 2);
+        REQUIRE(sut.get_affinity() == JProcessorMapping::AffinityStrategy::None);
+
+        // Workers alternate between sockets
+        REQUIRE(sut.get_loc_id(0) == 0);
+        REQUIRE(sut.get_loc_id(1) == 1);
+        REQUIRE(sut.get_loc_id(2) == 0);
+        REQUIRE(sut.get_loc_id(3) == 1);
+
+        REQUIRE(sut.get_loc_distance(0, 0) == 0);
+        REQUIRE(sut.get_loc_distance(0, 1) == 4);
+        REQUIRE(sut.get_neighbor_locs(0) == std::vector<size_t> {1});
+        REQUIRE(sut.get_neighbor_locs(1) == std::vector<size_t> {0});
+    }
+
+    SECTION("Two sockets with two NUMA domains each, NUMA-local") {
+        sut.initialize_simulated(2, 2, 2, Locality::NumaDomainLocal);
+        REQUIRE(sut.get_loc_count() == 4);
+
+        // Domains 0,1 are on socket 0, domains 2,3 are on socket 1
+        REQUIRE(sut.get_loc_distance(0, 1) == 3);
+        REQUIRE(sut.get_loc_distance(0, 2) == 4);
+        REQUIRE(sut.get_loc_distance(3, 2) == 3);
+
+        // Nearest first, ties rotated away from the thief
+        REQUIRE(sut.get_neighbor_locs(0) == std::vector<size_t> {1, 2, 3});
+        REQUIRE(sut.get_neighbor_locs(1) == std::vector<size_t> {0, 2, 3});
+        REQUIRE(sut.get_neighbor_locs(2) == std::vector<size_t> {3, 0, 1});
+        REQUIRE(sut.get_neighbor_locs(3) == std::vector<size_t> {2, 0, 1});
+    }
+
+    SECTION("Global") {
+        sut.initialize_simulated(2, 1, 4, Locality::Global);
+        REQUIRE(sut.get_loc_count() == 1);
+        REQUIRE(sut.get_neighbor_locs(0).empty());
+    }
+}